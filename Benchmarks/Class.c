@@ -0,0 +1,107 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <Objectively.h>
+
+/**
+ * @file
+ *
+ * @brief Measures the cost of Class method invocation under thread contention.
+ *
+ * Compares the `$$` fast path, a plain load of the Class' magic, with the
+ * compare-and-swap that `_initialize` previously performed on every call.
+ */
+
+#define ITERATIONS 10000000
+
+/**
+ * @brief Invokes a Class method through `$$`.
+ */
+static void *loadMagic(void *data) {
+
+	for (size_t i = 0; i < ITERATIONS; i++) {
+		*(volatile id *) data = $$(Boolean, yes);
+	}
+
+	return NULL;
+}
+
+/**
+ * @brief Invokes a Class method after a compare-and-swap on the Class' magic.
+ */
+static void *compareAndSwapMagic(void *data) {
+
+	for (size_t i = 0; i < ITERATIONS; i++) {
+		__sync_val_compare_and_swap(&_Boolean.locals.magic, 0, -1);
+		*(volatile id *) data = interfaceof(Boolean, &_Boolean)->yes();
+	}
+
+	return NULL;
+}
+
+/**
+ * @return The nanoseconds per call of `function` when run by `count` threads.
+ */
+static double run(void *(*function)(void *), int count) {
+
+	pthread_t threads[count];
+	id sinks[count * 8];
+
+	struct timespec start, end;
+	clock_gettime(CLOCK_MONOTONIC, &start);
+
+	for (int i = 0; i < count; i++) {
+		pthread_create(&threads[i], NULL, function, &sinks[i * 8]);
+	}
+
+	for (int i = 0; i < count; i++) {
+		pthread_join(threads[i], NULL);
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	const double elapsed = (end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec);
+
+	return elapsed / ITERATIONS;
+}
+
+int main(int argc, char **argv) {
+
+	$$(Boolean, yes);
+
+	const int cpus = (int) sysconf(_SC_NPROCESSORS_ONLN);
+
+	printf("%8s %16s %16s\n", "threads", "load ns/call", "cas ns/call");
+
+	for (int count = 1; count <= cpus; count *= 2) {
+		printf("%8d %16.2f %16.2f\n", count, run(loadMagic, count), run(compareAndSwapMagic, count));
+	}
+
+	return 0;
+}
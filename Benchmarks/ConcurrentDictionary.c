@@ -0,0 +1,204 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include <Objectively.h>
+
+/**
+ * @file
+ *
+ * @brief Measures the throughput of a read-mostly workload shared by multiple
+ * threads, with a MutableDictionary guarded by a Lock, and with a
+ * ConcurrentDictionary read with and without retaining the Objects it returns.
+ *
+ * Usage: ConcurrentDictionary [max threads] [write percentage], which default
+ * to 8 and 10.
+ */
+
+#define KEYS 65536
+#define OPERATIONS 1000000
+
+static Number *keys[KEYS];
+static int writes;
+
+static MutableDictionary *locked;
+static Lock *lock;
+
+static ConcurrentDictionary *concurrent;
+
+/**
+ * @return The seconds elapsed since `start`.
+ */
+static double elapsed(const struct timespec *start) {
+
+	struct timespec end;
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	return (end.tv_sec - start->tv_sec) + (end.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+/**
+ * @return The next pseudo-random number of `state`.
+ */
+static inline unsigned next(unsigned *state) {
+
+	*state = *state * 1103515245 + 12345;
+
+	return *state >> 8;
+}
+
+static void *lockedWorker(void *data) {
+
+	unsigned state = (unsigned) (intptr_t) data;
+	volatile size_t found = 0;
+
+	for (int i = 0; i < OPERATIONS; i++) {
+
+		const unsigned r = next(&state);
+		Number *key = keys[r % KEYS];
+
+		if ((int) ((r >> 16) % 100) < writes) {
+			WithLock(lock, $(locked, setObjectForKey, key, key));
+		} else {
+			WithLock(lock, found += $((Dictionary *) locked, objectForKey, key) != NULL);
+		}
+	}
+
+	return NULL;
+}
+
+static void *concurrentWorker(void *data) {
+
+	unsigned state = (unsigned) (intptr_t) data;
+	volatile size_t found = 0;
+
+	for (int i = 0; i < OPERATIONS; i++) {
+
+		const unsigned r = next(&state);
+		Number *key = keys[r % KEYS];
+
+		if ((int) ((r >> 16) % 100) < writes) {
+			$(concurrent, setObjectForKey, key, key);
+		} else {
+			id obj = $(concurrent, objectForKey, key);
+			if (obj) {
+				found++;
+				release(obj);
+			}
+		}
+	}
+
+	return NULL;
+}
+
+static void *unretainedWorker(void *data) {
+
+	unsigned state = (unsigned) (intptr_t) data;
+	volatile size_t found = 0;
+
+	for (int i = 0; i < OPERATIONS; i++) {
+
+		const unsigned r = next(&state);
+		Number *key = keys[r % KEYS];
+
+		if ((int) ((r >> 16) % 100) < writes) {
+			$(concurrent, setObjectForKey, key, key);
+		} else {
+			$(concurrent, enter);
+			found += $(concurrent, unretainedObjectForKey, key) != NULL;
+			$(concurrent, leave);
+		}
+	}
+
+	return NULL;
+}
+
+/**
+ * @return The operations per second of `threads` threads running `worker`.
+ */
+static double run(void *(*worker)(void *), int threads) {
+
+	pthread_t *ids = calloc(threads, sizeof(pthread_t));
+
+	struct timespec start;
+	clock_gettime(CLOCK_MONOTONIC, &start);
+
+	for (int i = 0; i < threads; i++) {
+		pthread_create(&ids[i], NULL, worker, (void *) (intptr_t) (i + 1));
+	}
+
+	for (int i = 0; i < threads; i++) {
+		pthread_join(ids[i], NULL);
+	}
+
+	const double seconds = elapsed(&start);
+
+	free(ids);
+
+	return (double) threads * OPERATIONS / seconds;
+}
+
+int main(int argc, char **argv) {
+
+	const int max = argc > 1 ? atoi(argv[1]) : 8;
+	writes = argc > 2 ? atoi(argv[2]) : 10;
+
+	locked = $(alloc(MutableDictionary), init);
+	lock = $(alloc(Lock), init);
+
+	concurrent = $(alloc(ConcurrentDictionary), init);
+
+	for (int i = 0; i < KEYS; i++) {
+		keys[i] = $(alloc(Number), initWithValue, i);
+
+		$(locked, setObjectForKey, keys[i], keys[i]);
+		$(concurrent, setObjectForKey, keys[i], keys[i]);
+	}
+
+	printf("%d%% writes\n", writes);
+	printf("%8s %16s %16s %16s\n", "threads", "locked", "concurrent", "unretained");
+
+	for (int threads = 1; threads <= max; threads *= 2) {
+
+		const double lockedOps = run(lockedWorker, threads);
+		const double concurrentOps = run(concurrentWorker, threads);
+		const double unretainedOps = run(unretainedWorker, threads);
+
+		printf("%8d %12.2f M/s %12.2f M/s %12.2f M/s\n", threads,
+				lockedOps / 1e6, concurrentOps / 1e6, unretainedOps / 1e6);
+	}
+
+	release(concurrent);
+	release(lock);
+	release(locked);
+
+	for (int i = 0; i < KEYS; i++) {
+		release(keys[i]);
+	}
+
+	return 0;
+}
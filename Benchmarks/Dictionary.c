@@ -0,0 +1,231 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include <Objectively.h>
+
+/**
+ * @file
+ *
+ * @brief Measures MutableDictionary insert, lookup and delete throughput
+ * against the chained layout it replaced, in which each bin was a MutableArray
+ * of alternating keys and values.
+ *
+ * Usage: Dictionary [max entries], which defaults to 1000000.
+ */
+
+/**
+ * @return The seconds elapsed since `start`.
+ */
+static double elapsed(const struct timespec *start) {
+
+	struct timespec end;
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	return (end.tv_sec - start->tv_sec) + (end.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+/**
+ * @brief The chained layout, which grew by doubling when its count reached
+ * its bin count.
+ */
+typedef struct {
+	MutableArray **bins;
+	size_t capacity, count;
+} Chained;
+
+static MutableArray *chainedBin(Chained *chained, const id key, BOOL create) {
+
+	const size_t bin = HashForObject64(HASH_SEED, key) % chained->capacity;
+
+	if (chained->bins[bin] == NULL && create) {
+		chained->bins[bin] = $(alloc(MutableArray), init);
+	}
+
+	return chained->bins[bin];
+}
+
+static void chainedSet(Chained *chained, const id obj, const id key);
+
+static void chainedResize(Chained *chained) {
+
+	if (chained->count < chained->capacity) {
+		return;
+	}
+
+	MutableArray **bins = chained->bins;
+	const size_t capacity = chained->capacity;
+
+	chained->capacity *= 2;
+	chained->count = 0;
+	chained->bins = calloc(chained->capacity, sizeof(MutableArray *));
+
+	for (size_t i = 0; i < capacity; i++) {
+		if (bins[i]) {
+			const Array *array = (Array *) bins[i];
+			for (size_t j = 0; j < array->count; j += 2) {
+				chainedSet(chained, $(array, objectAtIndex, j + 1), $(array, objectAtIndex, j));
+			}
+			release(bins[i]);
+		}
+	}
+
+	free(bins);
+}
+
+static void chainedSet(Chained *chained, const id obj, const id key) {
+
+	chainedResize(chained);
+
+	MutableArray *array = chainedBin(chained, key, YES);
+
+	const int index = $((Array *) array, indexOfObject, key);
+	if (index > -1) {
+		$(array, setObjectAtIndex, obj, index + 1);
+	} else {
+		$(array, addObject, key);
+		$(array, addObject, obj);
+		chained->count++;
+	}
+}
+
+static id chainedGet(Chained *chained, const id key) {
+
+	const Array *array = (Array *) chainedBin(chained, key, NO);
+	if (array) {
+		const int index = $(array, indexOfObject, key);
+		if (index > -1) {
+			return $(array, objectAtIndex, index + 1);
+		}
+	}
+
+	return NULL;
+}
+
+static void chainedRemove(Chained *chained, const id key) {
+
+	MutableArray *array = chainedBin(chained, key, NO);
+	if (array) {
+		const int index = $((Array *) array, indexOfObject, key);
+		if (index > -1) {
+			$(array, removeObjectAtIndex, index);
+			$(array, removeObjectAtIndex, index);
+			chained->count--;
+		}
+	}
+}
+
+static void chainedFree(Chained *chained) {
+
+	for (size_t i = 0; i < chained->capacity; i++) {
+		release(chained->bins[i]);
+	}
+
+	free(chained->bins);
+}
+
+/**
+ * @brief Prints the nanoseconds per operation of `seconds` over `count`.
+ */
+static void report(const char *layout, size_t count, double insert, double lookup, double delete) {
+
+	printf("%10zu %8s %10.1f ns %10.1f ns %10.1f ns\n", count, layout,
+		   insert * 1e9 / count, lookup * 1e9 / count, delete * 1e9 / count);
+}
+
+int main(int argc, char **argv) {
+
+	const size_t max = argc > 1 ? strtoul(argv[1], NULL, 10) : 1000000;
+
+	printf("%10s %8s %13s %13s %13s\n", "entries", "layout", "insert", "lookup", "delete");
+
+	for (size_t count = 1000; count <= max; count *= 10) {
+
+		String **keys = malloc(count * sizeof(String *));
+		for (size_t i = 0; i < count; i++) {
+			keys[i] = $(alloc(String), initWithFormat, "key-%zu", i);
+		}
+
+		struct timespec start;
+		volatile size_t found = 0;
+
+		Chained chained = { .bins = calloc(64, sizeof(MutableArray *)), .capacity = 64 };
+
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		for (size_t i = 0; i < count; i++) {
+			chainedSet(&chained, keys[i], keys[i]);
+		}
+		const double chainedInsert = elapsed(&start);
+
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		for (size_t i = 0; i < count; i++) {
+			found += chainedGet(&chained, keys[i]) != NULL;
+		}
+		const double chainedLookup = elapsed(&start);
+
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		for (size_t i = 0; i < count; i++) {
+			chainedRemove(&chained, keys[i]);
+		}
+		const double chainedDelete = elapsed(&start);
+
+		chainedFree(&chained);
+
+		report("chained", count, chainedInsert, chainedLookup, chainedDelete);
+
+		MutableDictionary *dict = $(alloc(MutableDictionary), init);
+
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		for (size_t i = 0; i < count; i++) {
+			$(dict, setObjectForKey, keys[i], keys[i]);
+		}
+		const double insert = elapsed(&start);
+
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		for (size_t i = 0; i < count; i++) {
+			found += $((Dictionary *) dict, objectForKey, keys[i]) != NULL;
+		}
+		const double lookup = elapsed(&start);
+
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		for (size_t i = 0; i < count; i++) {
+			$(dict, removeObjectForKey, keys[i]);
+		}
+		const double delete = elapsed(&start);
+
+		release(dict);
+
+		report("swiss", count, insert, lookup, delete);
+
+		for (size_t i = 0; i < count; i++) {
+			release(keys[i]);
+		}
+
+		free(keys);
+	}
+
+	return 0;
+}
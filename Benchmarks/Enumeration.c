@@ -0,0 +1,163 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include <Objectively.h>
+
+/**
+ * @file
+ *
+ * @brief Measures the cost per element of enumerating Arrays, Dictionaries and
+ * Sets with an enumerator function, and with a Cursor via `foreach`.
+ *
+ * Usage: Enumeration [count] [passes], which default to 1000000 and 20.
+ */
+
+/**
+ * @return The seconds elapsed since `start`.
+ */
+static double elapsed(const struct timespec *start) {
+
+	struct timespec end;
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	return (end.tv_sec - start->tv_sec) + (end.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+static BOOL arrayEnumerator(const Array *array, id obj, id data) {
+
+	*(uintptr_t *) data += (uintptr_t) obj; return NO;
+}
+
+static BOOL dictionaryEnumerator(const Dictionary *dictionary, id obj, id key, id data) {
+
+	*(uintptr_t *) data += (uintptr_t) obj; return NO;
+}
+
+static BOOL setEnumerator(const Set *set, id obj, id data) {
+
+	*(uintptr_t *) data += (uintptr_t) obj; return NO;
+}
+
+/**
+ * @brief Prints the nanoseconds per element of `enumerator` and `cursor`.
+ */
+static void report(const char *collection, size_t elements, double enumerator, double cursor) {
+
+	printf("%12s %10.2f ns %10.2f ns\n", collection, enumerator * 1e9 / elements, cursor * 1e9 / elements);
+}
+
+int main(int argc, char **argv) {
+
+	const size_t count = argc > 1 ? strtoul(argv[1], NULL, 10) : 1000000;
+	const size_t passes = argc > 2 ? strtoul(argv[2], NULL, 10) : 20;
+
+	MutableArray *array = $(alloc(MutableArray), initWithCapacity, count);
+	MutableDictionary *dictionary = $(alloc(MutableDictionary), initWithCapacity, count);
+	MutableSet *set = $(alloc(MutableSet), initWithCapacity, count);
+
+	for (size_t i = 0; i < count; i++) {
+		Number *number = $(alloc(Number), initWithValue, i);
+
+		$(array, addObject, number);
+		$(dictionary, setObjectForKey, number, number);
+		$(set, addObject, number);
+
+		release(number);
+	}
+
+	printf("%12s %13s %13s\n", "collection", "enumerator", "foreach");
+
+	struct timespec start;
+	volatile uintptr_t sink = 0;
+	uintptr_t sum;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (size_t pass = 0; pass < passes; pass++) {
+		sum = 0;
+		$((Array *) array, enumerateObjects, arrayEnumerator, &sum);
+		sink += sum;
+	}
+	const double arrayEnumerate = elapsed(&start);
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (size_t pass = 0; pass < passes; pass++) {
+		uintptr_t total = 0;
+		foreach(id obj, (Array *) array) {
+			total += (uintptr_t) obj;
+		}
+		sink += total;
+	}
+	const double arrayCursor = elapsed(&start);
+
+	report("Array", count * passes, arrayEnumerate, arrayCursor);
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (size_t pass = 0; pass < passes; pass++) {
+		sum = 0;
+		$((Dictionary *) dictionary, enumerateObjectsAndKeys, dictionaryEnumerator, &sum);
+		sink += sum;
+	}
+	const double dictionaryEnumerate = elapsed(&start);
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (size_t pass = 0; pass < passes; pass++) {
+		uintptr_t total = 0;
+		foreach(id obj, (Dictionary *) dictionary) {
+			total += (uintptr_t) obj;
+		}
+		sink += total;
+	}
+	const double dictionaryCursor = elapsed(&start);
+
+	report("Dictionary", count * passes, dictionaryEnumerate, dictionaryCursor);
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (size_t pass = 0; pass < passes; pass++) {
+		sum = 0;
+		$((Set *) set, enumerateObjects, setEnumerator, &sum);
+		sink += sum;
+	}
+	const double setEnumerate = elapsed(&start);
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (size_t pass = 0; pass < passes; pass++) {
+		uintptr_t total = 0;
+		foreach(id obj, (Set *) set) {
+			total += (uintptr_t) obj;
+		}
+		sink += total;
+	}
+	const double setCursor = elapsed(&start);
+
+	report("Set", count * passes, setEnumerate, setCursor);
+
+	release(array);
+	release(dictionary);
+	release(set);
+
+	return sink == 0;
+}
@@ -0,0 +1,112 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include <Objectively.h>
+
+/**
+ * @file
+ *
+ * @brief Measures the time to freeze a Dictionary, and its lookup throughput
+ * before and after freezing.
+ *
+ * Usage: FrozenDictionary [max entries], which defaults to 1000000.
+ */
+
+#define ROUNDS 4
+
+/**
+ * @return The seconds elapsed since `start`.
+ */
+static double elapsed(const struct timespec *start) {
+
+	struct timespec end;
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	return (end.tv_sec - start->tv_sec) + (end.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+/**
+ * @return The seconds taken to look up each of `keys` in `dict`, `ROUNDS` times.
+ */
+static double lookup(const Dictionary *dict, String **keys, size_t count) {
+
+	volatile size_t found = 0;
+
+	struct timespec start;
+	clock_gettime(CLOCK_MONOTONIC, &start);
+
+	for (int round = 0; round < ROUNDS; round++) {
+		for (size_t i = 0; i < count; i++) {
+			found += $(dict, objectForKey, keys[i]) != NULL;
+		}
+	}
+
+	return elapsed(&start);
+}
+
+int main(int argc, char **argv) {
+
+	const size_t max = argc > 1 ? strtoul(argv[1], NULL, 10) : 1000000;
+
+	printf("%10s %13s %13s %13s\n", "entries", "freeze", "dictionary", "frozen");
+
+	for (size_t count = 1000; count <= max; count *= 10) {
+
+		String **keys = malloc(count * sizeof(String *));
+
+		MutableDictionary *dict = $(alloc(MutableDictionary), init);
+
+		for (size_t i = 0; i < count; i++) {
+			keys[i] = $(alloc(String), initWithFormat, "key-%zu", i);
+			$(dict, setObjectForKey, keys[i], keys[i]);
+		}
+
+		struct timespec start;
+		clock_gettime(CLOCK_MONOTONIC, &start);
+
+		Dictionary *frozen = $((Dictionary *) dict, frozenCopy);
+
+		const double freeze = elapsed(&start);
+
+		const double dictLookup = lookup((Dictionary *) dict, keys, count);
+		const double frozenLookup = lookup(frozen, keys, count);
+
+		printf("%10zu %10.1f ns %10.1f ns %10.1f ns\n", count, freeze * 1e9 / count,
+			   dictLookup * 1e9 / (count * ROUNDS), frozenLookup * 1e9 / (count * ROUNDS));
+
+		release(frozen);
+		release(dict);
+
+		for (size_t i = 0; i < count; i++) {
+			release(keys[i]);
+		}
+
+		free(keys);
+	}
+
+	return 0;
+}
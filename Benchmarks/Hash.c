@@ -0,0 +1,89 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include <Objectively.h>
+
+/**
+ * @file
+ *
+ * @brief Measures the throughput of HashForBytes and HashForBytes64.
+ */
+
+#define BYTES (64 * 1024 * 1024)
+
+/**
+ * @return The seconds elapsed since `start`.
+ */
+static double elapsed(const struct timespec *start) {
+
+	struct timespec end;
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	return (end.tv_sec - start->tv_sec) + (end.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+int main(int argc, char **argv) {
+
+	byte *bytes = malloc(BYTES);
+	for (size_t i = 0; i < BYTES; i++) {
+		bytes[i] = (byte) rand();
+	}
+
+	const int lengths[] = { 8, 16, 32, 64, 256, 1024, 64 * 1024 };
+
+	printf("%10s %16s %16s\n", "length", "HashForBytes", "HashForBytes64");
+
+	for (size_t i = 0; i < lengthof(lengths); i++) {
+
+		const int length = lengths[i];
+		const int count = BYTES / length;
+
+		struct timespec start;
+		volatile int hash = 0;
+		volatile uint64_t hash64 = 0;
+
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		for (int j = 0; j < count; j++) {
+			const RANGE range = { j * length, length };
+			hash += HashForBytes(HASH_SEED, bytes, range);
+		}
+		const double seconds = elapsed(&start);
+
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		for (int j = 0; j < count; j++) {
+			const RANGE range = { j * length, length };
+			hash64 += HashForBytes64(HASH_SEED, bytes, range);
+		}
+		const double seconds64 = elapsed(&start);
+
+		printf("%10d %11.2f MB/s %11.2f MB/s\n", length, BYTES / seconds / 1e6, BYTES / seconds64 / 1e6);
+	}
+
+	free(bytes);
+
+	return 0;
+}
@@ -0,0 +1,123 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <stdio.h>
+#include <time.h>
+
+#include <Objectively.h>
+
+/**
+ * @file
+ *
+ * @brief Measures Dictionary lookup latency under a collision attack, with
+ * unkeyed and keyed hashing.
+ *
+ * The adversarial keys are chosen, as an attacker could, so that their
+ * unkeyed hashes all fall into bin 0 at every power of two capacity.
+ */
+
+#define KEYS 2048
+#define LOOKUPS 16
+
+/**
+ * @return The seconds elapsed since `start`.
+ */
+static double elapsed(const struct timespec *start) {
+
+	struct timespec end;
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	return (end.tv_sec - start->tv_sec) + (end.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+/**
+ * @return An Array of `KEYS` Strings, colliding under unkeyed hashing if `adversarial`.
+ */
+static Array *keys(BOOL adversarial) {
+
+	MutableArray *keys = $(alloc(MutableArray), initWithCapacity, KEYS);
+
+	for (unsigned i = 0; ((Array *) keys)->count < KEYS; i++) {
+
+		String *key = $(alloc(String), initWithFormat, "key%08x", i);
+
+		if (adversarial == NO || (HashForObject64(HASH_SEED, key) % KEYS) == 0) {
+			$(keys, addObject, key);
+		}
+
+		release(key);
+	}
+
+	return (Array *) keys;
+}
+
+/**
+ * @return The mean lookup latency, in nanoseconds, of `keys` in a Dictionary
+ * hashed with `hashKey`.
+ */
+static double latency(const Array *keys, const HashKey *hashKey) {
+
+	MutableDictionary *dict = $(alloc(MutableDictionary), initWithCapacityAndHashKey, 0, hashKey);
+
+	for (size_t i = 0; i < keys->count; i++) {
+		id key = $(keys, objectAtIndex, i);
+		$(dict, setObjectForKey, key, key);
+	}
+
+	struct timespec start;
+	clock_gettime(CLOCK_MONOTONIC, &start);
+
+	volatile size_t found = 0;
+
+	for (int i = 0; i < LOOKUPS; i++) {
+		for (size_t j = 0; j < keys->count; j++) {
+			id key = $(keys, objectAtIndex, j);
+			found += $((Dictionary *) dict, objectForKey, key) != NULL;
+		}
+	}
+
+	const double seconds = elapsed(&start);
+
+	release(dict);
+
+	return seconds * 1e9 / (LOOKUPS * keys->count);
+}
+
+int main(int argc, char **argv) {
+
+	Array *random = keys(NO);
+	Array *adversarial = keys(YES);
+
+	printf("%12s %16s %16s\n", "keys", "unkeyed", "keyed");
+
+	printf("%12s %13.1f ns %13.1f ns\n", "random",
+		   latency(random, NULL), latency(random, HashKeyForProcess()));
+
+	printf("%12s %13.1f ns %13.1f ns\n", "adversarial",
+		   latency(adversarial, NULL), latency(adversarial, HashKeyForProcess()));
+
+	release(random);
+	release(adversarial);
+
+	return 0;
+}
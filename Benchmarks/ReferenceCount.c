@@ -0,0 +1,85 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include <Objectively.h>
+
+/**
+ * @file
+ *
+ * @brief Measures the cost of building and releasing a JSON object graph.
+ *
+ * Compares reference counts biased towards the allocating thread, which
+ * retains and releases without atomic operations, with unbiased, atomic
+ * reference counts.
+ */
+
+#define ITERATIONS 10000
+
+static const char *json = "{"
+	"\"name\": \"Objectively\", \"version\": 1.0, \"stable\": true, \"license\": null,"
+	"\"tags\": [\"c\", \"gnu\", \"object\", \"oriented\", \"framework\", \"json\"],"
+	"\"authors\": [{\"name\": \"Jay\", \"commits\": 1024}, {\"name\": \"Anon\", \"commits\": 1}],"
+	"\"matrix\": [[1, 2, 3, 4], [5, 6, 7, 8], [9, 10, 11, 12], [13, 14, 15, 16]]"
+"}";
+
+/**
+ * @return The nanoseconds per iteration of parsing, then releasing, `json`.
+ */
+static double run(const Data *data) {
+
+	struct timespec start, end;
+	clock_gettime(CLOCK_MONOTONIC, &start);
+
+	for (size_t i = 0; i < ITERATIONS; i++) {
+		release($$(JSONSerialization, objectFromData, data, 0));
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	const double elapsed = (end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec);
+
+	return elapsed / ITERATIONS;
+}
+
+int main(int argc, char **argv) {
+
+	Data *data = $$(Data, dataWithBytes, (const byte *) json, strlen(json));
+
+	release($$(JSONSerialization, objectFromData, data, 0));
+
+	printf("%12s %16s\n", "counts", "ns/document");
+
+	_biasedReferenceCounts = YES;
+	printf("%12s %16.2f\n", "biased", run(data));
+
+	_biasedReferenceCounts = NO;
+	printf("%12s %16.2f\n", "unbiased", run(data));
+
+	release(data);
+
+	return 0;
+}
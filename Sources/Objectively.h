@@ -30,15 +30,20 @@
  * @brief Objectively: Ultra-lightweight object oriented framework for GNU C.
  */
 
+#include <Objectively/Arena.h>
 #include <Objectively/Array.h>
+#include <Objectively/AutoreleasePool.h>
 #include <Objectively/Boolean.h>
 #include <Objectively/Class.h>
+#include <Objectively/ConcurrentDictionary.h>
 #include <Objectively/Condition.h>
+#include <Objectively/Cursor.h>
 #include <Objectively/Data.h>
 #include <Objectively/Date.h>
 #include <Objectively/DateFormatter.h>
 #include <Objectively/Dictionary.h>
 #include <Objectively/Error.h>
+#include <Objectively/FrozenDictionary.h>
 #include <Objectively/Hash.h>
 #include <Objectively/JSONPath.h>
 #include <Objectively/JSONSerialization.h>
@@ -47,6 +52,7 @@
 #include <Objectively/MutableArray.h>
 #include <Objectively/MutableData.h>
 #include <Objectively/MutableDictionary.h>
+#include <Objectively/MutableOrderedDictionary.h>
 #include <Objectively/MutableSet.h>
 #include <Objectively/MutableString.h>
 #include <Objectively/Null.h>
@@ -56,8 +62,12 @@
 #include <Objectively/Operation.h>
 #include <Objectively/OperationQueue.h>
 #include <Objectively/Once.h>
+#include <Objectively/OrderedDictionary.h>
+#include <Objectively/Profile.h>
+#include <Objectively/Reclaimer.h>
 #include <Objectively/Regex.h>
 #include <Objectively/Set.h>
+#include <Objectively/Statistics.h>
 #include <Objectively/String.h>
 #include <Objectively/Thread.h>
 #include <Objectively/Types.h>
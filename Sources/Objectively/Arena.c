@@ -0,0 +1,287 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <Objectively/Arena.h>
+
+#define _Class _Arena
+
+/**
+ * @brief The alignment of Objects allocated from Arenas.
+ */
+#define ARENA_ALIGNMENT 16
+
+/**
+ * @brief Rounds `size` up to `ARENA_ALIGNMENT`.
+ */
+#define ArenaAlign(size) (((size) + ARENA_ALIGNMENT - 1) & ~(ARENA_ALIGNMENT - 1))
+
+/**
+ * @brief The blocks from which Arenas allocate.
+ */
+typedef struct ArenaBlock {
+
+	/**
+	 * @brief The next block.
+	 */
+	struct ArenaBlock *next;
+
+	/**
+	 * @brief The capacity of `bytes`.
+	 */
+	size_t size;
+
+	/**
+	 * @brief The number of `bytes` allocated.
+	 */
+	size_t used;
+
+	/**
+	 * @brief The Objects.
+	 */
+	byte bytes[] __attribute__((aligned(ARENA_ALIGNMENT)));
+} ArenaBlock;
+
+/**
+ * @brief The count of instances of a Class allocated from an Arena.
+ */
+typedef struct {
+
+	/**
+	 * @brief The Class.
+	 */
+	Class *clazz;
+
+	/**
+	 * @brief The count of instances.
+	 */
+	size_t count;
+} ArenaInstances;
+
+__thread Arena *_currentArena;
+
+#pragma mark - ObjectInterface
+
+/**
+ * @see ObjectInterface::copy(const Object *)
+ */
+static Object *copy(const Object *self) {
+	return NULL;
+}
+
+/**
+ * @see ObjectInterface::dealloc(Object *)
+ */
+static void dealloc(Object *self) {
+
+	Arena *this = (Arena *) self;
+
+	assert(_currentArena != this);
+
+	void (*deallocObject)(Object *) = ((ObjectInterface *) _Object.interface)->dealloc;
+
+	ArenaInstances *instances = this->instances;
+	BOOL overrides = NO;
+
+	for (size_t i = 0; i < this->instancesLength; i++) {
+		if (instances[i].count) {
+
+			_deallocArenaInstances(instances[i].clazz, instances[i].count);
+
+			if (((ObjectInterface *) instances[i].clazz->interface)->dealloc != deallocObject) {
+				overrides = YES;
+			}
+		}
+	}
+
+	free(instances);
+
+	if (overrides) {
+		for (ArenaBlock *block = this->blocks; block; block = block->next) {
+
+			size_t offset = 0;
+			while (offset < block->used) {
+
+				Object *object = (Object *) (block->bytes + offset);
+				offset += ArenaAlign(object->clazz->instanceSize);
+
+				ObjectInterface *interface = (ObjectInterface *) object->clazz->interface;
+				if (interface->dealloc != deallocObject) {
+					interface->dealloc(object);
+				}
+			}
+		}
+	}
+
+	ArenaBlock *block = this->blocks;
+	while (block) {
+
+		ArenaBlock *next = block->next;
+		free(block);
+		block = next;
+	}
+
+	super(Object, self, dealloc);
+}
+
+#pragma mark - ArenaInterface
+
+/**
+ * @see ArenaInterface::currentArena(void)
+ */
+static Arena *currentArena(void) {
+	return _currentArena;
+}
+
+/**
+ * @see ArenaInterface::enter(Arena *)
+ */
+static void enter(Arena *self) {
+
+	self->previous = _currentArena;
+	_currentArena = self;
+}
+
+/**
+ * @see ArenaInterface::init(Arena *)
+ */
+static Arena *init(Arena *self) {
+	return $(self, initWithBlockSize, ARENA_BLOCK_SIZE);
+}
+
+/**
+ * @see ArenaInterface::initWithBlockSize(Arena *, size_t)
+ */
+static Arena *initWithBlockSize(Arena *self, size_t blockSize) {
+
+	self = (Arena *) super(Object, self, init);
+	if (self) {
+
+		assert(blockSize);
+		self->blockSize = blockSize;
+	}
+
+	return self;
+}
+
+/**
+ * @see ArenaInterface::leave(Arena *)
+ */
+static void leave(Arena *self) {
+
+	assert(_currentArena == self);
+
+	_currentArena = self->previous;
+	self->previous = NULL;
+}
+
+#pragma mark - Arena
+
+id _arenaAlloc(Arena *arena, Class *clazz) {
+
+	const size_t index = clazz->locals.cache;
+	if (index >= arena->instancesLength) {
+
+		size_t length = arena->instancesLength ?: 16;
+		while (length <= index) {
+			length <<= 1;
+		}
+
+		arena->instances = realloc(arena->instances, length * sizeof(ArenaInstances));
+		assert(arena->instances);
+
+		memset((ArenaInstances *) arena->instances + arena->instancesLength, 0,
+			(length - arena->instancesLength) * sizeof(ArenaInstances));
+
+		arena->instancesLength = length;
+	}
+
+	ArenaInstances *instances = (ArenaInstances *) arena->instances + index;
+	instances->clazz = clazz;
+	instances->count++;
+
+	const size_t size = ArenaAlign(clazz->instanceSize);
+
+	ArenaBlock *block = arena->blocks;
+	if (block == NULL || block->used + size > block->size) {
+
+		const size_t blockSize = size > arena->blockSize ? size : arena->blockSize;
+
+		ArenaBlock *new = malloc(sizeof(ArenaBlock) + blockSize);
+		assert(new);
+
+		new->size = blockSize;
+		new->used = 0;
+
+		if (block && block->size - block->used > blockSize - size) {
+			new->next = block->next;
+			block->next = new;
+		} else {
+			new->next = block;
+			arena->blocks = new;
+		}
+
+		block = new;
+	}
+
+	id obj = block->bytes + block->used;
+	block->used += size;
+
+	return obj;
+}
+
+#pragma mark - Class lifecycle
+
+/**
+ * @see Class::initialize(Class *)
+ */
+static void initialize(Class *clazz) {
+
+	ObjectInterface *object = (ObjectInterface *) clazz->interface;
+
+	object->copy = copy;
+	object->dealloc = dealloc;
+
+	ArenaInterface *arena = (ArenaInterface *) clazz->interface;
+
+	arena->currentArena = currentArena;
+	arena->enter = enter;
+	arena->init = init;
+	arena->initWithBlockSize = initWithBlockSize;
+	arena->leave = leave;
+}
+
+Class _Arena = {
+	.name = "Arena",
+	.superclass = &_Object,
+	.instanceSize = sizeof(Arena),
+	.interfaceOffset = offsetof(Arena, interface),
+	.interfaceSize = sizeof(ArenaInterface),
+	.initialize = initialize,
+	.flags = CLASS_NO_ARENA,
+};
+
+#undef _Class
@@ -0,0 +1,206 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef _Objectively_Arena_h_
+#define _Objectively_Arena_h_
+
+#include <Objectively/Object.h>
+
+/**
+ * @file
+ *
+ * @brief Arenas allocate whole Object graphs from large blocks of memory.
+ *
+ * Objects allocated while an Arena is current are carved from its blocks, and
+ * live for as long as the Arena does. Retaining and releasing them has no
+ * effect. When the Arena is deallocated, its Objects whose Class overrides
+ * `dealloc` are deallocated in a single linear pass, which is skipped if there
+ * are none, and its blocks are freed.
+ *
+ * Objects allocated from an Arena must not be referenced after the Arena is
+ * deallocated, e.g. by adding them to collections that outlive the Arena.
+ */
+
+typedef struct Arena Arena;
+typedef struct ArenaInterface ArenaInterface;
+
+/**
+ * @brief The default block size of Arenas, in bytes.
+ */
+#define ARENA_BLOCK_SIZE 0x10000
+
+/**
+ * @brief Arenas allocate whole Object graphs from large blocks of memory.
+ *
+ * @extends Object
+ */
+struct Arena {
+
+	/**
+	 * @brief The parent.
+	 *
+	 * @private
+	 */
+	Object object;
+
+	/**
+	 * @brief The typed interface.
+	 *
+	 * @private
+	 */
+	ArenaInterface *interface;
+
+	/**
+	 * @brief The blocks, most recently allocated first.
+	 *
+	 * @private
+	 */
+	id blocks;
+
+	/**
+	 * @brief The count of instances of each Class allocated from this Arena,
+	 * indexed by the Class' cache index.
+	 *
+	 * @private
+	 */
+	id instances;
+
+	/**
+	 * @brief The length of `instances`.
+	 *
+	 * @private
+	 */
+	size_t instancesLength;
+
+	/**
+	 * @brief The block size, in bytes.
+	 */
+	size_t blockSize;
+
+	/**
+	 * @brief The Arena that was current when this Arena was entered.
+	 *
+	 * @private
+	 */
+	Arena *previous;
+};
+
+/**
+ * @brief The Arena interface.
+ */
+struct ArenaInterface {
+
+	/**
+	 * @brief The parent interface.
+	 */
+	ObjectInterface objectInterface;
+
+	/**
+	 * @return The calling thread's current Arena, or `NULL`.
+	 *
+	 * @relates Arena
+	 */
+	Arena *(*currentArena)(void);
+
+	/**
+	 * @brief Makes this Arena the calling thread's current Arena.
+	 *
+	 * @remark Arenas are strictly nested, and each call to `enter` must be
+	 * balanced by a call to `leave` on the same thread.
+	 *
+	 * @relates Arena
+	 */
+	void (*enter)(Arena *self);
+
+	/**
+	 * @brief Initializes this Arena with the default block size.
+	 *
+	 * @return The initialized Arena, or `NULL` on error.
+	 *
+	 * @relates Arena
+	 */
+	Arena *(*init)(Arena *self);
+
+	/**
+	 * @brief Initializes this Arena with the given block size.
+	 *
+	 * @param blockSize The block size, in bytes.
+	 *
+	 * @return The initialized Arena, or `NULL` on error.
+	 *
+	 * @relates Arena
+	 */
+	Arena *(*initWithBlockSize)(Arena *self, size_t blockSize);
+
+	/**
+	 * @brief Restores the Arena that was current when this Arena was entered.
+	 *
+	 * @relates Arena
+	 */
+	void (*leave)(Arena *self);
+};
+
+/**
+ * @brief The Arena Class.
+ */
+extern Class _Arena;
+
+/**
+ * @brief The calling thread's current Arena.
+ *
+ * @private
+ */
+extern __thread Arena *_currentArena;
+
+/**
+ * @brief Allocates an instance of the given Class from the given Arena.
+ *
+ * @private
+ */
+extern id _arenaAlloc(Arena *arena, Class *clazz);
+
+/**
+ * @brief Executes `statements` with `_arena` as the current Arena.
+ *
+ * @param _arena The Arena instance.
+ * @param statements The statements to perform while the Arena is current.
+ */
+#define WithArena(_arena, statements) { \
+	$((Arena *) _arena, enter); \
+		statements; \
+	$((Arena *) _arena, leave); \
+}
+
+/**
+ * @brief Executes `statements` with no current Arena, e.g. to create shared
+ * instances that must outlive the current Arena.
+ *
+ * @param statements The statements to perform without an Arena.
+ */
+#define WithoutArena(statements) { \
+	Arena *_arena = _currentArena; _currentArena = NULL; \
+		statements; \
+	_currentArena = _arena; \
+}
+
+#endif
@@ -29,9 +29,16 @@
 #include <Objectively/Hash.h>
 #include <Objectively/MutableArray.h>
 #include <Objectively/MutableString.h>
+#include <Objectively/OperationQueue.h>
+#include <Objectively/Reclaimer.h>
 
 #define _Class _Array
 
+/**
+ * @brief The count of elements in each iteration of the concurrent methods.
+ */
+#define CONCURRENT_CHUNK_SIZE 4096
+
 #pragma mark - ObjectInterface
 
 /**
@@ -51,6 +58,10 @@ static void dealloc(Object *self) {
 
 	Array *this = (Array *) self;
 
+	if (_reclaim(self, this->count, dealloc)) {
+		return;
+	}
+
 	for (size_t i = 0; i < this->count; i++) {
 		release(this->elements[i]);
 	}
@@ -209,6 +220,77 @@ static void enumerateObjects(const Array *self, ArrayEnumerator enumerator, id d
 	}
 }
 
+/**
+ * @brief The state of the concurrent methods, which their iterations share.
+ */
+typedef struct {
+	const Array *array;
+	ArrayEnumerator enumerator;
+	ArrayMapper mapper;
+	id data;
+	BOOL stop;
+	id *matches;
+	size_t *counts;
+	id *results;
+} Concurrent;
+
+/**
+ * @return The count of iterations of the concurrent methods for `array`.
+ */
+static size_t chunks(const Array *array) {
+
+	return (array->count + CONCURRENT_CHUNK_SIZE - 1) / CONCURRENT_CHUNK_SIZE;
+}
+
+/**
+ * @return The index after the last element of `chunk`.
+ */
+static size_t chunkEnd(const Array *array, size_t chunk) {
+
+	const size_t end = (chunk + 1) * CONCURRENT_CHUNK_SIZE;
+
+	return end < array->count ? end : array->count;
+}
+
+/**
+ * @brief ApplyFunction for enumerateObjectsConcurrently.
+ */
+static void enumerateObjectsConcurrently_apply(size_t chunk, id data) {
+
+	Concurrent *concurrent = data;
+
+	const Array *self = concurrent->array;
+	const size_t end = chunkEnd(self, chunk);
+
+	for (size_t i = chunk * CONCURRENT_CHUNK_SIZE; i < end; i++) {
+
+		if (__atomic_load_n(&concurrent->stop, __ATOMIC_RELAXED)) {
+			break;
+		}
+
+		if (concurrent->enumerator(self, self->elements[i], concurrent->data)) {
+			__atomic_store_n(&concurrent->stop, YES, __ATOMIC_RELAXED);
+			break;
+		}
+	}
+}
+
+/**
+ * @see ArrayInterface::enumerateObjectsConcurrently(const Array *, ArrayEnumerator, id)
+ */
+static void enumerateObjectsConcurrently(const Array *self, ArrayEnumerator enumerator, id data) {
+
+	assert(enumerator);
+
+	Concurrent concurrent = {
+		.array = self,
+		.enumerator = enumerator,
+		.data = data
+	};
+
+	$$(OperationQueue, apply, chunks(self), enumerateObjectsConcurrently_apply, &concurrent);
+}
+
 /**
  * @see ArrayInterface::filterObjects(const Array *, ArrayEnumerator, id)
  */
@@ -227,6 +309,77 @@ static Array *filterObjects(const Array *self, ArrayEnumerator enumerator, id da
 	return (Array *) array;
 }
 
+/**
+ * @brief ApplyFunction for filterObjectsConcurrently, which gathers the
+ * matches of each chunk into its own region of the shared buffer, so that
+ * they are merged without locking.
+ */
+static void filterObjectsConcurrently_apply(size_t chunk, id data) {
+
+	Concurrent *concurrent = data;
+
+	const Array *self = concurrent->array;
+	const size_t end = chunkEnd(self, chunk);
+
+	id *matches = concurrent->matches + chunk * CONCURRENT_CHUNK_SIZE;
+	size_t count = 0;
+
+	for (size_t i = chunk * CONCURRENT_CHUNK_SIZE; i < end; i++) {
+		if (concurrent->enumerator(self, self->elements[i], concurrent->data)) {
+			matches[count++] = self->elements[i];
+		}
+	}
+
+	concurrent->counts[chunk] = count;
+}
+
+/**
+ * @see ArrayInterface::filterObjectsConcurrently(const Array *, ArrayEnumerator, id)
+ */
+static Array *filterObjectsConcurrently(const Array *self, ArrayEnumerator enumerator, id data) {
+
+	assert(enumerator);
+
+	if (self->count == 0) {
+		return (Array *) $(alloc(MutableArray), init);
+	}
+
+	const size_t count = chunks(self);
+
+	Concurrent concurrent = {
+		.array = self,
+		.enumerator = enumerator,
+		.data = data,
+		.matches = malloc(self->count * sizeof(id)),
+		.counts = calloc(count, sizeof(size_t))
+	};
+
+	assert(concurrent.matches);
+	assert(concurrent.counts);
+
+	$$(OperationQueue, apply, count, filterObjectsConcurrently_apply, &concurrent);
+
+	size_t total = 0;
+	for (size_t i = 0; i < count; i++) {
+		total += concurrent.counts[i];
+	}
+
+	MutableArray *array = $(alloc(MutableArray), initWithCapacity, total);
+	Array *that = (Array *) array;
+
+	for (size_t i = 0; i < count; i++) {
+		const id *matches = concurrent.matches + i * CONCURRENT_CHUNK_SIZE;
+		for (size_t j = 0; j < concurrent.counts[i]; j++) {
+			that->elements[that->count++] = retain(matches[j]);
+		}
+	}
+
+	free(concurrent.matches);
+	free(concurrent.counts);
+
+	return that;
+}
+
 /**
  * @see ArrayInterface::indexOfObject(const Array *, const id)
  */
@@ -303,6 +456,46 @@ static Array *initWithObjects(Array *self, ...) {
 	return self;
 }
 
+/**
+ * @brief ApplyFunction for mapObjects.
+ */
+static void mapObjects_apply(size_t chunk, id data) {
+
+	Concurrent *concurrent = data;
+
+	const Array *self = concurrent->array;
+	const size_t end = chunkEnd(self, chunk);
+
+	for (size_t i = chunk * CONCURRENT_CHUNK_SIZE; i < end; i++) {
+		concurrent->results[i] = concurrent->mapper(self, self->elements[i], concurrent->data);
+		assert(concurrent->results[i]);
+	}
+}
+
+/**
+ * @see ArrayInterface::mapObjects(const Array *, ArrayMapper, id)
+ */
+static Array *mapObjects(const Array *self, ArrayMapper mapper, id data) {
+
+	assert(mapper);
+
+	MutableArray *array = $(alloc(MutableArray), initWithCapacity, self->count);
+	Array *that = (Array *) array;
+
+	Concurrent concurrent = {
+		.array = self,
+		.mapper = mapper,
+		.data = data,
+		.results = that->elements
+	};
+
+	$$(OperationQueue, apply, chunks(self), mapObjects_apply, &concurrent);
+
+	that->count = self->count;
+
+	return that;
+}
+
 /**
  * @see ArrayInterface::mutableCopy(const Array *)
  */
@@ -316,6 +509,24 @@ static MutableArray *mutableCopy(const Array *self) {
 	return copy;
 }
 
+/**
+ * @see ArrayInterface::nextObjects(const Array *, Cursor *)
+ */
+static size_t nextObjects(const Array *self, Cursor *cursor) {
+
+	_CursorCheckMutations(cursor, &self->mutations);
+
+	if (cursor->state == 0) {
+		cursor->state = 1;
+		cursor->objects = self->elements;
+		cursor->count = self->count;
+	} else {
+		cursor->count = 0;
+	}
+
+	return cursor->count;
+}
+
 /**
  * @see ArrayInterface::objectAtIndex(const Array *, const int)
  */
@@ -348,11 +559,15 @@ static void initialize(Class *clazz) {
 	array->arrayWithObjects = arrayWithObjects;
 	array->containsObject = containsObject;
 	array->enumerateObjects = enumerateObjects;
+	array->enumerateObjectsConcurrently = enumerateObjectsConcurrently;
 	array->filterObjects = filterObjects;
+	array->filterObjectsConcurrently = filterObjectsConcurrently;
 	array->indexOfObject = indexOfObject;
 	array->initWithArray = initWithArray;
 	array->initWithObjects = initWithObjects;
+	array->mapObjects = mapObjects;
 	array->mutableCopy = mutableCopy;
+	array->nextObjects = nextObjects;
 	array->objectAtIndex = objectAtIndex;
 }
 
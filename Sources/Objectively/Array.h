@@ -24,6 +24,7 @@
 #ifndef _Objectively_Array_h_
 #define _Objectively_Array_h_
 
+#include <Objectively/Cursor.h>
 #include <Objectively/Object.h>
 
 /**
@@ -52,6 +53,17 @@ typedef struct ArrayInterface ArrayInterface;
  */
 typedef BOOL (*ArrayEnumerator)(const Array *array, id obj, id data);
 
+/**
+ * @brief A function pointer for Array mapping.
+ *
+ * @param array The Array.
+ * @param obj The Object to map.
+ * @param data User data.
+ *
+ * @return The mapped Object, as a new reference, which the mapped Array assumes.
+ */
+typedef id (*ArrayMapper)(const Array *array, id obj, id data);
+
 /**
  * @brief Immutable arrays.
  *
@@ -86,6 +98,14 @@ struct Array {
 	 * @private
 	 */
 	id *elements;
+
+	/**
+	 * @brief The count of mutations, with which Cursors detect modification
+	 * during enumeration.
+	 *
+	 * @private
+	 */
+	size_t mutations;
 };
 
 typedef struct MutableArray MutableArray;
@@ -141,6 +161,22 @@ struct ArrayInterface {
 	 */
 	void (*enumerateObjects)(const Array *self, ArrayEnumerator enumerator, id data);
 
+	/**
+	 * @brief Enumerate the elements of this Array concurrently with the given
+	 * function.
+	 *
+	 * @param enumerator The enumerator function, which must be thread-safe.
+	 * @param data User data.
+	 *
+	 * @remark The enumerator should return `YES` to break the iteration, though
+	 * elements already being enumerated by other threads will still finish.
+	 *
+	 * @see OperationQueueInterface::apply(size_t, ApplyFunction, id)
+	 *
+	 * @relates Array
+	 */
+	void (*enumerateObjectsConcurrently)(const Array *self, ArrayEnumerator enumerator, id data);
+
 	/**
 	 * @brief Creates a new Array with elements that pass the filter function.
 	 *
@@ -153,6 +189,21 @@ struct ArrayInterface {
 	 */
 	Array *(*filterObjects)(const Array *self, ArrayEnumerator enumerator, id data);
 
+	/**
+	 * @brief Creates a new Array with elements that pass the filter function,
+	 * which is called concurrently.
+	 *
+	 * @param enumerator The enumerator function, which must be thread-safe.
+	 * @param data User data.
+	 *
+	 * @return The new, filtered Array, in the order of this Array.
+	 *
+	 * @see OperationQueueInterface::apply(size_t, ApplyFunction, id)
+	 *
+	 * @relates Array
+	 */
+	Array *(*filterObjectsConcurrently)(const Array *self, ArrayEnumerator enumerator, id data);
+
 	/**
 	 * @return The index of the given Object, or `-1` if not found.
 	 *
@@ -180,6 +231,22 @@ struct ArrayInterface {
 	 */
 	Array *(*initWithObjects)(Array *self, ...);
 
+	/**
+	 * @brief Creates a new Array with the results of the mapping function,
+	 * which is called concurrently.
+	 *
+	 * @param mapper The mapping function, which must be thread-safe.
+	 * @param data User data.
+	 *
+	 * @return The new Array, whose elements are the results of `mapper` for
+	 * the elements of this Array, in order.
+	 *
+	 * @see OperationQueueInterface::apply(size_t, ApplyFunction, id)
+	 *
+	 * @relates Array
+	 */
+	Array *(*mapObjects)(const Array *self, ArrayMapper mapper, id data);
+
 	/**
 	 * @return A MutableArray with the contents of this Array.
 	 *
@@ -187,6 +254,21 @@ struct ArrayInterface {
 	 */
 	MutableArray *(*mutableCopy)(const Array *self);
 
+	/**
+	 * @brief Fills `cursor` with the next batch of Objects in this Array.
+	 *
+	 * @param cursor The Cursor, initialized with `CursorInit` before the first batch.
+	 *
+	 * @return The count of Objects in the batch, or `0` when enumeration is complete.
+	 *
+	 * @remark The batch is the backing storage of this Array.
+	 *
+	 * @see foreach
+	 *
+	 * @relates Array
+	 */
+	size_t (*nextObjects)(const Array *self, Cursor *cursor);
+
 	/**
 	 * @param index The index of the desired Object.
 	 *
@@ -0,0 +1,156 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <assert.h>
+#include <stdlib.h>
+
+#include <pthread.h>
+
+#include <Objectively/AutoreleasePool.h>
+#include <Objectively/Class.h>
+#include <Objectively/Once.h>
+
+/**
+ * @brief The initial capacity of each thread's autorelease stack.
+ */
+#define AUTORELEASE_POOL_CHUNK_SIZE 256
+
+/**
+ * @brief The calling thread's autoreleased Objects, across all of its pools.
+ */
+static __thread id *_objects;
+
+/**
+ * @brief The count of the calling thread's autoreleased Objects.
+ */
+static __thread size_t _count;
+
+/**
+ * @brief The capacity of the calling thread's `_objects`.
+ */
+static __thread size_t _capacity;
+
+/**
+ * @brief The count of `_objects` at which each of the calling thread's pushed
+ * pools begins, indexed by depth.
+ */
+static __thread size_t *_pools;
+
+/**
+ * @brief The count of the calling thread's pushed pools.
+ */
+static __thread size_t _depth;
+
+/**
+ * @brief The capacity of the calling thread's `_pools`.
+ */
+static __thread size_t _poolsCapacity;
+
+/**
+ * @brief Ensures that autoreleased Objects are released when their thread exits.
+ */
+static pthread_key_t _key;
+
+/**
+ * @brief Releases all Objects autoreleased by the calling thread, and frees its
+ * autorelease stack. This is called when a thread that has autoreleased
+ * Objects exits.
+ */
+static void drain(id data) {
+
+	while (_count) {
+		release(_objects[--_count]);
+	}
+
+	free(_objects);
+	free(_pools);
+
+	_objects = NULL;
+	_capacity = 0;
+	_pools = NULL;
+	_poolsCapacity = 0;
+	_depth = 0;
+}
+
+AutoreleasePool AutoreleasePoolPush(void) {
+	static Once once;
+
+	DispatchOnce(once, {
+		const int err = pthread_key_create(&_key, drain);
+		assert(err == 0);
+	});
+
+	if (_depth == _poolsCapacity) {
+
+		if (_pools == NULL) {
+			pthread_setspecific(_key, &_key);
+		}
+
+		_poolsCapacity += _poolsCapacity ? _poolsCapacity : AUTORELEASE_POOL_CHUNK_SIZE;
+
+		_pools = realloc(_pools, _poolsCapacity * sizeof(size_t));
+		assert(_pools);
+	}
+
+	_pools[_depth] = _count;
+
+	return _depth++;
+}
+
+void AutoreleasePoolPop(AutoreleasePool pool) {
+
+	assert(pool < _depth);
+
+	const size_t count = _pools[pool];
+	assert(count <= _count);
+
+	while (_count > count) {
+		release(_objects[--_count]);
+	}
+
+	_depth = pool;
+}
+
+id autorelease(id obj) {
+
+	assert(_depth);
+
+	if (obj) {
+
+		if (_count == _capacity) {
+
+			if (_objects == NULL) {
+				pthread_setspecific(_key, &_key);
+			}
+
+			_capacity += _capacity ? _capacity : AUTORELEASE_POOL_CHUNK_SIZE;
+
+			_objects = realloc(_objects, _capacity * sizeof(id));
+			assert(_objects);
+		}
+
+		_objects[_count++] = obj;
+	}
+
+	return obj;
+}
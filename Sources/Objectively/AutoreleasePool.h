@@ -0,0 +1,85 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef _Objectively_AutoreleasePool_h_
+#define _Objectively_AutoreleasePool_h_
+
+#include <Objectively/Types.h>
+
+/**
+ * @file
+ *
+ * @brief Thread-local autorelease pools.
+ *
+ * An autoreleased Object is released when the innermost autorelease pool of
+ * the calling thread is popped. This allows factory methods and short-lived
+ * temporaries to be relinquished in a single pass at the end of a unit of
+ * work, rather than individually.
+ *
+ * Autorelease pools are strictly nested, and must be pushed and popped on the
+ * same thread.
+ */
+
+/**
+ * @brief The AutoreleasePool type, identifying a pool to be popped.
+ */
+typedef size_t AutoreleasePool;
+
+/**
+ * @brief Pushes a new autorelease pool for the calling thread.
+ *
+ * @return The AutoreleasePool, which must be passed to `AutoreleasePoolPop`.
+ */
+extern AutoreleasePool AutoreleasePoolPush(void);
+
+/**
+ * @brief Pops `pool`, releasing all Objects autoreleased since it was pushed.
+ *
+ * @param pool The AutoreleasePool returned by `AutoreleasePoolPush`.
+ *
+ * @remark Objects are released in the reverse order in which they were
+ * autoreleased. Any pools pushed after `pool` that are still open are popped
+ * with it.
+ */
+extern void AutoreleasePoolPop(AutoreleasePool pool);
+
+/**
+ * @brief Adds the given Object to the calling thread's innermost autorelease
+ * pool, so that it is released when that pool is popped.
+ *
+ * @return The Object.
+ *
+ * @remark The calling thread must have pushed an autorelease pool.
+ */
+extern id autorelease(id obj);
+
+/**
+ * @brief Executes `statements` within a new autorelease pool.
+ */
+#define WithAutoreleasePool(statements) { \
+	const AutoreleasePool _pool = AutoreleasePoolPush(); \
+		statements; \
+	AutoreleasePoolPop(_pool); \
+}
+
+#endif
@@ -23,6 +23,7 @@
 
 #include <assert.h>
 
+#include <Objectively/Arena.h>
 #include <Objectively/Boolean.h>
 #include <Objectively/Once.h>
 #include <Objectively/String.h>
@@ -60,7 +61,7 @@ static Boolean *no(void) {
 	static Once once;
 
 	DispatchOnce(once, {
-		_no = (Boolean *) $((Object *) alloc(Boolean), init);
+		WithoutArena(_no = immortalize($((Object *) alloc(Boolean), init)));
 		_no->bool = NO;
 	});
 
@@ -76,7 +77,7 @@ static Boolean *yes(void) {
 	static Once once;
 
 	DispatchOnce(once, {
-		_yes = (Boolean *) $((Object *) alloc(Boolean), init);
+		WithoutArena(_yes = immortalize($((Object *) alloc(Boolean), init)));
 		_yes->bool = YES;
 	});
 
@@ -86,37 +87,38 @@ static Boolean *yes(void) {
 #pragma mark - Class lifecycle
 
 /**
- * @see Class::initialize(Class *)
+ * @see Class::destroy(Class *)
  */
-static void initialize(Class *clazz) {
-
-	ObjectInterface *object = (ObjectInterface *) clazz->interface;
-
-	object->copy = copy;
-	object->description = description;
-
-	BooleanInterface *boolean = (BooleanInterface *) clazz->interface;
+static void destroy(Class *clazz) {
 
-	boolean->no = no;
-	boolean->yes = yes;
+	if (_no) {
+		$((Object *) _no, dealloc);
+	}
+	if (_yes) {
+		$((Object *) _yes, dealloc);
+	}
 }
 
 /**
- * @see Class::destroy(Class *)
+ * @brief The static BooleanInterface.
  */
-static void destroy(Class *clazz) {
-
-	release(_no);
-	release(_yes);
-}
+StaticInterface(static const BooleanInterface interface = {
+	.objectInterface = {
+		InheritObjectInterface,
+		.copy = copy,
+		.description = description,
+	},
+	.no = no,
+	.yes = yes,
+})
 
 Class _Boolean = {
 	.name = "Boolean",
 	.superclass = &_Object,
 	.instanceSize = sizeof(Boolean),
+	.interface = (id) &interface,
 	.interfaceOffset = offsetof(Boolean, interface),
 	.interfaceSize = sizeof(BooleanInterface),
-	.initialize = initialize,
 	.destroy = destroy,
 };
 
@@ -26,13 +26,567 @@
 #include <string.h>
 #include <unistd.h>
 
+#include <pthread.h>
+
+#include <Objectively/Arena.h>
 #include <Objectively/Class.h>
+#include <Objectively/Hash.h>
 #include <Objectively/Object.h>
+#include <Objectively/Profile.h>
+#include <Objectively/Reclaimer.h>
+
+/**
+ * @brief The maximum number of free instances retained, per Class, per thread.
+ */
+#define CLASS_CACHE_CAPACITY 64
+
+/**
+ * @brief The count of allocation counters in each page of Statistics.
+ */
+#define CLASS_STATISTICS_PAGE_SIZE 64
+
+/**
+ * @brief The maximum number of pages of Statistics.
+ */
+#define CLASS_STATISTICS_PAGES 64
+
+/**
+ * @brief The maximum number of queued Objects an Owner merges per allocation
+ * or release.
+ */
+#define OWNER_MERGE_BATCH 64
+
+/**
+ * @brief The interval, in allocations per thread, at which a Class' high
+ * water mark is sampled. This must be a power of two.
+ */
+#define CLASS_STATISTICS_SAMPLE_INTERVAL 1024
+
+/**
+ * @brief The shared reference count includes the owner's biased count.
+ */
+#define SHARED_MERGED 0x1
+
+/**
+ * @brief The Object is queued for its owner to merge its reference counts.
+ */
+#define SHARED_QUEUED 0x2
+
+/**
+ * @brief The Object was sampled by the allocation profiler.
+ */
+#define SHARED_SAMPLED 0x4
+
+/**
+ * @brief A single reference in the shared reference count.
+ */
+#define SHARED_ONE 0x8
+
+/**
+ * @return The signed reference count of the shared reference count `shared`.
+ */
+#define SHARED_COUNT(shared) ((shared) >> 3)
 
 size_t _pageSize;
 
+BOOL _mallocInstances;
+
+BOOL _biasedReferenceCounts;
+
 static Class *_classes;
 
+/**
+ * @brief The count of instance cache indexes issued to initialized Classes.
+ */
+static size_t _numCaches;
+
+/**
+ * @brief A per-thread, per-Class cache of free instances.
+ */
+typedef struct {
+
+	/**
+	 * @brief The free instances, chained through their first word.
+	 */
+	id instances;
+
+	/**
+	 * @brief The count of free instances.
+	 */
+	size_t count;
+} InstanceCache;
+
+/**
+ * @brief The calling thread's instance caches, indexed by `Class::locals::cache`.
+ */
+static __thread InstanceCache *_caches;
+
+/**
+ * @brief The length of the calling thread's `_caches`.
+ */
+static __thread size_t _cachesLength;
+
+/**
+ * @brief Ensures the calling thread's instance caches are freed when it exits.
+ */
+static pthread_key_t _cachesKey;
+
+/**
+ * @brief Frees the calling thread's instance caches.
+ */
+static void freeCaches(id data) {
+
+	for (size_t i = 0; i < _cachesLength; i++) {
+
+		id obj = _caches[i].instances;
+		while (obj) {
+			id next = *(id *) obj;
+			free(obj);
+			obj = next;
+		}
+	}
+
+	free(_caches);
+
+	_caches = NULL;
+	_cachesLength = 0;
+}
+
+/**
+ * @return The calling thread's instance cache for `clazz`.
+ */
+static InstanceCache *cacheForClass(const Class *clazz) {
+
+	if (clazz->locals.cache >= _cachesLength) {
+
+		const size_t length = _numCaches;
+		assert(length > clazz->locals.cache);
+
+		InstanceCache *caches = realloc(_caches, length * sizeof(InstanceCache));
+		assert(caches);
+
+		memset(caches + _cachesLength, 0, (length - _cachesLength) * sizeof(InstanceCache));
+
+		if (_caches == NULL) {
+			pthread_setspecific(_cachesKey, caches);
+		}
+
+		_caches = caches;
+		_cachesLength = length;
+	}
+
+	return &_caches[clazz->locals.cache];
+}
+
+/**
+ * @brief Per-thread, per-Class allocation counters.
+ */
+typedef struct {
+
+	/**
+	 * @brief The count of instances allocated.
+	 */
+	size_t allocations;
+
+	/**
+	 * @brief The count of instances deallocated.
+	 */
+	size_t deallocations;
+} Counters;
+
+/**
+ * @brief Per-thread allocation counters for all Classes, indexed by
+ * `Class::locals::cache`.
+ *
+ * @remark Counters are allocated in pages that are never moved, so that they
+ * may be read by other threads while the owning thread updates them.
+ */
+typedef struct Statistics {
+
+	/**
+	 * @brief The pages of Counters.
+	 */
+	Counters *pages[CLASS_STATISTICS_PAGES];
+
+	/**
+	 * @brief The next Statistics.
+	 */
+	struct Statistics *next;
+} Statistics;
+
+/**
+ * @brief The calling thread's Statistics.
+ */
+static __thread Statistics *_statistics;
+
+/**
+ * @brief The Statistics of all running threads.
+ */
+static Statistics *_threadStatistics;
+
+/**
+ * @brief The accumulated Statistics of all exited threads.
+ */
+static Statistics _retiredStatistics;
+
+/**
+ * @brief The lock guarding `_threadStatistics` and `_retiredStatistics`.
+ */
+static pthread_mutex_t _statisticsLock = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+ * @brief Ensures that each thread's Statistics are retired when it exits.
+ */
+static pthread_key_t _statisticsKey;
+
+/**
+ * @return The calling thread's Counters for `clazz`.
+ */
+static Counters *countersForClass(const Class *clazz) {
+
+	Statistics *statistics = _statistics;
+	if (statistics == NULL) {
+
+		statistics = calloc(1, sizeof(Statistics));
+		assert(statistics);
+
+		pthread_mutex_lock(&_statisticsLock);
+
+		statistics->next = _threadStatistics;
+		_threadStatistics = statistics;
+
+		pthread_mutex_unlock(&_statisticsLock);
+
+		pthread_setspecific(_statisticsKey, statistics);
+
+		_statistics = statistics;
+	}
+
+	const size_t page = clazz->locals.cache / CLASS_STATISTICS_PAGE_SIZE;
+	assert(page < CLASS_STATISTICS_PAGES);
+
+	Counters *counters = statistics->pages[page];
+	if (counters == NULL) {
+
+		counters = calloc(CLASS_STATISTICS_PAGE_SIZE, sizeof(Counters));
+		assert(counters);
+
+		__atomic_store_n(&statistics->pages[page], counters, __ATOMIC_RELEASE);
+	}
+
+	return &counters[clazz->locals.cache % CLASS_STATISTICS_PAGE_SIZE];
+}
+
+/**
+ * @brief Accumulates the Counters for `clazz` in `statistics` into `counters`.
+ */
+static void accumulateCounters(const Statistics *statistics, const Class *clazz, Counters *counters) {
+
+	const Counters *page = __atomic_load_n(&statistics->pages[clazz->locals.cache / CLASS_STATISTICS_PAGE_SIZE], __ATOMIC_ACQUIRE);
+	if (page) {
+		const Counters *c = &page[clazz->locals.cache % CLASS_STATISTICS_PAGE_SIZE];
+
+		counters->allocations += __atomic_load_n(&c->allocations, __ATOMIC_RELAXED);
+		counters->deallocations += __atomic_load_n(&c->deallocations, __ATOMIC_RELAXED);
+	}
+}
+
+/**
+ * @brief Sums the Counters of all threads for `clazz`, and updates its high
+ * water mark.
+ *
+ * @remark The caller must hold `_statisticsLock`.
+ */
+static Counters sumCounters(Class *clazz) {
+
+	Counters counters = { 0, 0 };
+
+	accumulateCounters(&_retiredStatistics, clazz, &counters);
+
+	for (const Statistics *s = _threadStatistics; s; s = s->next) {
+		accumulateCounters(s, clazz, &counters);
+	}
+
+	if (counters.allocations > counters.deallocations) {
+		const size_t instances = counters.allocations - counters.deallocations;
+
+		size_t highWaterMark = __atomic_load_n(&clazz->locals.highWaterMark, __ATOMIC_RELAXED);
+		while (instances > highWaterMark) {
+			if (__atomic_compare_exchange_n(&clazz->locals.highWaterMark, &highWaterMark, instances,
+					NO, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+				break;
+			}
+		}
+	}
+
+	return counters;
+}
+
+/**
+ * @brief Retires the given Statistics when its thread exits, accumulating its
+ * Counters into `_retiredStatistics`.
+ */
+static void retireStatistics(id data) {
+
+	Statistics *statistics = (Statistics *) data;
+
+	pthread_mutex_lock(&_statisticsLock);
+
+	Statistics **s = &_threadStatistics;
+	while (*s != statistics) {
+		s = &(*s)->next;
+	}
+	*s = statistics->next;
+
+	for (size_t i = 0; i < CLASS_STATISTICS_PAGES; i++) {
+
+		const Counters *page = statistics->pages[i];
+		if (page) {
+
+			if (_retiredStatistics.pages[i] == NULL) {
+				Counters *retired = calloc(CLASS_STATISTICS_PAGE_SIZE, sizeof(Counters));
+				assert(retired);
+
+				__atomic_store_n(&_retiredStatistics.pages[i], retired, __ATOMIC_RELEASE);
+			}
+
+			Counters *retired = _retiredStatistics.pages[i];
+			for (size_t j = 0; j < CLASS_STATISTICS_PAGE_SIZE; j++) {
+				retired[j].allocations += page[j].allocations;
+				retired[j].deallocations += page[j].deallocations;
+			}
+
+			free((Counters *) page);
+		}
+	}
+
+	pthread_mutex_unlock(&_statisticsLock);
+
+	free(statistics);
+
+	_statistics = NULL;
+}
+
+/**
+ * @brief Owners are the threads that allocate Objects. Threads releasing
+ * Objects they do not own queue those whose shared reference count falls
+ * below zero, so that the owner can merge its biased count with them.
+ *
+ * @remark An Owner is freed once its thread has finished and the reference
+ * counts of all of its Objects have been merged. Merged Objects only compare
+ * their Owner with the calling thread's, so they may outlive it.
+ */
+typedef struct {
+
+	/**
+	 * @brief The lock guarding `queue` and `isFinished`.
+	 */
+	pthread_mutex_t lock;
+
+	/**
+	 * @brief The Objects awaiting a merge of their reference counts.
+	 */
+	Object **queue;
+
+	/**
+	 * @brief The count of `queue`.
+	 */
+	size_t count;
+
+	/**
+	 * @brief The capacity of `queue`.
+	 */
+	size_t capacity;
+
+	/**
+	 * @brief `YES` once the owner thread has exited.
+	 */
+	BOOL isFinished;
+
+	/**
+	 * @brief The count of Objects whose reference counts are not yet merged,
+	 * plus one until the owner thread has finished.
+	 *
+	 * @remark Only the owner thread modifies this until it has finished.
+	 */
+	size_t references;
+} Owner;
+
+/**
+ * @brief The calling thread's Owner.
+ */
+static __thread Owner *_owner;
+
+/**
+ * @brief Ensures that each Owner is finished when its thread exits.
+ */
+static pthread_key_t _ownerKey;
+
+/**
+ * @return The calling thread's Owner.
+ */
+static Owner *currentOwner(void) {
+
+	if (_owner == NULL) {
+
+		Owner *owner = calloc(1, sizeof(Owner));
+		assert(owner);
+
+		const int err = pthread_mutex_init(&owner->lock, NULL);
+		assert(err == 0);
+
+		owner->references = 1;
+
+		pthread_setspecific(_ownerKey, owner);
+
+		_owner = owner;
+	}
+
+	return _owner;
+}
+
+/**
+ * @brief Releases a reference to the given Owner, freeing it if it was the last.
+ */
+static void releaseOwner(Owner *owner) {
+
+	if (owner == _owner) {
+		owner->references--;
+	} else if (__atomic_sub_fetch(&owner->references, 1, __ATOMIC_ACQ_REL) == 0) {
+
+		pthread_mutex_destroy(&owner->lock);
+
+		free(owner->queue);
+		free(owner);
+	}
+}
+
+/**
+ * @brief Merges the owner's biased reference count of `object` into its shared
+ * reference count, after which all threads retain and release it atomically.
+ * The Object is deallocated if its merged reference count is `0`.
+ *
+ * @param dequeue `YES` if `object` is being removed from its Owner's queue.
+ *
+ * @remark This must be called by the owner thread, or after it has finished.
+ */
+static void merge(Object *object, BOOL dequeue) {
+
+	Owner *owner = object->owner;
+
+	const int biased = (int) object->referenceCount;
+
+	__atomic_store_n(&object->referenceCount, 0, __ATOMIC_RELAXED);
+
+	int old, new;
+	do {
+		old = __atomic_load_n(&object->sharedReferenceCount, __ATOMIC_RELAXED);
+
+		new = (SHARED_COUNT(old) + biased) * SHARED_ONE | SHARED_MERGED | (old & SHARED_SAMPLED);
+		if (dequeue == NO) {
+			new |= (old & SHARED_QUEUED);
+		}
+
+	} while (__sync_bool_compare_and_swap(&object->sharedReferenceCount, old, new) == NO);
+
+	if ((old & SHARED_MERGED) == 0) {
+		releaseOwner(owner);
+	}
+
+	if (SHARED_COUNT(new) == 0 && (new & SHARED_QUEUED) == 0) {
+		$(object, dealloc);
+	}
+}
+
+/**
+ * @brief Merges up to `OWNER_MERGE_BATCH` of the Objects queued for the given
+ * Owner, so that the cost of deallocating them is spread across allocations
+ * and releases.
+ *
+ * @return The count of Objects remaining in the queue.
+ */
+static size_t mergeQueue(Owner *owner) {
+
+	Object *objects[OWNER_MERGE_BATCH];
+
+	pthread_mutex_lock(&owner->lock);
+
+	const size_t count = min(owner->count, (size_t) OWNER_MERGE_BATCH);
+
+	owner->count -= count;
+	if (count) {
+		memcpy(objects, owner->queue + owner->count, count * sizeof(Object *));
+	}
+
+	const size_t remaining = owner->count;
+
+	pthread_mutex_unlock(&owner->lock);
+
+	for (size_t i = 0; i < count; i++) {
+		merge(objects[i], YES);
+	}
+
+	return remaining;
+}
+
+/**
+ * @brief Queues `object` for its Owner to merge. If the Owner has finished,
+ * the Object is merged immediately.
+ */
+static void enqueue(Object *object) {
+
+	Owner *owner = object->owner;
+
+	pthread_mutex_lock(&owner->lock);
+
+	const BOOL isFinished = owner->isFinished;
+	if (isFinished == NO) {
+
+		if (owner->count == owner->capacity) {
+			owner->capacity = owner->capacity ? owner->capacity * 2 : 16;
+
+			owner->queue = realloc(owner->queue, owner->capacity * sizeof(Object *));
+			assert(owner->queue);
+		}
+
+		owner->queue[owner->count] = object;
+		__atomic_store_n(&owner->count, owner->count + 1, __ATOMIC_RELEASE);
+	}
+
+	pthread_mutex_unlock(&owner->lock);
+
+	if (isFinished) {
+		merge(object, YES);
+	}
+}
+
+/**
+ * @brief Finishes the given Owner when its thread exits, merging any Objects
+ * queued for it, and releases the thread's reference to it. Objects that this
+ * thread released thereafter are merged by the releasing thread.
+ */
+static void finishOwner(id data) {
+
+	Owner *owner = (Owner *) data;
+
+	pthread_mutex_lock(&owner->lock);
+	owner->isFinished = YES;
+	pthread_mutex_unlock(&owner->lock);
+
+	_owner = NULL;
+
+	while (mergeQueue(owner)) {
+		;
+	}
+
+	free(owner->queue);
+
+	owner->queue = NULL;
+	owner->capacity = 0;
+
+	releaseOwner(owner);
+}
+
 /**
  * @brief Called `atexit` to teardown Objectively.
  */
@@ -47,12 +601,22 @@ static void teardown(void) {
 		c = c->locals.next;
 	}
 
+	freeCaches(NULL);
+
 	c = _classes;
 	while (c) {
-		if (c->interface) {
+		if (c->interface && c->locals.isStatic == NO) {
 			free(c->interface);
 			c->interface = NULL;
 		}
+		if (c->locals.prototype) {
+			free(c->locals.prototype);
+			c->locals.prototype = NULL;
+		}
+		if (c->locals.ancestors) {
+			free(c->locals.ancestors);
+			c->locals.ancestors = NULL;
+		}
 		c->locals.magic = 0;
 		c = c->locals.next;
 	}
@@ -73,14 +637,80 @@ static void setup(void) {
 
 #endif
 
+	_mallocInstances = getenv("OBJECTIVELY_MALLOC") ? YES : NO;
+	_biasedReferenceCounts = getenv("OBJECTIVELY_UNBIASED") ? NO : YES;
+	_keyedHashing = getenv("OBJECTIVELY_KEYED_HASH") ? YES : NO;
+
+	const char *profile = getenv("OBJECTIVELY_PROFILE");
+	if (profile) {
+		_profileInterval = strtoul(profile, NULL, 10);
+	}
+
+	const char *reclaim = getenv("OBJECTIVELY_RECLAIM");
+	if (reclaim) {
+		_reclaimThreshold = strtoul(reclaim, NULL, 10);
+	}
+
+	int err = pthread_key_create(&_cachesKey, freeCaches);
+	assert(err == 0);
+
+	err = pthread_key_create(&_ownerKey, finishOwner);
+	assert(err == 0);
+
+	err = pthread_key_create(&_statisticsKey, retireStatistics);
+	assert(err == 0);
 
 	atexit(teardown);
 }
 
+/**
+ * @brief Populates the ancestry display of the given Class.
+ */
+static void ancestors(Class *clazz) {
+
+	const Class *super = clazz->superclass;
+
+	clazz->locals.depth = super ? super->locals.depth + 1 : 0;
+
+	clazz->locals.ancestors = calloc(clazz->locals.depth + 1, sizeof(Class *));
+	assert(clazz->locals.ancestors);
+
+	if (super) {
+		memcpy(clazz->locals.ancestors, super->locals.ancestors, clazz->locals.depth * sizeof(Class *));
+	}
+
+	clazz->locals.ancestors[clazz->locals.depth] = clazz;
+}
+
+/**
+ * @return A new prototype instance for the given Class.
+ */
+static id prototype(const Class *clazz) {
+
+	id obj = calloc(1, clazz->instanceSize);
+	assert(obj);
+
+	Object *object = (Object *) obj;
+
+	object->clazz = (Class *) clazz;
+	object->referenceCount = 1;
+
+	const Class *c = clazz;
+	do {
+		*(id *) (obj + c->interfaceOffset) = clazz->interface;
+	} while ((c = c->superclass));
+
+	return obj;
+}
+
 void _initialize(Class *clazz) {
 
 	assert(clazz);
 
+	if (__atomic_load_n(&clazz->locals.magic, __ATOMIC_ACQUIRE) == CLASS_MAGIC) {
+		return;
+	}
+
 	if (__sync_val_compare_and_swap(&clazz->locals.magic, 0, -1) == 0) {
 
 		assert(clazz->name);
@@ -88,8 +718,14 @@ void _initialize(Class *clazz) {
 		assert(clazz->interfaceSize);
 		assert(clazz->interfaceOffset);
 
-		clazz->interface = calloc(1, clazz->interfaceSize);
-		assert(clazz->interface);
+		clazz->locals.cache = __sync_fetch_and_add(&_numCaches, 1);
+
+		clazz->locals.isStatic = clazz->interface != NULL;
+
+		if (clazz->locals.isStatic == NO) {
+			clazz->interface = calloc(1, clazz->interfaceSize);
+			assert(clazz->interface);
+		}
 
 		Class *super = clazz->superclass;
 
@@ -103,16 +739,27 @@ void _initialize(Class *clazz) {
 
 			_initialize(super);
 
-			memcpy(clazz->interface, super->interface, super->interfaceSize);
+			if (clazz->locals.isStatic == NO) {
+				memcpy(clazz->interface, super->interface, super->interfaceSize);
+			}
+		}
+
+		if (clazz->initialize) {
+			WithoutArena(clazz->initialize(clazz));
 		}
 
-		clazz->initialize(clazz);
+		ancestors(clazz);
+
+		clazz->locals.prototype = prototype(clazz);
 
-		clazz->locals.next = __sync_lock_test_and_set(&_classes, clazz);
-		clazz->locals.magic = CLASS_MAGIC;
+		do {
+			clazz->locals.next = __atomic_load_n(&_classes, __ATOMIC_RELAXED);
+		} while (__sync_bool_compare_and_swap(&_classes, clazz->locals.next, clazz) == NO);
+
+		__atomic_store_n(&clazz->locals.magic, CLASS_MAGIC, __ATOMIC_RELEASE);
 
 	} else {
-		while (clazz->locals.magic != CLASS_MAGIC) {
+		while (__atomic_load_n(&clazz->locals.magic, __ATOMIC_ACQUIRE) != CLASS_MAGIC) {
 			;
 		}
 	}
@@ -122,18 +769,66 @@ id _alloc(Class *clazz) {
 
 	_initialize(clazz);
 
-	id obj = calloc(1, clazz->instanceSize);
-	assert(obj);
+	Counters *counters = countersForClass(clazz);
 
-	Object *object = (Object *) obj;
+	const size_t allocations = counters->allocations + 1;
+	__atomic_store_n(&counters->allocations, allocations, __ATOMIC_RELAXED);
 
-	object->clazz = clazz;
-	object->referenceCount = 1;
+	if ((allocations & (CLASS_STATISTICS_SAMPLE_INTERVAL - 1)) == 0) {
+		if (pthread_mutex_trylock(&_statisticsLock) == 0) {
+			sumCounters(clazz);
+			pthread_mutex_unlock(&_statisticsLock);
+		}
+	}
 
-	id interface = clazz->interface;
-	do {
-		*(id *) &obj[clazz->interfaceOffset] = interface;
-	} while ((clazz = clazz->superclass));
+	Arena *arena = _currentArena;
+	if (arena && (clazz->flags & CLASS_NO_ARENA) == 0) {
+
+		Object *object = memcpy(_arenaAlloc(arena, clazz), clazz->locals.prototype, clazz->instanceSize);
+
+		object->referenceCount = REFERENCE_COUNT_IMMORTAL;
+		object->owner = arena;
+
+		return object;
+	}
+
+	if (_owner && __atomic_load_n(&_owner->count, __ATOMIC_RELAXED)) {
+		mergeQueue(_owner);
+	}
+
+	id obj = NULL;
+
+	if (_mallocInstances == NO && (clazz->flags & CLASS_NO_CACHE) == 0) {
+
+		InstanceCache *cache = cacheForClass(clazz);
+		if (cache->instances) {
+
+			obj = cache->instances;
+			cache->instances = *(id *) obj;
+			cache->count--;
+		}
+	}
+
+	if (obj == NULL) {
+		obj = malloc(clazz->instanceSize);
+		assert(obj);
+	}
+
+	Object *object = memcpy(obj, clazz->locals.prototype, clazz->instanceSize);
+
+	if (_biasedReferenceCounts) {
+		object->owner = currentOwner();
+		_owner->references++;
+	} else {
+		object->referenceCount = 0;
+		object->sharedReferenceCount = SHARED_ONE | SHARED_MERGED;
+	}
+
+	if (_profileInterval) {
+		if (_profileAlloc(object)) {
+			object->sharedReferenceCount |= SHARED_SAMPLED;
+		}
+	}
 
 	return obj;
 }
@@ -142,44 +837,194 @@ id _cast(Class *clazz, const id obj) {
 
 	if (obj) {
 		const Class *c = ((Object *) obj)->clazz;
-		while (c) {
 
-			assert(c->locals.magic == CLASS_MAGIC);
+		assert(c->locals.magic == CLASS_MAGIC);
+		assert(_isSubclassOfClass(c, clazz));
+	}
 
-			// as a special case, we optimize for _Object
+	return (id) obj;
+}
 
-			if (c == clazz || clazz == &_Object) {
-				break;
-			}
+BOOL _isSubclassOfClass(const Class *clazz, const Class *superclass) {
+
+	const size_t depth = superclass->locals.depth;
+
+	return depth <= clazz->locals.depth && clazz->locals.ancestors[depth] == superclass;
+}
+
+void _dealloc(id obj) {
+
+	const Object *object = (Object *) obj;
+
+	if (object->referenceCount == REFERENCE_COUNT_IMMORTAL && object->owner) {
+		return;
+	}
+
+	Counters *counters = countersForClass(object->clazz);
+	__atomic_store_n(&counters->deallocations, counters->deallocations + 1, __ATOMIC_RELAXED);
+
+	if (object->sharedReferenceCount & SHARED_SAMPLED) {
+		_profileDealloc(obj);
+	}
+
+	const Class *clazz = object->clazz;
 
-			c = c->superclass;
+	if (_mallocInstances == NO && (clazz->flags & CLASS_NO_CACHE) == 0) {
+
+		InstanceCache *cache = cacheForClass(clazz);
+		if (cache->count < CLASS_CACHE_CAPACITY) {
+
+			*(id *) obj = cache->instances;
+			cache->instances = obj;
+			cache->count++;
+
+			return;
 		}
-		assert(c);
 	}
 
-	return (id) obj;
+	free(obj);
+}
+
+void _deallocArenaInstances(const Class *clazz, size_t count) {
+
+	Counters *counters = countersForClass(clazz);
+	__atomic_store_n(&counters->deallocations, counters->deallocations + count, __ATOMIC_RELAXED);
+}
+
+void enumerateClasses(ClassEnumerator enumerator, id data) {
+
+	assert(enumerator);
+
+	for (const Class *c = __atomic_load_n(&_classes, __ATOMIC_ACQUIRE); c; c = c->locals.next) {
+		if (__atomic_load_n(&c->locals.magic, __ATOMIC_ACQUIRE) == CLASS_MAGIC) {
+			enumerator(c, data);
+		}
+	}
+}
+
+ClassStatistics statisticsForClass(const Class *clazz) {
+
+	assert(clazz->locals.magic == CLASS_MAGIC);
+
+	pthread_mutex_lock(&_statisticsLock);
+
+	const Counters counters = sumCounters((Class *) clazz);
+
+	pthread_mutex_unlock(&_statisticsLock);
+
+	const size_t instances = counters.allocations > counters.deallocations ?
+		counters.allocations - counters.deallocations : 0;
+
+	return (ClassStatistics) {
+		.instances = instances,
+		.allocations = counters.allocations,
+		.instanceBytes = instances * clazz->instanceSize,
+		.highWaterMark = max(clazz->locals.highWaterMark, instances),
+	};
+}
+
+id immortalize(id obj) {
+
+	Object *object = cast(Object, obj);
+
+	assert(object);
+
+	if (object->referenceCount != REFERENCE_COUNT_IMMORTAL && (object->sharedReferenceCount & SHARED_MERGED) == 0) {
+		releaseOwner(object->owner);
+	}
+
+	object->referenceCount = REFERENCE_COUNT_IMMORTAL;
+	object->sharedReferenceCount = SHARED_ONE | SHARED_MERGED | (object->sharedReferenceCount & SHARED_SAMPLED);
+	object->owner = NULL;
+
+	return obj;
 }
 
 void release(id obj) {
 
 	if (obj) {
+#if defined(NDEBUG)
+		Object *object = (Object *) obj;
+#else
 		Object *object = cast(Object, obj);
+#endif
+
+		if (object->referenceCount == REFERENCE_COUNT_IMMORTAL) {
+			return;
+		}
+
+		if (object->owner == _owner && object->referenceCount) {
 
-		assert(object);
+			const unsigned referenceCount = object->referenceCount - 1;
+			__atomic_store_n(&object->referenceCount, referenceCount, __ATOMIC_RELAXED);
 
-		if (__sync_add_and_fetch(&object->referenceCount, -1) == 0) {
-			$(object, dealloc);
+			if (referenceCount == 0) {
+				merge(object, NO);
+			}
+
+			if (__atomic_load_n(&_owner->count, __ATOMIC_RELAXED)) {
+				mergeQueue(_owner);
+			}
+
+		} else {
+
+			int old, new;
+			do {
+				old = __atomic_load_n(&object->sharedReferenceCount, __ATOMIC_RELAXED);
+
+				new = old - SHARED_ONE;
+				if ((new & SHARED_MERGED) == 0 && SHARED_COUNT(new) < 0) {
+					new |= SHARED_QUEUED;
+				}
+
+			} while (__sync_bool_compare_and_swap(&object->sharedReferenceCount, old, new) == NO);
+
+			if (new & SHARED_MERGED) {
+				if (SHARED_COUNT(new) == 0 && (new & SHARED_QUEUED) == 0) {
+					$(object, dealloc);
+				}
+			} else if ((new & SHARED_QUEUED) && (old & SHARED_QUEUED) == 0) {
+				enqueue(object);
+			}
 		}
 	}
 }
 
 id retain(id obj) {
 
+#if defined(NDEBUG)
+	Object *object = (Object *) obj;
+#else
 	Object *object = cast(Object, obj);
+#endif
 
 	assert(object);
 
-	__sync_add_and_fetch(&object->referenceCount, 1);
+	if (object->referenceCount == REFERENCE_COUNT_IMMORTAL) {
+		return obj;
+	}
+
+	if (object->owner == _owner && object->referenceCount) {
+		__atomic_store_n(&object->referenceCount, object->referenceCount + 1, __ATOMIC_RELAXED);
+	} else {
+		__sync_add_and_fetch(&object->sharedReferenceCount, SHARED_ONE);
+	}
 
 	return obj;
 }
+
+unsigned retainCount(const id obj) {
+
+	const Object *object = cast(Object, obj);
+
+	assert(object);
+
+	const unsigned referenceCount = __atomic_load_n(&object->referenceCount, __ATOMIC_RELAXED);
+	if (referenceCount == REFERENCE_COUNT_IMMORTAL) {
+		return referenceCount;
+	}
+
+	const int shared = __atomic_load_n(&object->sharedReferenceCount, __ATOMIC_RELAXED);
+
+	return referenceCount + SHARED_COUNT(shared);
+}
@@ -43,6 +43,26 @@
  */
 #define CLASS_MAGIC 0xabcdef
 
+/**
+ * @brief Class flags.
+ */
+typedef enum {
+
+	/**
+	 * @brief Instances of this Class are allocated with `malloc`, initialized
+	 * from the Class prototype, and released with `free`, bypassing the
+	 * per-thread instance caches.
+	 */
+	CLASS_NO_CACHE = 0x1,
+
+	/**
+	 * @brief Instances of this Class are never allocated from the current
+	 * Arena. This is appropriate for shared constants and other instances
+	 * that may outlive the Arena that is current when they are created.
+	 */
+	CLASS_NO_ARENA = 0x2,
+} ClassFlags;
+
 typedef struct Class Class;
 
 /**
@@ -67,6 +87,45 @@ struct Class {
 		 */
 		Class *next;
 
+		/**
+		 * @brief The index of this Class' per-thread instance cache and
+		 * allocation counters.
+		 */
+		size_t cache;
+
+		/**
+		 * @brief The greatest count of live instances observed.
+		 */
+		size_t highWaterMark;
+
+		/**
+		 * @brief An immutable, fully initialized instance template.
+		 *
+		 * @remark New instances are copied from the prototype, which carries
+		 * the Class, reference count and interface pointers for each level of
+		 * the Class hierarchy.
+		 */
+		id prototype;
+
+		/**
+		 * @brief The depth of this Class in the hierarchy (`Object` is `0`).
+		 */
+		size_t depth;
+
+		/**
+		 * @brief The ancestry display of this Class, indexed by depth.
+		 *
+		 * @remark `ancestors[depth]` is this Class, and `ancestors[0]` is
+		 * `Object`. Any Class `c` is then a kind of `clazz` if and only if
+		 * `c->locals.ancestors[clazz->locals.depth] == clazz`.
+		 */
+		Class **ancestors;
+
+		/**
+		 * @brief `YES` if the interface was statically initialized.
+		 */
+		BOOL isStatic;
+
 	} locals;
 
 	/**
@@ -76,17 +135,24 @@ struct Class {
 	 */
 	void (*destroy)(Class *clazz);
 
+	/**
+	 * @brief The ClassFlags (optional).
+	 */
+	int flags;
+
 	/**
 	 * @brief The Class initializer (optional).
 	 *
 	 * This method is run when your class is first initialized.
 	 *
-	 * If your Class defines an interface, you *must* implement this method
-	 * and initialize that interface here.
+	 * If your Class defines a dynamic interface, you *must* implement this
+	 * method and initialize that interface here.
 	 *
 	 * @remark The `interface` property of the Class is copied from the
 	 * superclass before this method is called. Method overrides are achieved
 	 * by simply overwriting the function pointers here.
+	 *
+	 * @remark Classes with a static interface must not modify it here.
 	 */
 	void (*initialize)(Class *clazz);
 
@@ -96,7 +162,13 @@ struct Class {
 	const size_t instanceSize;
 
 	/**
-	 * @brief The interface handle (do *not* provide).
+	 * @brief The interface handle (optional).
+	 *
+	 * Provide this only to declare a static interface: a statically
+	 * initialized table of every method, including those inherited from the
+	 * superclass, e.g. through `InheritObjectInterface`. Classes with a
+	 * static interface require no `initialize`, and their interface is
+	 * neither allocated nor copied at runtime.
 	 */
 	id interface;
 
@@ -121,6 +193,64 @@ struct Class {
 	Class *superclass;
 };
 
+/**
+ * @brief A snapshot of the allocation statistics of a Class.
+ */
+typedef struct {
+
+	/**
+	 * @brief The count of live instances.
+	 */
+	size_t instances;
+
+	/**
+	 * @brief The count of instances ever allocated.
+	 */
+	size_t allocations;
+
+	/**
+	 * @brief The bytes of live instances themselves, i.e.
+	 * `instances * instanceSize`.
+	 *
+	 * @remark This excludes the buffers that instances own, such as the
+	 * storage of collections, and so is not the heap usage of the Class.
+	 */
+	size_t instanceBytes;
+
+	/**
+	 * @brief The greatest count of live instances observed.
+	 *
+	 * @remark This is sampled periodically as instances are allocated, and so
+	 * is approximate.
+	 */
+	size_t highWaterMark;
+} ClassStatistics;
+
+/**
+ * @brief The ClassEnumerator function type.
+ *
+ * @param clazz The Class for the current iteration.
+ * @param data User data.
+ */
+typedef void (*ClassEnumerator)(const Class *clazz, id data);
+
+/**
+ * @brief Enumerates all initialized Classes.
+ *
+ * @param enumerator The ClassEnumerator.
+ * @param data User data.
+ */
+extern void enumerateClasses(ClassEnumerator enumerator, id data);
+
+/**
+ * @return The allocation statistics of the given Class.
+ *
+ * @remark Allocations and deallocations are counted per thread, without
+ * atomic operations, and summed here. Instances that are allocated on one
+ * thread and deallocated on another are accounted for correctly.
+ */
+extern ClassStatistics statisticsForClass(const Class *clazz);
+
 /**
  * @brief Initializes the given Class.
  */
@@ -137,13 +267,61 @@ extern id _alloc(Class *clazz);
 extern id _cast(Class *clazz, const id obj);
 
 /**
- * @brief Atomically decrement the given Object's reference count. If the
- * resulting reference count is `0`, the Object is deallocated.
+ * @return `YES` if `clazz` is, or descends from, `superclass`.
+ *
+ * @remark This is a bounds check and a single comparison against the
+ * ancestry display of `clazz`, which must be initialized.
+ */
+extern BOOL _isSubclassOfClass(const Class *clazz, const Class *superclass);
+
+/**
+ * @brief Frees an instance that was allocated with `_alloc`.
+ *
+ * @remark Unless the Class of `obj` specifies `CLASS_NO_CACHE`, the instance
+ * is returned to the calling thread's instance cache for its Class. Instances
+ * allocated from an Arena are freed with the Arena, which counts them as
+ * deallocated with `_deallocArenaInstances`.
+ */
+extern void _dealloc(id obj);
+
+/**
+ * @brief Counts `count` instances of the given Class, allocated from an Arena
+ * that is being deallocated, as deallocated.
+ */
+extern void _deallocArenaInstances(const Class *clazz, size_t count);
+
+/**
+ * @brief The reference count of immortal Objects.
+ */
+#define REFERENCE_COUNT_IMMORTAL ((unsigned) -1)
+
+/**
+ * @brief Makes the given Object immortal, so that `retain` and `release` have
+ * no effect on it.
+ *
+ * @return The Object.
+ *
+ * @remark This is intended for shared constants, such as `Null` and `Boolean`,
+ * which are retained and released by every thread. Immortal Objects are never
+ * deallocated by `release`; their Class should `dealloc` them in `destroy`.
+ * Immortalize an Object on the thread that allocated it, before sharing it.
+ */
+extern id immortalize(id obj);
+
+/**
+ * @brief Decrement the given Object's reference count. If the resulting
+ * reference count is `0`, the Object is deallocated.
+ *
+ * @remark Only threads other than the Object's owner use atomic operations.
+ * Objects they release are queued for the owner, which merges them as it
+ * allocates and releases Objects, or when it exits.
  */
 extern void release(id obj);
 
 /**
- * @brief Atomically increment the given Object's reference count.
+ * @brief Increment the given Object's reference count.
+ *
+ * @remark Only threads other than the Object's owner use atomic operations.
  *
  * @return The Object.
  *
@@ -153,11 +331,42 @@ extern void release(id obj);
  */
 extern id retain(id obj);
 
+/**
+ * @return The given Object's reference count, the sum of its owner's biased
+ * count and its shared count, or `REFERENCE_COUNT_IMMORTAL`.
+ *
+ * @remark This is intended for debugging and tests. The count is a snapshot,
+ * which other threads may change at any time.
+ */
+extern unsigned retainCount(const id obj);
+
 /**
  * @brief The page size, in bytes, of the target host.
  */
 extern size_t _pageSize;
 
+/**
+ * @brief If `YES`, all instances are allocated with `malloc`, initialized from
+ * their Class prototype, and released with `free`, bypassing the per-thread
+ * instance caches. This is useful when
+ * debugging with tools such as Valgrind.
+ *
+ * @remark This is enabled at startup if `OBJECTIVELY_MALLOC` is set in the
+ * environment. It may be toggled at any time.
+ */
+extern BOOL _mallocInstances;
+
+/**
+ * @brief If `YES` (the default), the reference counts of newly allocated
+ * instances are biased towards the allocating thread, which may then retain
+ * and release them without atomic operations.
+ *
+ * @remark This is disabled at startup if `OBJECTIVELY_UNBIASED` is set in the
+ * environment. It may be toggled at any time, and affects only instances
+ * allocated afterwards.
+ */
+extern BOOL _biasedReferenceCounts;
+
 /**
  * @brief Allocate a type.
  */
@@ -201,10 +410,15 @@ extern size_t _pageSize;
 
 /**
  * @brief Invoke a Class method.
+ *
+ * @remark Once the Class is initialized, this costs a single (acquire) load of
+ * its magic. Only uninitialized Classes take the slower `_initialize` path.
  */
 #define $$(type, method, ...) \
 	({ \
-		_initialize(&_##type); \
+		if (__builtin_expect(__atomic_load_n(&_##type.locals.magic, __ATOMIC_ACQUIRE) != CLASS_MAGIC, 0)) { \
+			_initialize(&_##type); \
+		} \
 		interfaceof(type, &_##type)->method(__VA_ARGS__); \
 	})
 
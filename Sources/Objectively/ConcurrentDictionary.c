@@ -0,0 +1,892 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <assert.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <Objectively/ConcurrentDictionary.h>
+#include <Objectively/Hash.h>
+#include <Objectively/Lock.h>
+#include <Objectively/MutableDictionary.h>
+#include <Objectively/Once.h>
+
+#define _Class _ConcurrentDictionary
+
+/**
+ * @brief The minimum capacity of each shard's table.
+ */
+#define CONCURRENTDICTIONARY_MIN_CAPACITY 8
+
+/**
+ * @brief The count of buckets that each write migrates while a shard grows.
+ */
+#define CONCURRENTDICTIONARY_MIGRATION 8
+
+/**
+ * @brief The count of retired allocations between a shard's attempts to
+ * advance the epoch while Readers are reading.
+ */
+#define CONCURRENTDICTIONARY_RECLAIM 64
+
+#pragma mark - Epochs
+
+typedef struct Reader Reader;
+
+/**
+ * @brief A thread that may read ConcurrentDictionaries.
+ */
+struct Reader {
+
+	/**
+	 * @brief The next Reader.
+	 */
+	Reader *next;
+
+	/**
+	 * @brief The epoch in which this Reader is reading, or `0` if it is not.
+	 */
+	size_t epoch;
+
+	/**
+	 * @brief The nesting depth of this Reader's critical sections.
+	 */
+	size_t depth;
+
+	/**
+	 * @brief Nonzero while this Reader belongs to a thread.
+	 */
+	int inUse;
+};
+
+/**
+ * @brief The global epoch, which advances once every active Reader has observed it.
+ */
+static size_t _epoch = 1;
+
+/**
+ * @brief All Readers. Readers are reused by new threads, and never freed.
+ */
+static Reader *_readers;
+
+/**
+ * @brief The calling thread's Reader.
+ */
+static __thread Reader *_reader;
+
+/**
+ * @brief Ensures the calling thread's Reader is returned when it exits.
+ */
+static pthread_key_t _readerKey;
+
+/**
+ * @brief Returns the exiting thread's Reader to the pool.
+ */
+static void returnReader(id data) {
+
+	Reader *reader = (Reader *) data;
+
+	__atomic_store_n(&reader->epoch, 0, __ATOMIC_RELEASE);
+	__atomic_store_n(&reader->inUse, 0, __ATOMIC_RELEASE);
+}
+
+/**
+ * @return The calling thread's Reader.
+ */
+static Reader *readerForThread(void) {
+	static Once once;
+
+	if (_reader == NULL) {
+
+		DispatchOnce(once, {
+			const int err = pthread_key_create(&_readerKey, returnReader);
+			assert(err == 0);
+		});
+
+		for (Reader *r = __atomic_load_n(&_readers, __ATOMIC_ACQUIRE); r; r = r->next) {
+			if (__sync_bool_compare_and_swap(&r->inUse, 0, 1)) {
+				_reader = r;
+				break;
+			}
+		}
+
+		if (_reader == NULL) {
+			_reader = calloc(1, sizeof(Reader));
+			assert(_reader);
+
+			_reader->inUse = 1;
+
+			do {
+				_reader->next = __atomic_load_n(&_readers, __ATOMIC_RELAXED);
+			} while (__sync_bool_compare_and_swap(&_readers, _reader->next, _reader) == NO);
+		}
+
+		pthread_setspecific(_readerKey, _reader);
+	}
+
+	return _reader;
+}
+
+/**
+ * @brief Enters a read-side critical section, within which no entry that the
+ * calling thread may observe is reclaimed.
+ *
+ * @return The calling thread's Reader.
+ */
+static Reader *enterEpoch(void) {
+
+	Reader *reader = readerForThread();
+
+	if (reader->depth++ == 0) {
+		__atomic_store_n(&reader->epoch, __atomic_load_n(&_epoch, __ATOMIC_ACQUIRE), __ATOMIC_RELAXED);
+		__atomic_thread_fence(__ATOMIC_SEQ_CST);
+	}
+
+	return reader;
+}
+
+/**
+ * @brief Leaves a read-side critical section.
+ */
+static void leaveEpoch(Reader *reader) {
+
+	if (--reader->depth == 0) {
+		__atomic_store_n(&reader->epoch, 0, __ATOMIC_RELEASE);
+	}
+}
+
+/**
+ * @brief Advances the global epoch, if every active Reader has observed it
+ * and at least one Reader is reading.
+ *
+ * @param quiescent Set to `YES` if no Reader is reading, in which case nothing
+ * retired before this call may be observed.
+ *
+ * @return The global epoch.
+ */
+static size_t advance(BOOL *quiescent) {
+
+	const size_t epoch = __atomic_load_n(&_epoch, __ATOMIC_ACQUIRE);
+
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+	*quiescent = YES;
+
+	for (const Reader *r = __atomic_load_n(&_readers, __ATOMIC_ACQUIRE); r; r = r->next) {
+
+		const size_t e = __atomic_load_n(&r->epoch, __ATOMIC_ACQUIRE);
+		if (e) {
+			*quiescent = NO;
+			if (e != epoch) {
+				return epoch;
+			}
+		}
+	}
+
+	if (*quiescent) {
+		return epoch;
+	}
+
+	__sync_bool_compare_and_swap(&_epoch, epoch, epoch + 1);
+
+	return __atomic_load_n(&_epoch, __ATOMIC_ACQUIRE);
+}
+
+#pragma mark - Shards
+
+typedef struct Node Node;
+
+/**
+ * @brief A key-value pair. Only `obj` and `next` change once a Node is published.
+ */
+struct Node {
+	Node *next;
+	uint64_t hash;
+	id key;
+	id obj;
+};
+
+/**
+ * @brief Marks a bucket whose Nodes were migrated to the next Table.
+ */
+#define MOVED ((Node *) 1)
+
+typedef struct Table Table;
+
+/**
+ * @brief A chained hash table.
+ */
+struct Table {
+
+	/**
+	 * @brief The Table being migrated to, or `NULL`.
+	 */
+	Table *next;
+
+	/**
+	 * @brief The count of buckets, a power of two.
+	 */
+	size_t capacity;
+
+	/**
+	 * @brief The next bucket to migrate, and the count of buckets migrated.
+	 */
+	size_t cursor, migrated;
+
+	/**
+	 * @brief The buckets.
+	 */
+	Node *buckets[];
+};
+
+typedef struct Retired Retired;
+
+/**
+ * @brief An allocation that is reclaimed once no Reader may observe it.
+ */
+struct Retired {
+	Retired *next;
+	size_t epoch;
+	void (*reclaim)(id ptr);
+	id ptr;
+};
+
+/**
+ * @brief A shard, whose writes are serialized by its Lock.
+ */
+typedef struct {
+
+	/**
+	 * @brief The Lock.
+	 */
+	Lock *lock;
+
+	/**
+	 * @brief The Table.
+	 */
+	Table *table;
+
+	/**
+	 * @brief The count of pairs.
+	 */
+	size_t count;
+
+	/**
+	 * @brief The retired allocations, and their count.
+	 */
+	Retired *retired;
+	size_t retiredCount;
+
+	/**
+	 * @brief The epoch of the last reclamation.
+	 */
+	size_t epoch;
+
+	/**
+	 * @brief The count of retired allocations at which to next advance the epoch.
+	 */
+	size_t threshold;
+
+} __attribute__((aligned(64))) Shard;
+
+/**
+ * @return A new Table with `capacity` empty buckets.
+ */
+static Table *allocateTable(size_t capacity) {
+
+	Table *table = calloc(1, sizeof(Table) + capacity * sizeof(Node *));
+	assert(table);
+
+	table->capacity = capacity;
+
+	return table;
+}
+
+/**
+ * @brief Reclaims a Node and releases its pair.
+ */
+static void reclaimNode(id ptr) {
+
+	Node *node = (Node *) ptr;
+
+	release(node->key);
+	release(node->obj);
+
+	free(node);
+}
+
+/**
+ * @brief Reclaims the retired allocations of `shard` that no Reader may
+ * observe, or all of them if `all`. The caller must hold the shard's Lock.
+ *
+ * @remark The shard attempts to advance the epoch upon its first retirement,
+ * which is reclaimed at once if no Reader is reading, and then once every
+ * `CONCURRENTDICTIONARY_RECLAIM` retirements. Otherwise, it reclaims only when
+ * other shards have advanced the epoch, so that writes do not contend on it.
+ */
+static void reclaim(Shard *shard, BOOL all) {
+
+	if (shard->retired == NULL) {
+		return;
+	}
+
+	size_t epoch = __atomic_load_n(&_epoch, __ATOMIC_ACQUIRE);
+
+	if (all == NO) {
+
+		if (shard->retiredCount >= shard->threshold) {
+			shard->threshold = shard->retiredCount + CONCURRENTDICTIONARY_RECLAIM;
+			epoch = advance(&all);
+		} else if (epoch == shard->epoch) {
+			return;
+		}
+
+		shard->epoch = epoch;
+	}
+
+	Retired **r = &shard->retired;
+	while (*r) {
+
+		Retired *retired = *r;
+		if (all || retired->epoch + 2 <= epoch) {
+			*r = retired->next;
+
+			retired->reclaim(retired->ptr);
+			free(retired);
+
+			shard->retiredCount--;
+		} else {
+			r = &retired->next;
+		}
+	}
+
+	if (shard->retired == NULL) {
+		shard->threshold = 0;
+	}
+}
+
+/**
+ * @brief Retires `ptr`, which has been unlinked from `shard`, to be reclaimed
+ * with `reclaimer` once no Reader may observe it.
+ */
+static void retire(Shard *shard, void (*reclaimer)(id), id ptr) {
+
+	Retired *retired = malloc(sizeof(Retired));
+	assert(retired);
+
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+	retired->epoch = __atomic_load_n(&_epoch, __ATOMIC_ACQUIRE);
+	retired->reclaim = reclaimer;
+	retired->ptr = ptr;
+
+	retired->next = shard->retired;
+	shard->retired = retired;
+
+	shard->retiredCount++;
+}
+
+/**
+ * @return The hash of `key`.
+ */
+static inline uint64_t hashForKey(const ConcurrentDictionary *self, const id key) {
+	return HashForObjectWithKey(self->hashKey, key);
+}
+
+/**
+ * @return The Shard of `hash`.
+ */
+static inline Shard *shardForHash(const ConcurrentDictionary *self, const uint64_t hash) {
+	return (Shard *) self->shards + ((hash >> 32) & (CONCURRENTDICTIONARY_SHARDS - 1));
+}
+
+/**
+ * @brief Finds the Node for `key` in `shard`, without locking. The caller must
+ * be within a read-side critical section.
+ *
+ * @return The Node, or `NULL`.
+ */
+static const Node *find(const Shard *shard, const uint64_t hash, const id key) {
+
+	const Table *table = __atomic_load_n(&shard->table, __ATOMIC_ACQUIRE);
+
+	while (YES) {
+
+		const Node *node = __atomic_load_n(&table->buckets[hash & (table->capacity - 1)], __ATOMIC_ACQUIRE);
+		if (node == MOVED) {
+			table = __atomic_load_n(&table->next, __ATOMIC_ACQUIRE);
+			continue;
+		}
+
+		while (node) {
+			if (node->hash == hash) {
+				if (node->key == key || $((Object *) node->key, isEqual, key)) {
+					return node;
+				}
+			}
+			node = __atomic_load_n(&node->next, __ATOMIC_ACQUIRE);
+		}
+
+		return NULL;
+	}
+}
+
+/**
+ * @brief Migrates `bucket` of `table` to the next Table. The Nodes are copied,
+ * so that Readers traversing the bucket are undisturbed.
+ *
+ * @return YES if this completed the migration, and `table` was retired.
+ */
+static BOOL migrate(Shard *shard, Table *table, size_t bucket) {
+
+	Node *node = table->buckets[bucket];
+	if (node == MOVED) {
+		return NO;
+	}
+
+	Table *next = table->next;
+	const size_t mask = next->capacity - 1;
+
+	for (const Node *n = node; n; n = n->next) {
+
+		Node *copy = malloc(sizeof(Node));
+		assert(copy);
+
+		*copy = *n;
+
+		Node **head = &next->buckets[copy->hash & mask];
+
+		copy->next = *head;
+		__atomic_store_n(head, copy, __ATOMIC_RELEASE);
+	}
+
+	__atomic_store_n(&table->buckets[bucket], MOVED, __ATOMIC_RELEASE);
+
+	while (node) {
+		Node *n = node->next;
+		retire(shard, free, node);
+		node = n;
+	}
+
+	if (++table->migrated == table->capacity) {
+		__atomic_store_n(&shard->table, next, __ATOMIC_RELEASE);
+		retire(shard, free, table);
+		return YES;
+	}
+
+	return NO;
+}
+
+/**
+ * @brief Advances the migration of `shard`, if it is growing, always migrating
+ * the bucket of `hash`.
+ *
+ * @return The Table to which writes of `hash` must be made.
+ */
+static Table *tableForWriting(Shard *shard, const uint64_t hash) {
+
+	Table *table = shard->table;
+
+	if (table->next) {
+
+		Table *next = table->next;
+
+		BOOL migrated = migrate(shard, table, hash & (table->capacity - 1));
+		for (int i = 0; i < CONCURRENTDICTIONARY_MIGRATION && migrated == NO; i++) {
+			migrated = migrate(shard, table, table->cursor++);
+		}
+
+		return next;
+	}
+
+	return table;
+}
+
+/**
+ * @brief Begins growing `shard` once it exceeds its load.
+ */
+static void grow(Shard *shard) {
+
+	Table *table = shard->table;
+
+	if (table->next == NULL && shard->count > table->capacity) {
+		__atomic_store_n(&table->next, allocateTable(table->capacity << 1), __ATOMIC_RELEASE);
+	}
+}
+
+/**
+ * @return The link to the Node for `key` in `table`, or to its terminating `NULL`.
+ */
+static Node **linkForKey(Table *table, const uint64_t hash, const id key) {
+
+	Node **link = &table->buckets[hash & (table->capacity - 1)];
+
+	for (; *link; link = &(*link)->next) {
+		if ((*link)->hash == hash) {
+			if ((*link)->key == key || $((Object *) (*link)->key, isEqual, key)) {
+				break;
+			}
+		}
+	}
+
+	return link;
+}
+
+/**
+ * @brief Retires all Tables and Nodes of `table`.
+ */
+static void retireTable(Shard *shard, Table *table) {
+
+	while (table) {
+
+		for (size_t i = 0; i < table->capacity; i++) {
+
+			Node *node = table->buckets[i];
+			if (node == MOVED) {
+				continue;
+			}
+
+			while (node) {
+				Node *next = node->next;
+				retire(shard, reclaimNode, node);
+				node = next;
+			}
+		}
+
+		Table *next = table->next;
+		retire(shard, free, table);
+		table = next;
+	}
+}
+
+#pragma mark - ObjectInterface
+
+/**
+ * @see ObjectInterface::dealloc(Object *)
+ */
+static void dealloc(Object *self) {
+
+	ConcurrentDictionary *this = (ConcurrentDictionary *) self;
+
+	for (size_t i = 0; i < CONCURRENTDICTIONARY_SHARDS; i++) {
+
+		Shard *shard = (Shard *) this->shards + i;
+
+		retireTable(shard, shard->table);
+		reclaim(shard, YES);
+
+		release(shard->lock);
+	}
+
+	free(this->shards);
+
+	super(Object, self, dealloc);
+}
+
+#pragma mark - ConcurrentDictionaryInterface
+
+/**
+ * @see ConcurrentDictionaryInterface::count(const ConcurrentDictionary *)
+ */
+static size_t count(const ConcurrentDictionary *self) {
+
+	size_t count = 0;
+
+	for (size_t i = 0; i < CONCURRENTDICTIONARY_SHARDS; i++) {
+		count += __atomic_load_n(&((Shard *) self->shards)[i].count, __ATOMIC_RELAXED);
+	}
+
+	return count;
+}
+
+/**
+ * @see ConcurrentDictionaryInterface::enter(const ConcurrentDictionary *)
+ */
+static void enter(const ConcurrentDictionary *self) {
+
+	enterEpoch();
+}
+
+/**
+ * @see ConcurrentDictionaryInterface::init(ConcurrentDictionary *)
+ */
+static ConcurrentDictionary *init(ConcurrentDictionary *self) {
+
+	return $(self, initWithCapacity, 0);
+}
+
+/**
+ * @see ConcurrentDictionaryInterface::initWithCapacity(ConcurrentDictionary *, size_t)
+ */
+static ConcurrentDictionary *initWithCapacity(ConcurrentDictionary *self, size_t capacity) {
+
+	self = (ConcurrentDictionary *) super(Object, self, init);
+	if (self) {
+
+		self->hashKey = HashKeyDefault();
+
+		size_t shardCapacity = CONCURRENTDICTIONARY_MIN_CAPACITY;
+		while (shardCapacity * CONCURRENTDICTIONARY_SHARDS < capacity) {
+			shardCapacity <<= 1;
+		}
+
+		Shard *shards = NULL;
+
+		const int err = posix_memalign((void **) &shards, sizeof(Shard), CONCURRENTDICTIONARY_SHARDS * sizeof(Shard));
+		assert(err == 0);
+
+		memset(shards, 0, CONCURRENTDICTIONARY_SHARDS * sizeof(Shard));
+
+		for (size_t i = 0; i < CONCURRENTDICTIONARY_SHARDS; i++) {
+			shards[i].lock = $(alloc(Lock), init);
+			shards[i].table = allocateTable(shardCapacity);
+		}
+
+		self->shards = shards;
+	}
+
+	return self;
+}
+
+/**
+ * @see ConcurrentDictionaryInterface::leave(const ConcurrentDictionary *)
+ */
+static void leave(const ConcurrentDictionary *self) {
+
+	Reader *reader = _reader;
+
+	assert(reader);
+	assert(reader->depth);
+
+	leaveEpoch(reader);
+}
+
+/**
+ * @see ConcurrentDictionaryInterface::objectForKey(const ConcurrentDictionary *, const id)
+ */
+static id objectForKey(const ConcurrentDictionary *self, const id key) {
+
+	const uint64_t hash = hashForKey(self, key);
+
+	id obj = NULL;
+
+	Reader *reader = enterEpoch();
+
+	const Node *node = find(shardForHash(self, hash), hash, key);
+	if (node) {
+		obj = retain(__atomic_load_n(&node->obj, __ATOMIC_ACQUIRE));
+	}
+
+	leaveEpoch(reader);
+
+	return obj;
+}
+
+/**
+ * @see ConcurrentDictionaryInterface::removeAllObjects(ConcurrentDictionary *)
+ */
+static void removeAllObjects(ConcurrentDictionary *self) {
+
+	for (size_t i = 0; i < CONCURRENTDICTIONARY_SHARDS; i++) {
+
+		Shard *shard = (Shard *) self->shards + i;
+
+		WithLock(shard->lock, {
+
+			Table *table = shard->table;
+
+			__atomic_store_n(&shard->table, allocateTable(CONCURRENTDICTIONARY_MIN_CAPACITY), __ATOMIC_RELEASE);
+			__atomic_store_n(&shard->count, 0, __ATOMIC_RELAXED);
+
+			retireTable(shard, table);
+			reclaim(shard, NO);
+		});
+	}
+}
+
+/**
+ * @see ConcurrentDictionaryInterface::removeObjectForKey(ConcurrentDictionary *, const id)
+ */
+static void removeObjectForKey(ConcurrentDictionary *self, const id key) {
+
+	const uint64_t hash = hashForKey(self, key);
+
+	Shard *shard = shardForHash(self, hash);
+
+	WithLock(shard->lock, {
+
+		Node **link = linkForKey(tableForWriting(shard, hash), hash, key);
+
+		Node *node = *link;
+		if (node) {
+			__atomic_store_n(link, node->next, __ATOMIC_RELEASE);
+			__atomic_store_n(&shard->count, shard->count - 1, __ATOMIC_RELAXED);
+
+			retire(shard, reclaimNode, node);
+		}
+
+		reclaim(shard, NO);
+	});
+}
+
+/**
+ * @see ConcurrentDictionaryInterface::setObjectForKey(ConcurrentDictionary *, const id, const id)
+ */
+static void setObjectForKey(ConcurrentDictionary *self, const id obj, const id key) {
+
+	assert(obj);
+	assert(key);
+
+	const uint64_t hash = hashForKey(self, key);
+
+	Shard *shard = shardForHash(self, hash);
+
+	WithLock(shard->lock, {
+
+		Table *table = tableForWriting(shard, hash);
+
+		Node **link = linkForKey(table, hash, key);
+
+		Node *node = *link;
+		if (node) {
+			id old = node->obj;
+			if (old != obj) {
+				__atomic_store_n(&node->obj, retain(obj), __ATOMIC_RELEASE);
+				retire(shard, release, old);
+			}
+		} else {
+			node = malloc(sizeof(Node));
+			assert(node);
+
+			node->hash = hash;
+			node->key = retain(key);
+			node->obj = retain(obj);
+
+			Node **head = &table->buckets[hash & (table->capacity - 1)];
+
+			node->next = *head;
+			__atomic_store_n(head, node, __ATOMIC_RELEASE);
+
+			__atomic_store_n(&shard->count, shard->count + 1, __ATOMIC_RELAXED);
+
+			grow(shard);
+		}
+
+		reclaim(shard, NO);
+	});
+}
+
+/**
+ * @see ConcurrentDictionaryInterface::snapshot(const ConcurrentDictionary *)
+ */
+static Dictionary *snapshot(const ConcurrentDictionary *self) {
+
+	const size_t capacity = $(self, count);
+
+	MutableDictionary *dictionary = $(alloc(MutableDictionary), initWithCapacityAndHashKey, capacity, self->hashKey);
+
+	enter(self);
+
+	for (size_t i = 0; i < CONCURRENTDICTIONARY_SHARDS; i++) {
+
+		const Shard *shard = (Shard *) self->shards + i;
+
+		const Table *table = __atomic_load_n(&shard->table, __ATOMIC_ACQUIRE);
+		while (table) {
+
+			for (size_t j = 0; j < table->capacity; j++) {
+
+				const Node *node = __atomic_load_n(&table->buckets[j], __ATOMIC_ACQUIRE);
+				if (node == MOVED) {
+					continue;
+				}
+
+				while (node) {
+					$(dictionary, setObjectForKey, __atomic_load_n(&node->obj, __ATOMIC_ACQUIRE), node->key);
+					node = __atomic_load_n(&node->next, __ATOMIC_ACQUIRE);
+				}
+			}
+
+			table = __atomic_load_n(&table->next, __ATOMIC_ACQUIRE);
+		}
+	}
+
+	leave(self);
+
+	return (Dictionary *) dictionary;
+}
+
+/**
+ * @see ConcurrentDictionaryInterface::unretainedObjectForKey(const ConcurrentDictionary *, const id)
+ */
+static id unretainedObjectForKey(const ConcurrentDictionary *self, const id key) {
+
+	assert(_reader);
+	assert(_reader->depth);
+
+	const uint64_t hash = hashForKey(self, key);
+
+	const Node *node = find(shardForHash(self, hash), hash, key);
+	if (node) {
+		return __atomic_load_n(&node->obj, __ATOMIC_ACQUIRE);
+	}
+
+	return NULL;
+}
+
+#pragma mark - Class lifecycle
+
+/**
+ * @see Class::initialize(Class *)
+ */
+static void initialize(Class *clazz) {
+
+	((ObjectInterface *) clazz->interface)->dealloc = dealloc;
+
+	ConcurrentDictionaryInterface *concurrentDictionary = (ConcurrentDictionaryInterface *) clazz->interface;
+
+	concurrentDictionary->count = count;
+	concurrentDictionary->enter = enter;
+	concurrentDictionary->init = init;
+	concurrentDictionary->initWithCapacity = initWithCapacity;
+	concurrentDictionary->leave = leave;
+	concurrentDictionary->objectForKey = objectForKey;
+	concurrentDictionary->removeAllObjects = removeAllObjects;
+	concurrentDictionary->removeObjectForKey = removeObjectForKey;
+	concurrentDictionary->setObjectForKey = setObjectForKey;
+	concurrentDictionary->snapshot = snapshot;
+	concurrentDictionary->unretainedObjectForKey = unretainedObjectForKey;
+}
+
+Class _ConcurrentDictionary = {
+	.name = "ConcurrentDictionary",
+	.superclass = &_Object,
+	.instanceSize = sizeof(ConcurrentDictionary),
+	.interfaceOffset = offsetof(ConcurrentDictionary, interface),
+	.interfaceSize = sizeof(ConcurrentDictionaryInterface),
+	.initialize = initialize,
+};
+
+#undef _Class
+
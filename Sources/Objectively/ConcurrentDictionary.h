@@ -0,0 +1,226 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef _Objectively_ConcurrentDictionary_h_
+#define _Objectively_ConcurrentDictionary_h_
+
+#include <Objectively/Dictionary.h>
+
+/**
+ * @file
+ *
+ * @brief Thread-safe key-value stores with lock-free reads.
+ */
+
+/**
+ * @brief The count of shards, each with its own Lock and table.
+ */
+#define CONCURRENTDICTIONARY_SHARDS 16
+
+typedef struct ConcurrentDictionary ConcurrentDictionary;
+typedef struct ConcurrentDictionaryInterface ConcurrentDictionaryInterface;
+
+/**
+ * @brief Thread-safe key-value stores with lock-free reads.
+ *
+ * ConcurrentDictionary partitions its keys into shards by hash. Each shard is
+ * a chained hash table, guarded by its own Lock for writes. Readers take no
+ * locks: they traverse the chains with atomic loads, within an epoch, so that
+ * entries removed or replaced by concurrent writers are reclaimed only once
+ * no reader may still observe them. Only writers reclaim them, so reads
+ * write to no memory but the reading thread's own: an Object removed while no
+ * reader is reading is released at once, and otherwise once later writes to
+ * its shard find that no reader may observe it.
+ *
+ * `objectForKey` retains the Object it returns. To read without modifying
+ * reference counts, enter a read-side critical section with `enter`, read with
+ * `unretainedObjectForKey`, and `leave` once the Objects are no longer used.
+ *
+ * Tables grow incrementally: once a shard exceeds its load, each subsequent
+ * write to it migrates a few buckets to a table of twice the capacity, and
+ * readers follow migrated buckets to the new table.
+ *
+ * @extends Object
+ *
+ * @ingroup Collections
+ * @ingroup Threads
+ */
+struct ConcurrentDictionary {
+
+	/**
+	 * @brief The parent.
+	 *
+	 * @private
+	 */
+	Object object;
+
+	/**
+	 * @brief The typed interface.
+	 *
+	 * @private
+	 */
+	ConcurrentDictionaryInterface *interface;
+
+	/**
+	 * @brief The HashKey with which keys are hashed, or `NULL`.
+	 *
+	 * @private
+	 */
+	const HashKey *hashKey;
+
+	/**
+	 * @brief The shards.
+	 *
+	 * @private
+	 */
+	id shards;
+};
+
+/**
+ * @brief The ConcurrentDictionary interface.
+ */
+struct ConcurrentDictionaryInterface {
+
+	/**
+	 * @brief The parent interface.
+	 */
+	ObjectInterface objectInterface;
+
+	/**
+	 * @return The count of pairs in this ConcurrentDictionary.
+	 *
+	 * @remark The count is exact only in the absence of concurrent writes.
+	 *
+	 * @relates ConcurrentDictionary
+	 */
+	size_t (*count)(const ConcurrentDictionary *self);
+
+	/**
+	 * @brief Enters a read-side critical section, within which no Object read
+	 * by the calling thread is released by concurrent writers.
+	 *
+	 * @remark Critical sections may be nested, and must be balanced with
+	 * `leave` on the same thread. Reclamation of removed Objects is deferred
+	 * while any thread is within one, so keep them short.
+	 *
+	 * @relates ConcurrentDictionary
+	 */
+	void (*enter)(const ConcurrentDictionary *self);
+
+	/**
+	 * @brief Initializes this ConcurrentDictionary.
+	 *
+	 * @return The initialized ConcurrentDictionary, or `NULL` on error.
+	 *
+	 * @relates ConcurrentDictionary
+	 */
+	ConcurrentDictionary *(*init)(ConcurrentDictionary *self);
+
+	/**
+	 * @brief Initializes this ConcurrentDictionary with the specified capacity.
+	 *
+	 * @param capacity The initial capacity.
+	 *
+	 * @return The initialized ConcurrentDictionary, or `NULL` on error.
+	 *
+	 * @relates ConcurrentDictionary
+	 */
+	ConcurrentDictionary *(*initWithCapacity)(ConcurrentDictionary *self, size_t capacity);
+
+	/**
+	 * @brief Leaves a read-side critical section entered with `enter`.
+	 *
+	 * @relates ConcurrentDictionary
+	 */
+	void (*leave)(const ConcurrentDictionary *self);
+
+	/**
+	 * @param key The key.
+	 *
+	 * @return The Object for `key`, retained on behalf of the caller, or `NULL`.
+	 *
+	 * @remark The Object is retained because a concurrent writer may remove it
+	 * at any time. The caller must release it.
+	 *
+	 * @see unretainedObjectForKey(const ConcurrentDictionary *, const id)
+	 *
+	 * @relates ConcurrentDictionary
+	 */
+	id (*objectForKey)(const ConcurrentDictionary *self, const id key);
+
+	/**
+	 * @brief Removes all Objects from this ConcurrentDictionary.
+	 *
+	 * @relates ConcurrentDictionary
+	 */
+	void (*removeAllObjects)(ConcurrentDictionary *self);
+
+	/**
+	 * @brief Removes the Object for `key` from this ConcurrentDictionary.
+	 *
+	 * @param key The key.
+	 *
+	 * @relates ConcurrentDictionary
+	 */
+	void (*removeObjectForKey)(ConcurrentDictionary *self, const id key);
+
+	/**
+	 * @brief Sets a pair in this ConcurrentDictionary.
+	 *
+	 * @param obj The Object.
+	 * @param key The key.
+	 *
+	 * @relates ConcurrentDictionary
+	 */
+	void (*setObjectForKey)(ConcurrentDictionary *self, const id obj, const id key);
+
+	/**
+	 * @return A Dictionary with the pairs of this ConcurrentDictionary.
+	 *
+	 * @remark The snapshot is weakly consistent: pairs written concurrently may
+	 * or may not be included.
+	 *
+	 * @relates ConcurrentDictionary
+	 */
+	Dictionary *(*snapshot)(const ConcurrentDictionary *self);
+
+	/**
+	 * @param key The key.
+	 *
+	 * @return The Object for `key`, or `NULL`.
+	 *
+	 * @remark This must be called within a read-side critical section. The
+	 * Object is not retained, and remains valid only until the caller leaves
+	 * the section.
+	 *
+	 * @relates ConcurrentDictionary
+	 */
+	id (*unretainedObjectForKey)(const ConcurrentDictionary *self, const id key);
+};
+
+/**
+ * @brief The ConcurrentDictionary Class.
+ */
+extern Class _ConcurrentDictionary;
+
+#endif
@@ -0,0 +1,214 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef _Objectively_Cursor_h_
+#define _Objectively_Cursor_h_
+
+#include <assert.h>
+
+#include <Objectively/Types.h>
+
+/**
+ * @file
+ *
+ * @brief Cursors for fast enumeration of collections.
+ *
+ * A Cursor is a stack-allocated iterator. Each call to a collection's
+ * `nextObjects` method fills the Cursor with a batch of Objects, which the
+ * caller may then walk as a plain C array. Arrays hand out their backing
+ * storage directly; hash tables copy up to `CURSOR_BATCH_SIZE` Objects at a
+ * time into the Cursor.
+ *
+ * @code
+ * Cursor cursor;
+ * CursorInit(&cursor);
+ *
+ * while ($(array, nextObjects, &cursor)) {
+ *     for (size_t i = 0; i < cursor.count; i++) {
+ *         ...cursor.objects[i]...
+ *     }
+ * }
+ * @endcode
+ *
+ * @remark Mutating a collection while it is enumerated is a programming error,
+ * which fails an assertion.
+ *
+ * @ingroup Collections
+ */
+
+/**
+ * @brief The count of Objects a Cursor buffers from a hash table at a time.
+ */
+#define CURSOR_BATCH_SIZE 64
+
+/**
+ * @brief The Cursor type.
+ */
+typedef struct {
+
+	/**
+	 * @brief The Objects of the current batch.
+	 */
+	id *objects;
+
+	/**
+	 * @brief The keys of the current batch, when enumerating a Dictionary.
+	 */
+	id *keys;
+
+	/**
+	 * @brief The count of Objects in the current batch.
+	 */
+	size_t count;
+
+	/**
+	 * @brief The position of the next batch in the collection.
+	 *
+	 * @private
+	 */
+	size_t state;
+
+	/**
+	 * @brief The mutation counter of the collection.
+	 *
+	 * @private
+	 */
+	const size_t *mutations;
+
+	/**
+	 * @brief The mutation counter of the collection when enumeration began.
+	 *
+	 * @private
+	 */
+	size_t mutation;
+
+	/**
+	 * @brief The batch buffers of hash tables.
+	 *
+	 * @private
+	 */
+	id objectBuffer[CURSOR_BATCH_SIZE];
+	id keyBuffer[CURSOR_BATCH_SIZE];
+} Cursor;
+
+/**
+ * @brief Initializes `cursor` for the first batch of a collection.
+ *
+ * @return The Cursor.
+ */
+static inline Cursor *CursorInit(Cursor *cursor) {
+
+	cursor->objects = cursor->keys = NULL;
+	cursor->count = cursor->state = 0;
+	cursor->mutations = NULL;
+
+	return cursor;
+}
+
+/**
+ * @brief Begins or continues enumerating a collection with the given mutation
+ * counter, asserting that the collection has not been mutated.
+ *
+ * @private
+ */
+static inline void _CursorCheckMutations(Cursor *cursor, const size_t *mutations) {
+
+	if (cursor->mutations == NULL) {
+		cursor->mutations = mutations;
+		cursor->mutation = *mutations;
+	}
+
+	assert(*cursor->mutations == cursor->mutation);
+}
+
+/**
+ * @brief The state of a `foreach` loop.
+ *
+ * @remark This is kept apart from the Cursor, whose address escapes to the
+ * collection, so that the compiler may keep it in registers.
+ *
+ * @private
+ */
+typedef struct {
+	id *objects;
+	id *keys;
+	size_t index;
+	size_t count;
+	const size_t *mutations;
+	size_t mutation;
+	BOOL inBody;
+	BOOL inKey;
+} _CursorLoop;
+
+/**
+ * @brief Advances `loop`, fetching the next batch of `collection` into `cursor`
+ * as needed.
+ *
+ * @return Nonzero if the loop has an Object remaining, and has not been broken.
+ *
+ * @private
+ */
+#define _CursorLoopNext(loop, cursor, collection) \
+	((loop).inBody == NO && \
+		((loop).index < (loop).count || \
+			((loop).index = 0, \
+			 (loop).count = $(collection, nextObjects, cursor), \
+			 (loop).objects = (cursor)->objects, \
+			 (loop).keys = (cursor)->keys, \
+			 (loop).mutations = (cursor)->mutations, \
+			 (loop).mutation = (cursor)->mutation, \
+			 (loop).count)) && \
+		(assert(*(loop).mutations == (loop).mutation), YES))
+
+/**
+ * @brief Enumerates the Objects of an Array or Set, or a Dictionary's values.
+ *
+ * @param decl The declaration of the loop variable, e.g. `String *string`.
+ * @param collection The collection, which is evaluated once per batch.
+ *
+ * @remark `break` and `continue` behave as in any other loop.
+ */
+#define foreach(decl, collection) \
+	for (Cursor _cursor, *_c = CursorInit(&_cursor); _c; _c = NULL) \
+		for (_CursorLoop _loop = { .index = 0, .count = 0 }; _CursorLoopNext(_loop, _c, collection); ) \
+			for (decl = (_loop.inBody = YES, _loop.objects[_loop.index++]); \
+					_loop.inBody; _loop.inBody = NO)
+
+/**
+ * @brief Enumerates the keys and values of a Dictionary.
+ *
+ * @param keyDecl The declaration of the key variable.
+ * @param objDecl The declaration of the value variable.
+ * @param dictionary The Dictionary, which is evaluated once per batch.
+ *
+ * @see foreach
+ */
+#define foreachKeyAndObject(keyDecl, objDecl, dictionary) \
+	for (Cursor _cursor, *_c = CursorInit(&_cursor); _c; _c = NULL) \
+		for (_CursorLoop _loop = { .index = 0, .count = 0 }; _CursorLoopNext(_loop, _c, dictionary); ) \
+			for (keyDecl = (_loop.inKey = YES, _loop.keys[_loop.index]); \
+					_loop.inKey; _loop.inKey = NO) \
+				for (objDecl = (_loop.inBody = YES, _loop.objects[_loop.index++]); \
+						_loop.inBody; _loop.inBody = NO)
+
+#endif
@@ -64,17 +64,40 @@ static void dealloc(Object *self) {
  */
 static int hash(const Object *self) {
 
+	return (int) $(self, hash64);
+}
+
+/**
+ * @see ObjectInterface::hash64(const Object *)
+ */
+static uint64_t hash64(const Object *self) {
+
 	Data *this = (Data *) self;
 
-	int hash = HASH_SEED;
-	hash = HashForInteger(hash, this->length);
+	uint64_t hash = __atomic_load_n(&this->hash, __ATOMIC_RELAXED);
+	if (hash == 0) {
 
-	const RANGE range = { 0, this->length };
-	hash = HashForBytes(hash, this->bytes, range);
+		const RANGE range = { 0, this->length };
+		hash = HashForBytes64(HASH_SEED, this->bytes, range);
+
+		__atomic_store_n(&this->hash, hash, __ATOMIC_RELAXED);
+	}
 
 	return hash;
 }
 
+/**
+ * @see ObjectInterface::hashWithKey(const Object *, const HashKey *)
+ */
+static uint64_t hashWithKey(const Object *self, const HashKey *key) {
+
+	Data *this = (Data *) self;
+
+	const RANGE range = { 0, this->length };
+
+	return HashForBytesWithKey(key, this->bytes, range);
+}
+
 /**
  * @see ObjectInterface::isEqual(const Object *, const Object *)
  */
@@ -90,6 +113,14 @@ static BOOL isEqual(const Object *self, const Object *other) {
 		const Data *that = (Data *) other;
 
 		if (this->length == that->length) {
+
+			const uint64_t thisHash = __atomic_load_n(&this->hash, __ATOMIC_RELAXED);
+			const uint64_t thatHash = __atomic_load_n(&that->hash, __ATOMIC_RELAXED);
+
+			if (thisHash && thatHash && thisHash != thatHash) {
+				return NO;
+			}
+
 			return memcmp(this->bytes, that->bytes, this->length) == 0;
 		}
 	}
@@ -232,6 +263,8 @@ static void initialize(Class *clazz) {
 	object->copy = copy;
 	object->dealloc = dealloc;
 	object->hash = hash;
+	object->hash64 = hash64;
+	object->hashWithKey = hashWithKey;
 	object->isEqual = isEqual;
 
 	DataInterface *data = (DataInterface *) clazz->interface;
@@ -67,6 +67,15 @@ struct Data {
 	 * @brief The length of `bytes`.
 	 */
 	size_t length;
+
+	/**
+	 * @brief The memoized 64 bit hash, or `0` if it has not been computed.
+	 *
+	 * @remark MutableData do not memoize their hash.
+	 *
+	 * @private
+	 */
+	uint64_t hash;
 };
 
 typedef struct MutableData MutableData;
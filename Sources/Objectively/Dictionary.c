@@ -24,15 +24,320 @@
 #include <assert.h>
 #include <stdarg.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include <Objectively/Dictionary.h>
+#include <Objectively/FrozenDictionary.h>
 #include <Objectively/Hash.h>
 #include <Objectively/MutableArray.h>
 #include <Objectively/MutableDictionary.h>
 #include <Objectively/MutableString.h>
+#include <Objectively/OperationQueue.h>
+#include <Objectively/Reclaimer.h>
+
+#include "SwissTable.h"
 
 #define _Class _Dictionary
 
+/**
+ * @brief The count of slots in each iteration of the concurrent methods.
+ */
+#define CONCURRENT_CHUNK_SIZE 4096
+
+#if DICTIONARY_GROUP_SIZE != SWISS_TABLE_GROUP_SIZE
+#error DICTIONARY_GROUP_SIZE must equal SWISS_TABLE_GROUP_SIZE
+#endif
+
+#pragma mark - Table
+
+/**
+ * @brief Allocates an empty table of `capacity` slots for `self`.
+ */
+static void allocate(Dictionary *self, size_t capacity) {
+
+	self->entries = SwissTableAllocate(SwissTableOf(self), capacity);
+}
+
+uint64_t _Dictionary_hashForKey(const Dictionary *self, const id key) {
+
+	return HashForObjectWithKey(self->hashKey, key);
+}
+
+/**
+ * @brief SwissTableEquality for _Dictionary_find.
+ */
+static BOOL find_equality(const void *entry, const void *key) {
+
+	const id other = ((const DictionaryEntry *) entry)->key;
+
+	return other == key || $((Object *) other, isEqual, key);
+}
+
+DictionaryEntry *_Dictionary_find(const Dictionary *self, const id key, const uint64_t hash) {
+
+	if (self->count == 0) {
+		return NULL;
+	}
+
+	return SwissTableFind(self->control, self->entries, self->capacity, sizeof(DictionaryEntry),
+			hash, find_equality, key);
+}
+
+/**
+ * @brief The bytes of a String for findBytes.
+ */
+typedef struct {
+	const byte *bytes;
+	size_t length;
+} Bytes;
+
+/**
+ * @brief SwissTableEquality for findBytes.
+ */
+static BOOL findBytes_equality(const void *entry, const void *data) {
+
+	const Bytes *bytes = data;
+
+	return _String_isEqualToBytes(((const DictionaryEntry *) entry)->key, bytes->bytes, bytes->length);
+}
+
+/**
+ * @brief Finds the entry whose key is a String equal to `bytes`.
+ *
+ * @see _Dictionary_find(const Dictionary *, const id, const uint64_t)
+ */
+static DictionaryEntry *findBytes(const Dictionary *self, const byte *bytes, const size_t length,
+		const uint64_t hash) {
+
+	if (self->count == 0) {
+		return NULL;
+	}
+
+	const Bytes data = { .bytes = bytes, .length = length };
+
+	return SwissTableFind(self->control, self->entries, self->capacity, sizeof(DictionaryEntry),
+			hash, findBytes_equality, &data);
+}
+
+DictionaryEntry *_Dictionary_insert(Dictionary *self, const uint64_t hash) {
+
+	self->entries = SwissTableReserve(SwissTableOf(self));
+
+	return SwissTableInsert(SwissTableOf(self), self->entries, hash);
+}
+
+void _Dictionary_erase(Dictionary *self, DictionaryEntry *entry) {
+
+	SwissTableErase(SwissTableOf(self), self->entries, entry);
+
+	entry->key = entry->obj = NULL;
+}
+
+void _Dictionary_clear(Dictionary *self) {
+
+	SwissTableClear(SwissTableOf(self));
+}
+
+void _Dictionary_resize(Dictionary *self, size_t count) {
+
+	self->entries = SwissTableResize(SwissTableOf(self), count);
+}
+
+#pragma mark - Concurrency
+
+/**
+ * @brief The state of the concurrent primitives, which their iterations share.
+ */
+typedef struct {
+	const Dictionary *dictionary;
+	const DictionaryEntry *entries;
+	const byte *control;
+	size_t slots;
+	DictionaryEnumerator enumerator;
+	id data;
+	BOOL stop;
+	DictionaryEntry *matches;
+	size_t *offsets;
+	size_t *counts;
+} Concurrent;
+
+/**
+ * @return The count of iterations of the concurrent primitives for `slots`.
+ */
+static size_t chunks(size_t slots) {
+
+	return (slots + CONCURRENT_CHUNK_SIZE - 1) / CONCURRENT_CHUNK_SIZE;
+}
+
+/**
+ * @return The slot after the last slot of `chunk`.
+ */
+static size_t chunkEnd(const Concurrent *concurrent, size_t chunk) {
+
+	const size_t end = (chunk + 1) * CONCURRENT_CHUNK_SIZE;
+
+	return end < concurrent->slots ? end : concurrent->slots;
+}
+
+/**
+ * @return `YES` if the slot at `index` is in use.
+ */
+static inline BOOL isInUse(const Concurrent *concurrent, size_t index) {
+
+	if (concurrent->control) {
+		return isFull(concurrent->control[index]);
+	}
+
+	return concurrent->entries[index].key != NULL;
+}
+
+/**
+ * @brief ApplyFunction for _Dictionary_enumerateEntriesConcurrently.
+ */
+static void enumerateEntriesConcurrently_apply(size_t chunk, id data) {
+
+	Concurrent *concurrent = data;
+
+	const size_t end = chunkEnd(concurrent, chunk);
+
+	for (size_t i = chunk * CONCURRENT_CHUNK_SIZE; i < end; i++) {
+		if (isInUse(concurrent, i)) {
+
+			if (__atomic_load_n(&concurrent->stop, __ATOMIC_RELAXED)) {
+				break;
+			}
+
+			const DictionaryEntry *entry = concurrent->entries + i;
+
+			if (concurrent->enumerator(concurrent->dictionary, entry->obj, entry->key, concurrent->data)) {
+				__atomic_store_n(&concurrent->stop, YES, __ATOMIC_RELAXED);
+				break;
+			}
+		}
+	}
+}
+
+void _Dictionary_enumerateEntriesConcurrently(const Dictionary *self,
+		const DictionaryEntry *entries, const byte *control, size_t slots,
+		DictionaryEnumerator enumerator, id data) {
+
+	assert(enumerator);
+
+	Concurrent concurrent = {
+		.dictionary = self,
+		.entries = entries,
+		.control = control,
+		.slots = slots,
+		.enumerator = enumerator,
+		.data = data
+	};
+
+	$$(OperationQueue, apply, chunks(slots), enumerateEntriesConcurrently_apply, &concurrent);
+}
+
+/**
+ * @return The count of slots of `chunk` that are in use.
+ */
+static size_t chunkInUse(const Concurrent *concurrent, size_t chunk) {
+
+	const size_t end = chunkEnd(concurrent, chunk);
+
+	size_t count = 0;
+
+	if (concurrent->control) {
+		for (size_t i = chunk * CONCURRENT_CHUNK_SIZE; i < end; i += DICTIONARY_GROUP_SIZE) {
+			count += __builtin_popcount(SwissTableMatchFull(concurrent->control + i));
+		}
+	} else {
+		for (size_t i = chunk * CONCURRENT_CHUNK_SIZE; i < end; i++) {
+			count += concurrent->entries[i].key != NULL;
+		}
+	}
+
+	return count;
+}
+
+/**
+ * @brief ApplyFunction for _Dictionary_filterEntriesConcurrently, which gathers
+ * the matches of each chunk into its own region of the shared buffer, so that
+ * they are merged without locking.
+ */
+static void filterEntriesConcurrently_apply(size_t chunk, id data) {
+
+	Concurrent *concurrent = data;
+
+	const size_t end = chunkEnd(concurrent, chunk);
+
+	DictionaryEntry *matches = concurrent->matches + concurrent->offsets[chunk];
+	size_t count = 0;
+
+	for (size_t i = chunk * CONCURRENT_CHUNK_SIZE; i < end; i++) {
+		if (isInUse(concurrent, i)) {
+
+			const DictionaryEntry *entry = concurrent->entries + i;
+
+			if (concurrent->enumerator(concurrent->dictionary, entry->obj, entry->key, concurrent->data)) {
+				matches[count++] = *entry;
+			}
+		}
+	}
+
+	concurrent->counts[chunk] = count;
+}
+
+DictionaryEntry *_Dictionary_filterEntriesConcurrently(const Dictionary *self,
+		const DictionaryEntry *entries, const byte *control, size_t slots,
+		DictionaryEnumerator enumerator, id data, size_t *count) {
+
+	assert(enumerator);
+	assert(count);
+
+	*count = 0;
+
+	if (self->count == 0) {
+		return NULL;
+	}
+
+	const size_t iterations = chunks(slots);
+
+	Concurrent concurrent = {
+		.dictionary = self,
+		.entries = entries,
+		.control = control,
+		.slots = slots,
+		.enumerator = enumerator,
+		.data = data,
+		.matches = malloc(self->count * sizeof(DictionaryEntry)),
+		.offsets = malloc(iterations * sizeof(size_t)),
+		.counts = calloc(iterations, sizeof(size_t))
+	};
+
+	assert(concurrent.matches);
+	assert(concurrent.offsets);
+	assert(concurrent.counts);
+
+	size_t offset = 0;
+	for (size_t i = 0; i < iterations; i++) {
+		concurrent.offsets[i] = offset;
+		offset += chunkInUse(&concurrent, i);
+	}
+
+	assert(offset == self->count);
+
+	$$(OperationQueue, apply, iterations, filterEntriesConcurrently_apply, &concurrent);
+
+	for (size_t i = 0; i < iterations; i++) {
+		memmove(concurrent.matches + *count, concurrent.matches + concurrent.offsets[i],
+				concurrent.counts[i] * sizeof(DictionaryEntry));
+		*count += concurrent.counts[i];
+	}
+
+	free(concurrent.offsets);
+	free(concurrent.counts);
+
+	return concurrent.matches;
+}
+
 #pragma mark - ObjectInterface
 
 /**
@@ -54,11 +359,18 @@ static void dealloc(Object *self) {
 
 	Dictionary *this = (Dictionary *) self;
 
+	if (_reclaim(self, this->count, dealloc)) {
+		return;
+	}
+
 	for (size_t i = 0; i < this->capacity; i++) {
-		release(this->elements[i]);
+		if (isFull(this->control[i])) {
+			release(this->entries[i].key);
+			release(this->entries[i].obj);
+		}
 	}
 
-	free(this->elements);
+	free(this->control);
 
 	super(Object, self, dealloc);
 }
@@ -109,8 +421,8 @@ static int hash(const Object *self) {
 	int hash = HashForInteger(HASH_SEED, this->count);
 
 	for (size_t i = 0; i < this->capacity; i++) {
-		if (this->elements[i]) {
-			hash = HashForObject(hash, this->elements[i]);
+		if (isFull(this->control[i])) {
+			hash += HashForObject(HashForObject(HASH_SEED, this->entries[i].key), this->entries[i].obj);
 		}
 	}
 
@@ -131,25 +443,24 @@ static BOOL isEqual(const Object *self, const Object *other) {
 		const Dictionary *this = (Dictionary *) self;
 		const Dictionary *that = (Dictionary *) other;
 
-		if (this->count == that->count) {
+		if (this->count != that->count) {
+			return NO;
+		}
 
-			Array *keys = $(this, allKeys);
+		if (this->hashKey == that->hashKey && this->hashes != that->hashes) {
+			return NO;
+		}
 
-			for (size_t i = 0; i < keys->count; i++) {
-				const id key = $(keys, objectAtIndex, i);
+		foreachKeyAndObject(id key, const Object *thisObject, this) {
 
-				const Object *thisObject = $(this, objectForKey, key);
-				const Object *thatObject = $(that, objectForKey, key);
+			const Object *thatObject = $(that, objectForKey, key);
 
-				if ($(thisObject, isEqual, thatObject) == NO) {
-					release(keys);
-					return NO;
-				}
+			if ($(thisObject, isEqual, thatObject) == NO) {
+				return NO;
 			}
-
-			release(keys);
-			return YES;
 		}
+
+		return YES;
 	}
 
 	return NO;
@@ -211,6 +522,8 @@ static Dictionary *dictionaryWithObjectsAndKeys(id obj, ...) {
 	Dictionary *dict = (Dictionary *) super(Object, alloc(Dictionary), init);
 	if (dict) {
 
+		dict->hashKey = HashKeyDefault();
+
 		va_list args;
 		va_start(args, obj);
 
@@ -237,23 +550,27 @@ static void enumerateObjectsAndKeys(const Dictionary *self, DictionaryEnumerator
 	assert(enumerator);
 
 	for (size_t i = 0; i < self->capacity; i++) {
+		if (isFull(self->control[i])) {
 
-		Array *array = self->elements[i];
-		if (array) {
+			const DictionaryEntry *entry = self->entries + i;
 
-			for (size_t j = 0; j < array->count; j += 2) {
-
-				id key = $(array, objectAtIndex, j);
-				id obj = $(array, objectAtIndex, j + 1);
-
-				if (enumerator(self, obj, key, data)) {
-					return;
-				}
+			if (enumerator(self, entry->obj, entry->key, data)) {
+				return;
 			}
 		}
 	}
 }
 
+/**
+ * @see DictionaryInterface::enumerateObjectsAndKeysConcurrently(const Dictionary *, DictionaryEnumerator, id)
+ */
+static void enumerateObjectsAndKeysConcurrently(const Dictionary *self,
+		DictionaryEnumerator enumerator, id data) {
+
+	_Dictionary_enumerateEntriesConcurrently(self, self->entries, self->control, self->capacity,
+			enumerator, data);
+}
+
 /**
  * @see DictionaryInterface::filterObjectsAndKeys(const Dictionary *, DictionaryEnumerator, id)
  */
@@ -262,21 +579,15 @@ static Dictionary *filterObjectsAndKeys(const Dictionary *self, DictionaryEnumer
 
 	assert(enumerator);
 
-	MutableDictionary *dictionary = $(alloc(MutableDictionary), init);
+	MutableDictionary *dictionary = $(alloc(MutableDictionary), initWithCapacityAndHashKey, 0, self->hashKey);
 
 	for (size_t i = 0; i < self->capacity; i++) {
+		if (isFull(self->control[i])) {
 
-		Array *array = self->elements[i];
-		if (array) {
-
-			for (size_t j = 0; j < array->count; j += 2) {
-
-				id key = $(array, objectAtIndex, j);
-				id obj = $(array, objectAtIndex, j + 1);
+			const DictionaryEntry *entry = self->entries + i;
 
-				if (enumerator(self, obj, key, data)) {
-					$(dictionary, setObjectForKey, obj, key);
-				}
+			if (enumerator(self, entry->obj, entry->key, data)) {
+				$(dictionary, setObjectForKey, entry->obj, entry->key);
 			}
 		}
 	}
@@ -284,6 +595,59 @@ static Dictionary *filterObjectsAndKeys(const Dictionary *self, DictionaryEnumer
 	return (Dictionary *) dictionary;
 }
 
+/**
+ * @see DictionaryInterface::filterObjectsAndKeysConcurrently(const Dictionary *, DictionaryEnumerator, id)
+ */
+static Dictionary *filterObjectsAndKeysConcurrently(const Dictionary *self,
+		DictionaryEnumerator enumerator, id data) {
+
+	size_t count;
+	DictionaryEntry *matches = _Dictionary_filterEntriesConcurrently(self, self->entries, self->control,
+			self->capacity, enumerator, data, &count);
+
+	MutableDictionary *dictionary = $(alloc(MutableDictionary), initWithCapacityAndHashKey, count, self->hashKey);
+
+	for (size_t i = 0; i < count; i++) {
+
+		DictionaryEntry *entry = _Dictionary_insert((Dictionary *) dictionary, matches[i].hash);
+
+		entry->key = retain(matches[i].key);
+		entry->obj = retain(matches[i].obj);
+	}
+
+	free(matches);
+
+	return (Dictionary *) dictionary;
+}
+
+/**
+ * @see DictionaryInterface::frozenCopy(const Dictionary *)
+ */
+static Dictionary *frozenCopy(const Dictionary *self) {
+
+	FrozenDictionary *frozen = $(alloc(FrozenDictionary), initWithDictionary, self);
+	if (frozen) {
+		return (Dictionary *) frozen;
+	}
+
+	return $(alloc(Dictionary), initWithDictionary, self);
+}
+
+/**
+ * @brief DictionaryEnumerator for initWithDictionary.
+ */
+static BOOL initWithDictionary_enumerator(const Dictionary *dict, id obj, id key, id data) {
+
+	Dictionary *this = (Dictionary *) data;
+
+	DictionaryEntry *entry = _Dictionary_insert(this, _Dictionary_hashForKey(this, key));
+
+	entry->key = retain(key);
+	entry->obj = retain(obj);
+
+	return NO;
+}
+
 /**
  * @see DictionaryInterface::initWithDictionary(Dictionary *, const Dictionary *)
  */
@@ -293,20 +657,29 @@ static Dictionary *initWithDictionary(Dictionary *self, const Dictionary *dictio
 	if (self) {
 		if (dictionary) {
 
-			self->capacity = dictionary->capacity;
+			self->hashKey = dictionary->hashKey;
 
-			self->elements = calloc(self->capacity, sizeof(id));
-			assert(self->elements);
+			if (dictionary->capacity) {
+				allocate(self, dictionary->capacity);
 
-			for (size_t i = 0; i < dictionary->capacity; i++) {
+				memcpy(self->control, dictionary->control, self->capacity + self->capacity * sizeof(DictionaryEntry));
 
-				Array *array = dictionary->elements[i];
-				if (array) {
-					self->elements[i] = $((Object *) array, copy);
+				for (size_t i = 0; i < self->capacity; i++) {
+					if (isFull(self->control[i])) {
+						retain(self->entries[i].key);
+						retain(self->entries[i].obj);
+					}
 				}
-			}
 
-			self->count = dictionary->count;
+				self->count = dictionary->count;
+				self->growth = dictionary->growth;
+				self->hashes = dictionary->hashes;
+			} else if (dictionary->count) {
+				_Dictionary_resize(self, dictionary->count);
+				$(dictionary, enumerateObjectsAndKeys, initWithDictionary_enumerator, self);
+			}
+		} else {
+			self->hashKey = HashKeyDefault();
 		}
 	}
 
@@ -321,6 +694,8 @@ static Dictionary *initWithObjectsAndKeys(Dictionary *self, ...) {
 	self = (Dictionary *) super(Object, self, init);
 	if (self) {
 
+		self->hashKey = HashKeyDefault();
+
 		va_list args;
 		va_start(args, self);
 
@@ -347,7 +722,7 @@ static Dictionary *initWithObjectsAndKeys(Dictionary *self, ...) {
  */
 static MutableDictionary *mutableCopy(const Dictionary *self) {
 
-	MutableDictionary *copy = $(alloc(MutableDictionary), initWithCapacity, self->count);
+	MutableDictionary *copy = $(alloc(MutableDictionary), initWithCapacityAndHashKey, self->count, self->hashKey);
 	if (copy) {
 		$(copy, addEntriesFromDictionary, self);
 	}
@@ -356,19 +731,66 @@ static MutableDictionary *mutableCopy(const Dictionary *self) {
 }
 
 /**
- * @see DictionaryInterface::objectForKey(const Dictionary *, const id)
+ * @see DictionaryInterface::nextObjects(const Dictionary *, Cursor *)
  */
-static id objectForKey(const Dictionary *self, const id key) {
+static size_t nextObjects(const Dictionary *self, Cursor *cursor) {
 
-	const size_t bin = HashForObject(HASH_SEED, key) % self->capacity;
+	_CursorCheckMutations(cursor, &self->mutations);
 
-	Array *array = self->elements[bin];
-	if (array) {
+	cursor->objects = cursor->objectBuffer;
+	cursor->keys = cursor->keyBuffer;
+	cursor->count = 0;
 
-		int index = $(array, indexOfObject, key);
-		if (index > -1) {
-			return $(array, objectAtIndex, index + 1);
+	while (cursor->state < self->capacity && cursor->count + DICTIONARY_GROUP_SIZE <= CURSOR_BATCH_SIZE) {
+
+		const DictionaryEntry *entries = self->entries + cursor->state;
+
+		for (unsigned m = SwissTableMatchFull(self->control + cursor->state); m; m &= m - 1) {
+
+			const DictionaryEntry *entry = entries + __builtin_ctz(m);
+
+			cursor->keys[cursor->count] = entry->key;
+			cursor->objects[cursor->count] = entry->obj;
+			cursor->count++;
 		}
+
+		cursor->state += DICTIONARY_GROUP_SIZE;
+	}
+
+	return cursor->count;
+}
+
+/**
+ * @see DictionaryInterface::objectForBytes(const Dictionary *, const byte *, size_t)
+ */
+static id objectForBytes(const Dictionary *self, const byte *bytes, size_t length) {
+
+	const uint64_t hash = _String_hashForBytes(self->hashKey, bytes, length);
+
+	const DictionaryEntry *entry = findBytes(self, bytes, length, hash);
+	if (entry) {
+		return entry->obj;
+	}
+
+	return NULL;
+}
+
+/**
+ * @see DictionaryInterface::objectForCharacters(const Dictionary *, const char *)
+ */
+static id objectForCharacters(const Dictionary *self, const char *chars) {
+
+	return $(self, objectForBytes, (const byte *) chars, strlen(chars));
+}
+
+/**
+ * @see DictionaryInterface::objectForKey(const Dictionary *, const id)
+ */
+static id objectForKey(const Dictionary *self, const id key) {
+
+	const DictionaryEntry *entry = _Dictionary_find(self, key, _Dictionary_hashForKey(self, key));
+	if (entry) {
+		return entry->obj;
 	}
 
 	return NULL;
@@ -396,10 +818,16 @@ static void initialize(Class *clazz) {
 	dictionary->dictionaryWithDictionary = dictionaryWithDictionary;
 	dictionary->dictionaryWithObjectsAndKeys = dictionaryWithObjectsAndKeys;
 	dictionary->enumerateObjectsAndKeys = enumerateObjectsAndKeys;
+	dictionary->enumerateObjectsAndKeysConcurrently = enumerateObjectsAndKeysConcurrently;
 	dictionary->filterObjectsAndKeys = filterObjectsAndKeys;
+	dictionary->filterObjectsAndKeysConcurrently = filterObjectsAndKeysConcurrently;
+	dictionary->frozenCopy = frozenCopy;
 	dictionary->initWithDictionary = initWithDictionary;
 	dictionary->initWithObjectsAndKeys = initWithObjectsAndKeys;
 	dictionary->mutableCopy = mutableCopy;
+	dictionary->nextObjects = nextObjects;
+	dictionary->objectForBytes = objectForBytes;
+	dictionary->objectForCharacters = objectForCharacters;
 	dictionary->objectForKey = objectForKey;
 }
 
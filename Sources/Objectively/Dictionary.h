@@ -25,6 +25,7 @@
 #define _Objectively_Dictionary_h_
 
 #include <Objectively/Array.h>
+#include <Objectively/Cursor.h>
 #include <Objectively/Object.h>
 
 /**
@@ -48,6 +49,34 @@ typedef struct DictionaryInterface DictionaryInterface;
  */
 typedef BOOL (*DictionaryEnumerator)(const Dictionary *dictionary, id obj, id key, id data);
 
+/**
+ * @brief The number of slots whose control bytes are probed together.
+ */
+#define DICTIONARY_GROUP_SIZE 16
+
+/**
+ * @brief A key-value slot of a Dictionary.
+ *
+ * @private
+ */
+typedef struct {
+
+	/**
+	 * @brief The hash of `key`.
+	 */
+	uint64_t hash;
+
+	/**
+	 * @brief The key.
+	 */
+	id key;
+
+	/**
+	 * @brief The Object.
+	 */
+	id obj;
+} DictionaryEntry;
+
 /**
  * @brief Immutable key-value stores.
  *
@@ -72,7 +101,8 @@ struct Dictionary {
 	DictionaryInterface *interface;
 
 	/**
-	 * @brief The internal size (number of bins).
+	 * @brief The internal size (number of slots), a power of two multiple of
+	 * `DICTIONARY_GROUP_SIZE`, or `0`.
 	 *
 	 * @private
 	 */
@@ -84,11 +114,51 @@ struct Dictionary {
 	size_t count;
 
 	/**
-	 * @brief The elements.
+	 * @brief The control bytes, one per slot, which are either empty, deleted,
+	 * or the low 7 bits of the hash of the slot's key.
+	 *
+	 * @private
+	 */
+	byte *control;
+
+	/**
+	 * @brief The slots, which share an allocation with `control`.
+	 *
+	 * @private
+	 */
+	DictionaryEntry *entries;
+
+	/**
+	 * @brief The count of elements that may be inserted before resizing.
 	 *
 	 * @private
 	 */
-	id *elements;
+	size_t growth;
+
+	/**
+	 * @brief The secret HashKey with which keys are binned, or `NULL`.
+	 *
+	 * @see HashKeyDefault(void)
+	 *
+	 * @private
+	 */
+	const HashKey *hashKey;
+
+	/**
+	 * @brief The count of mutations, with which Cursors detect modification
+	 * during enumeration.
+	 *
+	 * @private
+	 */
+	size_t mutations;
+
+	/**
+	 * @brief The sum of the hashes of the keys, with which most unequal
+	 * Dictionaries are told apart without probing.
+	 *
+	 * @private
+	 */
+	uint64_t hashes;
 };
 
 typedef struct MutableDictionary MutableDictionary;
@@ -152,6 +222,23 @@ struct DictionaryInterface {
 	void (*enumerateObjectsAndKeys)(const Dictionary *self, DictionaryEnumerator enumerator,
 			id data);
 
+	/**
+	 * @brief Enumerate the pairs of this Dictionary concurrently with the given
+	 * function.
+	 *
+	 * @param enumerator The enumerator function, which must be thread-safe.
+	 * @param data User data.
+	 *
+	 * @remark The enumerator should return `YES` to break the iteration, though
+	 * pairs already being enumerated by other threads will still finish.
+	 *
+	 * @see OperationQueueInterface::apply(size_t, ApplyFunction, id)
+	 *
+	 * @relates Dictionary
+	 */
+	void (*enumerateObjectsAndKeysConcurrently)(const Dictionary *self,
+			DictionaryEnumerator enumerator, id data);
+
 	/**
 	 * @brief Creates a new Dictionary with pairs that pass the filter function.
 	 *
@@ -165,6 +252,35 @@ struct DictionaryInterface {
 	Dictionary *(*filterObjectsAndKeys)(const Dictionary *self, DictionaryEnumerator enumerator,
 			id data);
 
+	/**
+	 * @brief Creates a new Dictionary with pairs that pass the filter function,
+	 * which is called concurrently.
+	 *
+	 * @param enumerator The enumerator function, which must be thread-safe.
+	 * @param data User data.
+	 *
+	 * @return The new, filtered Dictionary.
+	 *
+	 * @see OperationQueueInterface::apply(size_t, ApplyFunction, id)
+	 *
+	 * @relates Dictionary
+	 */
+	Dictionary *(*filterObjectsAndKeysConcurrently)(const Dictionary *self,
+			DictionaryEnumerator enumerator, id data);
+
+	/**
+	 * @brief Creates an immutable, perfect-hashed copy of this Dictionary, for
+	 * tables that are built once and then read often, from any thread.
+	 *
+	 * @return The FrozenDictionary, or a Dictionary if the keys of this Dictionary
+	 * can not be perfectly hashed (i.e. distinct keys share a 64 bit hash).
+	 *
+	 * @see FrozenDictionary
+	 *
+	 * @relates Dictionary
+	 */
+	Dictionary *(*frozenCopy)(const Dictionary *self);
+
 	/**
 	 * @brief Initializes this Dictionary to contain elements of `dictionary`.
 	 *
@@ -193,6 +309,50 @@ struct DictionaryInterface {
 	 */
 	MutableDictionary *(*mutableCopy)(const Dictionary *self);
 
+	/**
+	 * @brief Fills `cursor` with the next batch of keys and values in this
+	 * Dictionary.
+	 *
+	 * @param cursor The Cursor, initialized with `CursorInit` before the first batch.
+	 *
+	 * @return The count of pairs in the batch, or `0` when enumeration is complete.
+	 *
+	 * @see foreach
+	 * @see foreachKeyAndObject
+	 *
+	 * @relates Dictionary
+	 */
+	size_t (*nextObjects)(const Dictionary *self, Cursor *cursor);
+
+	/**
+	 * @brief Looks up the String key matching the given bytes, without
+	 * instantiating a String.
+	 *
+	 * @param bytes The UTF-8 encoded characters of the key.
+	 * @param length The length of `bytes`.
+	 *
+	 * @return The Object stored at the String key equal to `bytes`, or `NULL`.
+	 *
+	 * @remark Keys which are not Strings never match.
+	 *
+	 * @relates Dictionary
+	 */
+	id (*objectForBytes)(const Dictionary *self, const byte *bytes, size_t length);
+
+	/**
+	 * @brief Looks up the String key matching the given null-terminated
+	 * characters, without instantiating a String.
+	 *
+	 * @param chars The null-terminated UTF-8 encoded characters of the key.
+	 *
+	 * @return The Object stored at the String key equal to `chars`, or `NULL`.
+	 *
+	 * @see objectForBytes(const Dictionary *, const byte *, size_t)
+	 *
+	 * @relates Dictionary
+	 */
+	id (*objectForCharacters)(const Dictionary *self, const char *chars);
+
 	/**
 	 * @return The Object stored at the specified key in this Dictionary.
 	 *
@@ -206,4 +366,45 @@ struct DictionaryInterface {
  */
 extern Class _Dictionary;
 
+/**
+ * @brief The Dictionary table primitives, which MutableDictionary shares.
+ *
+ * Dictionary is an open-addressing hash table in the style of Abseil's Swiss
+ * tables. Each slot has a control byte, and the control bytes of a group of
+ * `DICTIONARY_GROUP_SIZE` slots are matched against the hash of a key at once,
+ * with SSE2 where available. Only slots whose control bytes match are compared
+ * with `isEqual`.
+ *
+ * @remark Removed entries leave a deleted marker, so that probing continues
+ * past them, unless their group has an empty slot, at which probing would
+ * stop anyway.
+ *
+ * @private
+ */
+extern uint64_t _Dictionary_hashForKey(const Dictionary *self, const id key);
+extern DictionaryEntry *_Dictionary_find(const Dictionary *self, const id key, const uint64_t hash);
+extern DictionaryEntry *_Dictionary_insert(Dictionary *self, const uint64_t hash);
+extern void _Dictionary_erase(Dictionary *self, DictionaryEntry *entry);
+extern void _Dictionary_clear(Dictionary *self);
+extern void _Dictionary_resize(Dictionary *self, size_t count);
+
+/**
+ * @brief The concurrent enumeration primitives, which the subclasses of
+ * Dictionary share.
+ *
+ * The `slots` of `entries` are enumerated in chunks, concurrently. A slot is
+ * in use if its byte in `control` is that of a full slot or, if `control` is
+ * `NULL`, if its key is not `NULL`. Filtered entries are returned in slot
+ * order, in a buffer of `count` entries that the caller must free, or `NULL`
+ * if the Dictionary is empty.
+ *
+ * @private
+ */
+extern void _Dictionary_enumerateEntriesConcurrently(const Dictionary *self,
+		const DictionaryEntry *entries, const byte *control, size_t slots,
+		DictionaryEnumerator enumerator, id data);
+extern DictionaryEntry *_Dictionary_filterEntriesConcurrently(const Dictionary *self,
+		const DictionaryEntry *entries, const byte *control, size_t slots,
+		DictionaryEnumerator enumerator, id data, size_t *count);
+
 #endif
@@ -0,0 +1,630 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <Objectively/FrozenDictionary.h>
+#include <Objectively/Hash.h>
+#include <Objectively/MutableDictionary.h>
+#include <Objectively/Reclaimer.h>
+#include <Objectively/String.h>
+
+#define _Class _FrozenDictionary
+
+/**
+ * @brief The average count of keys per bucket.
+ */
+#define FROZENDICTIONARY_BUCKET_SIZE 4
+
+/**
+ * @brief The displacement flag of buckets whose single key is placed directly.
+ */
+#define DISPLACEMENT_DIRECT 0x80000000u
+
+/**
+ * @brief The count of displacements tried for each bucket before the table is
+ * relaxed.
+ */
+#define FROZENDICTIONARY_MAX_DISPLACEMENT (1u << 20)
+
+/**
+ * @brief The count of times the table is relaxed before giving up.
+ */
+#define FROZENDICTIONARY_MAX_ATTEMPTS 8
+
+#pragma mark - Perfect hash
+
+/**
+ * @return `x` reduced to the range `[0, n)`.
+ */
+static inline size_t reduce(const uint32_t x, const size_t n) {
+	return (size_t) (((uint64_t) x * n) >> 32);
+}
+
+/**
+ * @return The bucket of `hash`.
+ */
+static inline size_t bucketForHash(const FrozenDictionary *self, const uint64_t hash) {
+	return reduce((uint32_t) (hash >> 32), self->buckets);
+}
+
+/**
+ * @return The slot of `hash`, displaced by `displacement`.
+ */
+static inline size_t slotForHash(const FrozenDictionary *self, const uint64_t hash,
+		const uint32_t displacement) {
+
+	if (displacement & DISPLACEMENT_DIRECT) {
+		return displacement & ~DISPLACEMENT_DIRECT;
+	}
+
+	return reduce((uint32_t) HashForInteger64(hash, displacement), self->size);
+}
+
+/**
+ * @brief Allocates the table of `self`, with `size` entries following its
+ * displacements, in a single allocation.
+ */
+static void allocate(FrozenDictionary *self, size_t size) {
+
+	free(self->entries);
+
+	self->size = size;
+	self->buckets = self->dictionary.count / FROZENDICTIONARY_BUCKET_SIZE + 1;
+
+	self->entries = calloc(1, self->size * sizeof(DictionaryEntry) + self->buckets * sizeof(uint32_t));
+	assert(self->entries);
+
+	self->displacements = (uint32_t *) (self->entries + self->size);
+}
+
+/**
+ * @brief qsort comparator for 64 bit hashes.
+ */
+static int compareHashes(const void *a, const void *b) {
+
+	const uint64_t x = *(const uint64_t *) a, y = *(const uint64_t *) b;
+
+	return (x > y) - (x < y);
+}
+
+/**
+ * @return YES if the hashes of `pairs` are distinct, and may therefore be
+ * perfectly hashed.
+ */
+static BOOL isPerfectlyHashable(const DictionaryEntry *pairs, size_t count) {
+
+	uint64_t *hashes = malloc(count * sizeof(uint64_t) + 1);
+	assert(hashes);
+
+	for (size_t i = 0; i < count; i++) {
+		hashes[i] = pairs[i].hash;
+	}
+
+	qsort(hashes, count, sizeof(uint64_t), compareHashes);
+
+	BOOL hashable = YES;
+
+	for (size_t i = 1; i < count; i++) {
+		if (hashes[i] == hashes[i - 1]) {
+			hashable = NO;
+			break;
+		}
+	}
+
+	free(hashes);
+	return hashable;
+}
+
+/**
+ * @brief Builds the perfect hash of `pairs` in a table of `size` entries.
+ *
+ * Buckets are placed in descending order of size, so that the largest buckets
+ * are displaced while most slots are still free. Buckets of one key are placed
+ * directly in the remaining free slots.
+ *
+ * @return YES on success, NO if a bucket could not be displaced.
+ */
+static BOOL build(FrozenDictionary *self, const DictionaryEntry *pairs, size_t size) {
+
+	const size_t count = self->dictionary.count;
+
+	allocate(self, size);
+
+	size_t *starts = calloc(self->buckets + 1, sizeof(size_t));
+	size_t *members = malloc(count * sizeof(size_t) + 1);
+	assert(starts);
+	assert(members);
+
+	for (size_t i = 0; i < count; i++) {
+		starts[bucketForHash(self, pairs[i].hash) + 1]++;
+	}
+
+	size_t largest = 0;
+	for (size_t i = 0; i < self->buckets; i++) {
+		if (starts[i + 1] > largest) {
+			largest = starts[i + 1];
+		}
+		starts[i + 1] += starts[i];
+	}
+
+	size_t *cursors = malloc((self->buckets + largest + 2) * sizeof(size_t));
+	assert(cursors);
+
+	memcpy(cursors, starts, self->buckets * sizeof(size_t));
+
+	for (size_t i = 0; i < count; i++) {
+		members[cursors[bucketForHash(self, pairs[i].hash)]++] = i;
+	}
+
+	size_t *order = cursors, *sizes = cursors + self->buckets;
+	memset(sizes, 0, (largest + 2) * sizeof(size_t));
+
+	for (size_t i = 0; i < self->buckets; i++) {
+		sizes[largest - (starts[i + 1] - starts[i]) + 1]++;
+	}
+
+	for (size_t i = 0; i <= largest; i++) {
+		sizes[i + 1] += sizes[i];
+	}
+
+	for (size_t i = 0; i < self->buckets; i++) {
+		order[sizes[largest - (starts[i + 1] - starts[i])]++] = i;
+	}
+
+	byte *taken = calloc(size + 1, sizeof(byte));
+	size_t *slots = malloc((largest + 1) * sizeof(size_t));
+	assert(taken);
+	assert(slots);
+
+	BOOL built = YES;
+	size_t next = 0;
+
+	for (size_t i = 0; i < self->buckets && built; i++) {
+
+		const size_t bucket = order[i];
+		const size_t *keys = members + starts[bucket];
+		const size_t n = starts[bucket + 1] - starts[bucket];
+
+		if (n == 0) {
+			break;
+		}
+
+		if (n == 1) {
+			while (taken[next]) {
+				next++;
+			}
+
+			taken[next] = 1;
+			slots[0] = next;
+
+			self->displacements[bucket] = DISPLACEMENT_DIRECT | (uint32_t) next;
+		} else {
+
+			uint32_t displacement;
+			for (displacement = 0; displacement < FROZENDICTIONARY_MAX_DISPLACEMENT; displacement++) {
+
+				size_t j;
+				for (j = 0; j < n; j++) {
+					const size_t slot = reduce((uint32_t) HashForInteger64(pairs[keys[j]].hash, displacement), size);
+					if (taken[slot]) {
+						break;
+					}
+					taken[slot] = 1;
+					slots[j] = slot;
+				}
+
+				if (j == n) {
+					break;
+				}
+
+				while (j--) {
+					taken[slots[j]] = 0;
+				}
+			}
+
+			if (displacement == FROZENDICTIONARY_MAX_DISPLACEMENT) {
+				built = NO;
+				break;
+			}
+
+			self->displacements[bucket] = displacement;
+		}
+
+		for (size_t j = 0; j < n; j++) {
+			self->entries[slots[j]] = pairs[keys[j]];
+		}
+	}
+
+	free(slots);
+	free(taken);
+	free(cursors);
+	free(members);
+	free(starts);
+
+	return built;
+}
+
+#pragma mark - ObjectInterface
+
+/**
+ * @see ObjectInterface::copy(const Object *)
+ */
+static Object *copy(const Object *self) {
+
+	const FrozenDictionary *this = (FrozenDictionary *) self;
+
+	FrozenDictionary *that = (FrozenDictionary *) super(Object, alloc(FrozenDictionary), init);
+	if (that) {
+
+		that->dictionary.hashKey = this->dictionary.hashKey;
+		that->dictionary.count = this->dictionary.count;
+		that->dictionary.hashes = this->dictionary.hashes;
+
+		allocate(that, this->size);
+
+		memcpy(that->entries, this->entries, this->size * sizeof(DictionaryEntry) + this->buckets * sizeof(uint32_t));
+
+		for (size_t i = 0; i < that->size; i++) {
+			if (that->entries[i].key) {
+				retain(that->entries[i].key);
+				retain(that->entries[i].obj);
+			}
+		}
+	}
+
+	return (Object *) that;
+}
+
+/**
+ * @see ObjectInterface::dealloc(Object *)
+ */
+static void dealloc(Object *self) {
+
+	FrozenDictionary *this = (FrozenDictionary *) self;
+
+	if (_reclaim(self, this->dictionary.count, dealloc)) {
+		return;
+	}
+
+	for (size_t i = 0; i < this->size; i++) {
+		if (this->entries[i].key) {
+			release(this->entries[i].key);
+			release(this->entries[i].obj);
+		}
+	}
+
+	free(this->entries);
+
+	this->dictionary.count = 0;
+
+	super(Object, self, dealloc);
+}
+
+/**
+ * @see ObjectInterface::hash(const Object *)
+ */
+static int hash(const Object *self) {
+
+	const FrozenDictionary *this = (FrozenDictionary *) self;
+
+	int hash = HashForInteger(HASH_SEED, this->dictionary.count);
+
+	for (size_t i = 0; i < this->size; i++) {
+		if (this->entries[i].key) {
+			hash += HashForObject(HashForObject(HASH_SEED, this->entries[i].key), this->entries[i].obj);
+		}
+	}
+
+	return hash;
+}
+
+#pragma mark - DictionaryInterface
+
+/**
+ * @see DictionaryInterface::enumerateObjectsAndKeys(const Dictionary *, DictionaryEnumerator, id)
+ */
+static void enumerateObjectsAndKeys(const Dictionary *self, DictionaryEnumerator enumerator,
+		id data) {
+
+	assert(enumerator);
+
+	const FrozenDictionary *this = (FrozenDictionary *) self;
+
+	for (size_t i = 0; i < this->size; i++) {
+
+		const DictionaryEntry *entry = this->entries + i;
+		if (entry->key) {
+			if (enumerator(self, entry->obj, entry->key, data)) {
+				return;
+			}
+		}
+	}
+}
+
+/**
+ * @see DictionaryInterface::enumerateObjectsAndKeysConcurrently(const Dictionary *, DictionaryEnumerator, id)
+ */
+static void enumerateObjectsAndKeysConcurrently(const Dictionary *self,
+		DictionaryEnumerator enumerator, id data) {
+
+	const FrozenDictionary *this = (FrozenDictionary *) self;
+
+	_Dictionary_enumerateEntriesConcurrently(self, this->entries, NULL, this->size, enumerator, data);
+}
+
+/**
+ * @see DictionaryInterface::filterObjectsAndKeys(const Dictionary *, DictionaryEnumerator, id)
+ */
+static Dictionary *filterObjectsAndKeys(const Dictionary *self, DictionaryEnumerator enumerator,
+		id data) {
+
+	assert(enumerator);
+
+	const FrozenDictionary *this = (FrozenDictionary *) self;
+
+	MutableDictionary *dictionary = $(alloc(MutableDictionary), initWithCapacityAndHashKey, 0, self->hashKey);
+
+	for (size_t i = 0; i < this->size; i++) {
+
+		const DictionaryEntry *entry = this->entries + i;
+		if (entry->key) {
+			if (enumerator(self, entry->obj, entry->key, data)) {
+				$(dictionary, setObjectForKey, entry->obj, entry->key);
+			}
+		}
+	}
+
+	return (Dictionary *) dictionary;
+}
+
+/**
+ * @see DictionaryInterface::filterObjectsAndKeysConcurrently(const Dictionary *, DictionaryEnumerator, id)
+ */
+static Dictionary *filterObjectsAndKeysConcurrently(const Dictionary *self,
+		DictionaryEnumerator enumerator, id data) {
+
+	const FrozenDictionary *this = (FrozenDictionary *) self;
+
+	size_t count;
+	DictionaryEntry *matches = _Dictionary_filterEntriesConcurrently(self, this->entries, NULL,
+			this->size, enumerator, data, &count);
+
+	MutableDictionary *dictionary = $(alloc(MutableDictionary), initWithCapacityAndHashKey, count, self->hashKey);
+
+	for (size_t i = 0; i < count; i++) {
+
+		DictionaryEntry *entry = _Dictionary_insert((Dictionary *) dictionary, matches[i].hash);
+
+		entry->key = retain(matches[i].key);
+		entry->obj = retain(matches[i].obj);
+	}
+
+	free(matches);
+
+	return (Dictionary *) dictionary;
+}
+
+/**
+ * @see DictionaryInterface::frozenCopy(const Dictionary *)
+ */
+static Dictionary *frozenCopy(const Dictionary *self) {
+
+	return (Dictionary *) retain((Dictionary *) self);
+}
+
+/**
+ * @see DictionaryInterface::nextObjects(const Dictionary *, Cursor *)
+ */
+static size_t nextObjects(const Dictionary *self, Cursor *cursor) {
+
+	const FrozenDictionary *this = (FrozenDictionary *) self;
+
+	_CursorCheckMutations(cursor, &self->mutations);
+
+	cursor->objects = cursor->objectBuffer;
+	cursor->keys = cursor->keyBuffer;
+	cursor->count = 0;
+
+	for (; cursor->state < this->size && cursor->count < CURSOR_BATCH_SIZE; cursor->state++) {
+
+		const DictionaryEntry *entry = this->entries + cursor->state;
+		if (entry->key) {
+			cursor->keys[cursor->count] = entry->key;
+			cursor->objects[cursor->count] = entry->obj;
+			cursor->count++;
+		}
+	}
+
+	return cursor->count;
+}
+
+/**
+ * @see DictionaryInterface::objectForBytes(const Dictionary *, const byte *, size_t)
+ */
+static id objectForBytes(const Dictionary *self, const byte *bytes, size_t length) {
+
+	const FrozenDictionary *this = (FrozenDictionary *) self;
+
+	if (self->count == 0) {
+		return NULL;
+	}
+
+	const uint64_t hash = _String_hashForBytes(self->hashKey, bytes, length);
+	const uint32_t displacement = this->displacements[bucketForHash(this, hash)];
+
+	const DictionaryEntry *entry = this->entries + slotForHash(this, hash, displacement);
+	if (entry->hash == hash && entry->key) {
+		if (_String_isEqualToBytes(entry->key, bytes, length)) {
+			return entry->obj;
+		}
+	}
+
+	return NULL;
+}
+
+/**
+ * @see DictionaryInterface::objectForKey(const Dictionary *, const id)
+ */
+static id objectForKey(const Dictionary *self, const id key) {
+
+	const FrozenDictionary *this = (FrozenDictionary *) self;
+
+	if (self->count == 0) {
+		return NULL;
+	}
+
+	const uint64_t hash = _Dictionary_hashForKey(self, key);
+	const uint32_t displacement = this->displacements[bucketForHash(this, hash)];
+
+	const DictionaryEntry *entry = this->entries + slotForHash(this, hash, displacement);
+	if (entry->hash == hash && entry->key) {
+		if (entry->key == key || $((Object *) entry->key, isEqual, key)) {
+			return entry->obj;
+		}
+	}
+
+	return NULL;
+}
+
+#pragma mark - FrozenDictionaryInterface
+
+/**
+ * @brief DictionaryEnumerator for initWithDictionary.
+ */
+static BOOL initWithDictionary_enumerator(const Dictionary *dict, id obj, id key, id data) {
+
+	FrozenDictionary *this = (FrozenDictionary *) data;
+
+	DictionaryEntry *entry = this->entries + this->size++;
+
+	entry->hash = _Dictionary_hashForKey((Dictionary *) this, key);
+	entry->key = key;
+	entry->obj = obj;
+
+	this->dictionary.hashes += entry->hash;
+
+	return NO;
+}
+
+/**
+ * @see FrozenDictionaryInterface::initWithDictionary(FrozenDictionary *, const Dictionary *)
+ */
+static FrozenDictionary *initWithDictionary(FrozenDictionary *self, const Dictionary *dictionary) {
+
+	assert(dictionary);
+
+	self = (FrozenDictionary *) super(Object, self, init);
+	if (self) {
+
+		const size_t count = dictionary->count;
+		assert(count < DISPLACEMENT_DIRECT);
+
+		self->dictionary.hashKey = dictionary->hashKey;
+
+		self->entries = malloc(count * sizeof(DictionaryEntry) + 1);
+		assert(self->entries);
+
+		$(dictionary, enumerateObjectsAndKeys, initWithDictionary_enumerator, self);
+		assert(self->size == count);
+
+		DictionaryEntry *pairs = self->entries;
+
+		self->entries = NULL;
+		self->dictionary.count = count;
+
+		BOOL built = NO;
+
+		if (isPerfectlyHashable(pairs, count)) {
+
+			size_t size = count;
+			for (int i = 0; i < FROZENDICTIONARY_MAX_ATTEMPTS && built == NO; i++) {
+				built = build(self, pairs, size);
+				size += size / 16 + 1;
+			}
+		}
+
+		free(pairs);
+
+		if (built) {
+			for (size_t i = 0; i < self->size; i++) {
+				if (self->entries[i].key) {
+					retain(self->entries[i].key);
+					retain(self->entries[i].obj);
+				}
+			}
+		} else {
+			free(self->entries);
+
+			self->entries = NULL;
+			self->size = 0;
+			self->dictionary.count = 0;
+
+			release(self);
+			self = NULL;
+		}
+	}
+
+	return self;
+}
+
+#pragma mark - Class lifecycle
+
+/**
+ * @see Class::initialize(Class *)
+ */
+static void initialize(Class *clazz) {
+
+	ObjectInterface *object = (ObjectInterface *) clazz->interface;
+
+	object->copy = copy;
+	object->dealloc = dealloc;
+	object->hash = hash;
+
+	DictionaryInterface *dictionary = (DictionaryInterface *) clazz->interface;
+
+	dictionary->enumerateObjectsAndKeys = enumerateObjectsAndKeys;
+	dictionary->enumerateObjectsAndKeysConcurrently = enumerateObjectsAndKeysConcurrently;
+	dictionary->filterObjectsAndKeys = filterObjectsAndKeys;
+	dictionary->filterObjectsAndKeysConcurrently = filterObjectsAndKeysConcurrently;
+	dictionary->frozenCopy = frozenCopy;
+	dictionary->nextObjects = nextObjects;
+	dictionary->objectForBytes = objectForBytes;
+	dictionary->objectForKey = objectForKey;
+
+	((FrozenDictionaryInterface *) clazz->interface)->initWithDictionary = initWithDictionary;
+}
+
+Class _FrozenDictionary = {
+	.name = "FrozenDictionary",
+	.superclass = &_Dictionary,
+	.instanceSize = sizeof(FrozenDictionary),
+	.interfaceOffset = offsetof(FrozenDictionary, interface),
+	.interfaceSize = sizeof(FrozenDictionaryInterface),
+	.initialize = initialize,
+};
+
+#undef _Class
+
@@ -0,0 +1,133 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef _Objectively_FrozenDictionary_h_
+#define _Objectively_FrozenDictionary_h_
+
+#include <Objectively/Dictionary.h>
+
+/**
+ * @file
+ *
+ * @brief Immutable, perfect-hashed key-value stores.
+ */
+
+typedef struct FrozenDictionary FrozenDictionary;
+typedef struct FrozenDictionaryInterface FrozenDictionaryInterface;
+
+/**
+ * @brief Immutable, perfect-hashed key-value stores.
+ *
+ * FrozenDictionary is built once, from another Dictionary, with a minimal
+ * perfect hash in the style of CHD (compress, hash and displace): keys are
+ * grouped into buckets of about four, and each bucket is assigned a
+ * displacement that places all of its keys in distinct, free slots. Buckets
+ * of a single key are placed directly. A lookup therefore costs one hash, one
+ * displacement, one probe and one equality check.
+ *
+ * The displacements and entries share a single allocation, and a
+ * FrozenDictionary is never modified after it is initialized, so it may be
+ * read from any number of threads.
+ *
+ * @see DictionaryInterface::frozenCopy(const Dictionary *)
+ *
+ * @extends Dictionary
+ *
+ * @ingroup Collections
+ */
+struct FrozenDictionary {
+
+	/**
+	 * @brief The parent.
+	 *
+	 * @private
+	 */
+	Dictionary dictionary;
+
+	/**
+	 * @brief The typed interface.
+	 *
+	 * @private
+	 */
+	FrozenDictionaryInterface *interface;
+
+	/**
+	 * @brief The displacement of each bucket.
+	 *
+	 * @private
+	 */
+	uint32_t *displacements;
+
+	/**
+	 * @brief The count of buckets.
+	 *
+	 * @private
+	 */
+	size_t buckets;
+
+	/**
+	 * @brief The entries, indexed by the perfect hash of their keys. Unused
+	 * entries have `NULL` keys.
+	 *
+	 * @private
+	 */
+	DictionaryEntry *entries;
+
+	/**
+	 * @brief The count of entries, which is `count` unless construction had to
+	 * relax the table.
+	 *
+	 * @private
+	 */
+	size_t size;
+};
+
+/**
+ * @brief The FrozenDictionary interface.
+ */
+struct FrozenDictionaryInterface {
+
+	/**
+	 * @brief The parent interface.
+	 */
+	DictionaryInterface dictionaryInterface;
+
+	/**
+	 * @brief Initializes this FrozenDictionary to contain all pairs from `dictionary`.
+	 *
+	 * @param dictionary A Dictionary.
+	 *
+	 * @return The initialized FrozenDictionary, or `NULL` if the keys of
+	 * `dictionary` can not be perfectly hashed.
+	 *
+	 * @relates FrozenDictionary
+	 */
+	FrozenDictionary *(*initWithDictionary)(FrozenDictionary *self, const Dictionary *dictionary);
+};
+
+/**
+ * @brief The FrozenDictionary Class.
+ */
+extern Class _FrozenDictionary;
+
+#endif
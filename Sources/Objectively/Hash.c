@@ -21,11 +21,94 @@
  * 3. This notice may not be removed or altered from any source distribution.
  */
 
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
 #include <Objectively/Hash.h>
+#include <Objectively/Once.h>
+
+BOOL _keyedHashing;
+
+/**
+ * @brief The mixing constants of HashForBytes64.
+ */
+static const uint64_t _secret[] = {
+	0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull, 0x4b33a62ed433d4a3ull, 0x4d5a2da51de1aa47ull
+};
+
+/**
+ * @brief Multiplies `a` and `b`, storing the low and high 64 bits of the
+ * product in `a` and `b`, respectively.
+ */
+static inline void multiply(uint64_t *a, uint64_t *b) {
+
+#if defined(__SIZEOF_INT128__)
+	const __uint128_t r = (__uint128_t) *a * *b;
+
+	*a = (uint64_t) r;
+	*b = (uint64_t) (r >> 64);
+#else
+	const uint64_t ha = *a >> 32, hb = *b >> 32, la = (uint32_t) *a, lb = (uint32_t) *b;
+	const uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+	const uint64_t t = rl + (rm0 << 32), c = t < rl;
+	const uint64_t lo = t + (rm1 << 32), carry = c + (lo < t);
+
+	*a = lo;
+	*b = rh + (rm0 >> 32) + (rm1 >> 32) + carry;
+#endif
+}
+
+/**
+ * @return The folded 128 bit product of `a` and `b`.
+ */
+static inline uint64_t mix(uint64_t a, uint64_t b) {
+
+	multiply(&a, &b);
+
+	return a ^ b;
+}
+
+/**
+ * @return The 64 bit word at `p`, which may be unaligned.
+ */
+static inline uint64_t read64(const byte *p) {
+	uint64_t v;
+
+	memcpy(&v, p, sizeof(v));
+
+	return v;
+}
+
+/**
+ * @return The little-endian 64 bit word at `p`, which may be unaligned.
+ */
+static inline uint64_t read64le(const byte *p) {
+
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+	return __builtin_bswap64(read64(p));
+#else
+	return read64(p);
+#endif
+}
+
+/**
+ * @return The 32 bit word at `p`, which may be unaligned.
+ */
+static inline uint64_t read32(const byte *p) {
+	uint32_t v;
+
+	memcpy(&v, p, sizeof(v));
+
+	return v;
+}
 
 int HashForBytes(int hash, const byte *bytes, const RANGE range) {
 
-	for (size_t i = range.location; i < range.length; i++) {
+	bytes += range.location;
+
+	for (size_t i = 0; i < range.length; i++) {
 
 		int shift;
 		if (i & 1) {
@@ -63,3 +146,198 @@ int HashForObject(int hash, const id obj) {
 
 	return 0;
 }
+
+uint64_t HashForBytes64(uint64_t seed, const byte *bytes, const RANGE range) {
+
+	const byte *p = bytes + range.location;
+	const size_t length = range.length;
+
+	seed ^= mix(seed ^ _secret[0], _secret[1]);
+
+	uint64_t a, b;
+
+	if (__builtin_expect(length <= 16, 1)) {
+		if (length >= 4) {
+			const size_t offset = (length >> 3) << 2;
+
+			a = (read32(p) << 32) | read32(p + offset);
+			b = (read32(p + length - 4) << 32) | read32(p + length - 4 - offset);
+		} else if (length > 0) {
+			a = (((uint64_t) p[0]) << 16) | (((uint64_t) p[length >> 1]) << 8) | p[length - 1];
+			b = 0;
+		} else {
+			a = b = 0;
+		}
+	} else {
+		size_t i = length;
+
+		if (i >= 48) {
+			uint64_t seed1 = seed, seed2 = seed;
+			do {
+				seed = mix(read64(p) ^ _secret[1], read64(p + 8) ^ seed);
+				seed1 = mix(read64(p + 16) ^ _secret[2], read64(p + 24) ^ seed1);
+				seed2 = mix(read64(p + 32) ^ _secret[3], read64(p + 40) ^ seed2);
+				p += 48;
+				i -= 48;
+			} while (i >= 48);
+
+			seed ^= seed1 ^ seed2;
+		}
+
+		while (i > 16) {
+			seed = mix(read64(p) ^ _secret[1], read64(p + 8) ^ seed);
+			p += 16;
+			i -= 16;
+		}
+
+		a = read64(p + i - 16);
+		b = read64(p + i - 8);
+	}
+
+	a ^= _secret[1];
+	b ^= seed;
+
+	multiply(&a, &b);
+
+	return mix(a ^ _secret[0] ^ length, b ^ _secret[1]);
+}
+
+uint64_t HashForCharacters64(uint64_t seed, const char *chars, const RANGE range) {
+
+	return HashForBytes64(seed, (const byte *) chars, range);
+}
+
+uint64_t HashForInteger64(uint64_t hash, const uint64_t integer) {
+
+	return mix(hash ^ _secret[0], integer ^ _secret[1]);
+}
+
+uint64_t HashForObject64(uint64_t hash, const id obj) {
+
+	if (obj) {
+		return HashForInteger64(hash, $(cast(Object, obj), hash64));
+	}
+
+	return 0;
+}
+
+/**
+ * @return `x` rotated left by `b` bits.
+ */
+static inline uint64_t rotate(const uint64_t x, const int b) {
+	return (x << b) | (x >> (64 - b));
+}
+
+/**
+ * @brief A SipHash round.
+ */
+#define SIPROUND \
+	do { \
+		v0 += v1; v1 = rotate(v1, 13); v1 ^= v0; v0 = rotate(v0, 32); \
+		v2 += v3; v3 = rotate(v3, 16); v3 ^= v2; \
+		v0 += v3; v3 = rotate(v3, 21); v3 ^= v0; \
+		v2 += v1; v1 = rotate(v1, 17); v1 ^= v2; v2 = rotate(v2, 32); \
+	} while (0)
+
+uint64_t HashForBytesWithKey(const HashKey *key, const byte *bytes, const RANGE range) {
+
+	const byte *p = bytes + range.location;
+	const size_t length = range.length;
+
+	uint64_t v0 = key->k0 ^ 0x736f6d6570736575ull;
+	uint64_t v1 = key->k1 ^ 0x646f72616e646f6dull;
+	uint64_t v2 = key->k0 ^ 0x6c7967656e657261ull;
+	uint64_t v3 = key->k1 ^ 0x7465646279746573ull;
+
+	const byte *end = p + (length & ~7);
+	for (; p < end; p += 8) {
+		const uint64_t m = read64le(p);
+
+		v3 ^= m;
+		SIPROUND;
+		v0 ^= m;
+	}
+
+	uint64_t b = ((uint64_t) length) << 56;
+	switch (length & 7) {
+		case 7: b |= ((uint64_t) p[6]) << 48; /* fall through */
+		case 6: b |= ((uint64_t) p[5]) << 40; /* fall through */
+		case 5: b |= ((uint64_t) p[4]) << 32; /* fall through */
+		case 4: b |= ((uint64_t) p[3]) << 24; /* fall through */
+		case 3: b |= ((uint64_t) p[2]) << 16; /* fall through */
+		case 2: b |= ((uint64_t) p[1]) << 8; /* fall through */
+		case 1: b |= ((uint64_t) p[0]);
+	}
+
+	v3 ^= b;
+	SIPROUND;
+	v0 ^= b;
+
+	v2 ^= 0xff;
+	SIPROUND;
+	SIPROUND;
+	SIPROUND;
+
+	return v0 ^ v1 ^ v2 ^ v3;
+}
+
+#undef SIPROUND
+
+uint64_t HashForCharactersWithKey(const HashKey *key, const char *chars, const RANGE range) {
+
+	return HashForBytesWithKey(key, (const byte *) chars, range);
+}
+
+uint64_t HashForObjectWithKey(const HashKey *key, const id obj) {
+
+	if (key == NULL) {
+		return HashForObject64(HASH_SEED, obj);
+	}
+
+	if (obj) {
+		return $(cast(Object, obj), hashWithKey, key);
+	}
+
+	return 0;
+}
+
+static HashKey _processKey;
+
+/**
+ * @brief Generates the HashKey of this process from the system's entropy
+ * source, falling back on the clock and process identifier.
+ */
+static void generateProcessKey(void) {
+
+	FILE *file = fopen("/dev/urandom", "rb");
+	if (file) {
+		const size_t read = fread(&_processKey, sizeof(_processKey), 1, file);
+		fclose(file);
+
+		if (read == 1) {
+			return;
+		}
+	}
+
+	struct timespec ts;
+	clock_gettime(CLOCK_REALTIME, &ts);
+
+	_processKey.k0 = HashForInteger64(ts.tv_sec, ts.tv_nsec);
+	_processKey.k1 = HashForInteger64(_processKey.k0, (uint64_t) getpid() ^ (uintptr_t) &ts);
+}
+
+const HashKey *HashKeyForProcess(void) {
+
+	static Once once;
+
+	DispatchOnce(once, {
+		generateProcessKey();
+	});
+
+	return &_processKey;
+}
+
+const HashKey *HashKeyDefault(void) {
+
+	return _keyedHashing ? HashKeyForProcess() : NULL;
+}
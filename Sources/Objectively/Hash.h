@@ -37,6 +37,27 @@
  */
 #define HASH_SEED 13
 
+/**
+ * @brief A secret 128 bit key for HashForBytesWithKey and friends.
+ *
+ * @remark Hash tables whose keys are untrusted (e.g. parsed from client input)
+ * should bin those keys with a secret HashKey. Otherwise, an attacker may
+ * choose keys that all fall into the same bin, degrading lookups to O(n).
+ */
+struct HashKey {
+	uint64_t k0, k1;
+};
+
+/**
+ * @brief If `YES`, Dictionaries hash their keys with `HashKeyForProcess` by
+ * default. The default is `NO`.
+ *
+ * @remark This is read from `OBJECTIVELY_KEYED_HASH` in the environment at
+ * startup, and may be assigned at any time. Dictionaries retain the HashKey
+ * with which they were initialized.
+ */
+extern BOOL _keyedHashing;
+
 /**
  * @brief Accumulates the hash value of `bytes` into `hash`.
  *
@@ -89,4 +110,95 @@ extern int HashForInteger(int hash, const long integer);
  */
 extern int HashForObject(int hash, const id obj);
 
+/**
+ * @brief Hashes `bytes` to 64 bits.
+ *
+ * @param seed The seed, e.g. `HASH_SEED` or a previous hash value.
+ * @param bytes The bytes to hash.
+ * @param range The RANGE to hash.
+ *
+ * @return The 64 bit hash value.
+ *
+ * @remark This is a wyhash-style hash, which consumes 48 bytes per iteration
+ * in three independent multiply-mix lanes.
+ */
+extern uint64_t HashForBytes64(uint64_t seed, const byte *bytes, const RANGE range);
+
+/**
+ * @brief Hashes `chars` to 64 bits.
+ *
+ * @param seed The seed, e.g. `HASH_SEED` or a previous hash value.
+ * @param chars The characters to hash.
+ * @param range The RANGE to hash.
+ *
+ * @return The 64 bit hash value.
+ */
+extern uint64_t HashForCharacters64(uint64_t seed, const char *chars, const RANGE range);
+
+/**
+ * @brief Accumulates the 64 bit hash value of `integer` into `hash`.
+ *
+ * @param hash The hash accumulator.
+ * @param integer The integer to hash.
+ *
+ * @return The accumulated hash value.
+ */
+extern uint64_t HashForInteger64(uint64_t hash, const uint64_t integer);
+
+/**
+ * @brief Accumulates the 64 bit hash value of `obj` into `hash`.
+ *
+ * @param hash The hash accumulator.
+ * @param obj The Object to hash.
+ *
+ * @return The accumulated hash value.
+ */
+extern uint64_t HashForObject64(uint64_t hash, const id obj);
+
+/**
+ * @brief Hashes `bytes` with SipHash-1-3, keyed by `key`.
+ *
+ * @param key The secret HashKey.
+ * @param bytes The bytes to hash.
+ * @param range The RANGE to hash.
+ *
+ * @return The 64 bit hash value.
+ *
+ * @remark SipHash is a keyed pseudorandom function: without knowledge of
+ * `key`, its outputs can not be predicted, and so collisions can not be
+ * manufactured. It is roughly half the speed of HashForBytes64.
+ */
+extern uint64_t HashForBytesWithKey(const HashKey *key, const byte *bytes, const RANGE range);
+
+/**
+ * @brief Hashes `chars` with SipHash-1-3, keyed by `key`.
+ *
+ * @param key The secret HashKey.
+ * @param chars The characters to hash.
+ * @param range The RANGE to hash.
+ *
+ * @return The 64 bit hash value.
+ */
+extern uint64_t HashForCharactersWithKey(const HashKey *key, const char *chars, const RANGE range);
+
+/**
+ * @brief Hashes `obj`, keyed by `key`.
+ *
+ * @param key The secret HashKey, or `NULL` for HashForObject64.
+ * @param obj The Object to hash.
+ *
+ * @return The 64 bit hash value.
+ */
+extern uint64_t HashForObjectWithKey(const HashKey *key, const id obj);
+
+/**
+ * @return The HashKey of this process, which is randomly generated on first use.
+ */
+extern const HashKey *HashKeyForProcess(void);
+
+/**
+ * @return `HashKeyForProcess()` if `_keyedHashing` is enabled, `NULL` otherwise.
+ */
+extern const HashKey *HashKeyDefault(void);
+
 #endif
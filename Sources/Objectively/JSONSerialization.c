@@ -26,10 +26,11 @@
 #include <string.h>
 
 #include <Objectively/Boolean.h>
+#include <Objectively/Hash.h>
 #include <Objectively/JSONSerialization.h>
 #include <Objectively/MutableData.h>
-#include <Objectively/MutableDictionary.h>
 #include <Objectively/MutableArray.h>
+#include <Objectively/MutableOrderedDictionary.h>
 #include <Objectively/Null.h>
 #include <Objectively/Number.h>
 #include <Objectively/String.h>
@@ -111,7 +112,34 @@ static void writeLabel(JSONWriter *writer, const String *label) {
 }
 
 /**
- * Writes `object` to `writer`.
+ * @brief The state of writeObject_enumerator.
+ */
+typedef struct {
+	JSONWriter *writer;
+	size_t index;
+} JSONObjectWriter;
+
+/**
+ * @brief DictionaryEnumerator for writeObject.
+ */
+static BOOL writeObject_enumerator(const Dictionary *dict, id obj, id key, id data) {
+
+	JSONObjectWriter *objectWriter = (JSONObjectWriter *) data;
+	JSONWriter *writer = objectWriter->writer;
+
+	writeLabel(writer, (String *) key);
+	writeElement(writer, obj);
+
+	if (++objectWriter->index < dict->count) {
+		$(writer->data, appendBytes, (byte *) ", ", 2);
+	}
+
+	return NO;
+}
+
+/**
+ * Writes `object` to `writer`, in the order that `object` enumerates its
+ * pairs. OrderedDictionary objects are therefore written in insertion order.
  *
  * @param object The object (Dictionary) to write.
  */
@@ -119,21 +147,9 @@ static void writeObject(JSONWriter *writer, const Dictionary *object) {
 
 	$(writer->data, appendBytes, (byte * ) "{", 1);
 
-	Array *keys = $(object, allKeys);
-	for (size_t i = 0; i < keys->count; i++) {
-
-		const id key = $(keys, objectAtIndex, i);
-		writeLabel(writer, (String *) key);
-
-		const id obj = $(object, objectForKey, key);
-		writeElement(writer, obj);
+	JSONObjectWriter objectWriter = { .writer = writer };
 
-		if (i < keys->count - 1) {
-			$(writer->data, appendBytes, (byte *) ", ", 2);
-		}
-	}
-
-	release(keys);
+	$(object, enumerateObjectsAndKeys, writeObject_enumerator, &objectWriter);
 
 	$(writer->data, appendBytes, (byte * ) "}", 1);
 }
@@ -359,7 +375,9 @@ static String *readLabel(JSONReader *reader) {
  */
 static Dictionary *readObject(JSONReader *reader) {
 
-	MutableDictionary *object = $(alloc(MutableDictionary), init);
+	const HashKey *hashKey = (reader->options & JSON_READ_KEYED_HASH) ? HashKeyForProcess() : HashKeyDefault();
+
+	MutableOrderedDictionary *object = $(alloc(MutableOrderedDictionary), initWithCapacityAndHashKey, 0, hashKey);
 
 	while (YES) {
 
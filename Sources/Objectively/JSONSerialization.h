@@ -44,6 +44,12 @@
  */
 #define JSON_WRITE_PRETTY 1
 
+/**
+ * @brief Hashes the keys of JSON objects with `HashKeyForProcess()`, which
+ * protects against collision attacks when reading untrusted input.
+ */
+#define JSON_READ_KEYED_HASH 1
+
 typedef struct JSONSerialization JSONSerialization;
 typedef struct JSONSerializationInterface JSONSerializationInterface;
 
@@ -29,6 +29,7 @@
 #include <time.h>
 #include <unistd.h>
 
+#include <Objectively/Arena.h>
 #include <Objectively/Log.h>
 #include <Objectively/Once.h>
 
@@ -64,7 +65,7 @@ static Log *sharedInstance(void) {
 	static Once once;
 
 	DispatchOnce(once, {
-		_sharedInstance = $(alloc(Log), init);
+		WithoutArena(_sharedInstance = $(alloc(Log), init));
 	});
 
 	return _sharedInstance;
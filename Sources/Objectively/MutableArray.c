@@ -70,6 +70,7 @@ static void addObject(MutableArray *self, const id obj) {
 	}
 
 	array->elements[array->count++] = retain(obj);
+	array->mutations++;
 }
 
 /**
@@ -163,6 +164,7 @@ static void removeObjectAtIndex(MutableArray *self, const int index) {
 	}
 
 	self->array.count--;
+	self->array.mutations++;
 }
 
 /**
@@ -178,6 +180,7 @@ static void setObjectAtIndex(MutableArray *self, const id obj, const int index)
 	release(self->array.elements[index]);
 
 	self->array.elements[index] = obj;
+	self->array.mutations++;
 }
 
 /**
@@ -189,6 +192,7 @@ static void sort(MutableArray *self, Comparator comparator) {
 	QsortComparator qsortComparator = (QsortComparator) comparator;
 
 	qsort(self->array.elements, self->array.count, sizeof(id), qsortComparator);
+	self->array.mutations++;
 }
 
 #pragma mark - Class lifecycle
@@ -25,6 +25,7 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <Objectively/Hash.h>
 #include <Objectively/MutableData.h>
 
 #define _Class _MutableData
@@ -44,6 +45,18 @@ static Object *copy(const Object *self) {
 	return (Object *) that;
 }
 
+/**
+ * @see ObjectInterface::hash64(const Object *)
+ */
+static uint64_t hash64(const Object *self) {
+
+	const Data *this = (Data *) self;
+
+	const RANGE range = { 0, this->length };
+
+	return HashForBytes64(HASH_SEED, this->bytes, range);
+}
+
 #pragma mark - MutableDataInterface
 
 /**
@@ -156,6 +169,7 @@ static void initialize(Class *clazz) {
 	ObjectInterface *object = (ObjectInterface *) clazz->interface;
 
 	object->copy = copy;
+	object->hash64 = hash64;
 
 	MutableDataInterface *mutableData = (MutableDataInterface *) clazz->interface;
 
@@ -21,20 +21,13 @@
  * 3. This notice may not be removed or altered from any source distribution.
  */
 
-#include <assert.h>
 #include <stdarg.h>
-#include <stdlib.h>
 
 #include <Objectively/Hash.h>
-#include <Objectively/MutableArray.h>
 #include <Objectively/MutableDictionary.h>
 
 #define _Class _MutableDictionary
 
-#define MUTABLEDICTIONARY_DEFAULT_CAPACITY 64
-#define MUTABLEDICTIONARY_GROW_FACTOR 2.0
-#define MUTABLEDICTIONARY_MAX_LOAD 0.75
-
 #pragma mark - ObjectInterface
 
 /**
@@ -44,7 +37,7 @@ static Object *copy(const Object *self) {
 
 	Dictionary *this = (Dictionary *) self;
 
-	MutableDictionary *copy = $(alloc(MutableDictionary), initWithCapacity, this->capacity);
+	MutableDictionary *copy = $(alloc(MutableDictionary), initWithCapacityAndHashKey, this->count, this->hashKey);
 
 	$(copy, addEntriesFromDictionary, this);
 
@@ -90,7 +83,7 @@ static MutableDictionary *dictionaryWithCapacity(size_t capacity) {
  */
 static MutableDictionary *init(MutableDictionary *self) {
 
-	return $(self, initWithCapacity, MUTABLEDICTIONARY_DEFAULT_CAPACITY);
+	return $(self, initWithCapacity, 0);
 }
 
 /**
@@ -98,35 +91,47 @@ static MutableDictionary *init(MutableDictionary *self) {
  */
 static MutableDictionary *initWithCapacity(MutableDictionary *self, size_t capacity) {
 
+	return $(self, initWithCapacityAndHashKey, capacity, HashKeyDefault());
+}
+
+/**
+ * @see MutableDictionaryInterface::initWithCapacityAndHashKey(MutableDictionary *, size_t, const HashKey *)
+ */
+static MutableDictionary *initWithCapacityAndHashKey(MutableDictionary *self, size_t capacity,
+		const HashKey *key) {
+
 	self = (MutableDictionary *) super(Object, self, init);
 	if (self) {
 
-		self->dictionary.capacity = capacity;
-		if (self->dictionary.capacity) {
+		self->dictionary.hashKey = key;
 
-			self->dictionary.elements = calloc(self->dictionary.capacity, sizeof(id));
-			assert(self->dictionary.elements);
+		if (capacity) {
+			_Dictionary_resize((Dictionary *) self, capacity);
 		}
 	}
 
 	return self;
 }
 
+/**
+ * @brief DictionaryEnumerator for removeAllObjects.
+ */
+static BOOL removeAllObjects_enumerator(const Dictionary *dict, id obj, id key, id data) {
+
+	release(key);
+	release(obj);
+
+	return NO;
+}
+
 /**
  * @see MutableDictionaryInterface::removeAllObjects(MutableDictionary *)
  */
 static void removeAllObjects(MutableDictionary *self) {
 
-	for (size_t i = 0; i < self->dictionary.capacity; i++) {
-
-		Array *array = self->dictionary.elements[i];
-		if (array) {
-			release(array);
-			self->dictionary.elements[i] = NULL;
-		}
-	}
+	$((Dictionary *) self, enumerateObjectsAndKeys, removeAllObjects_enumerator, NULL);
 
-	self->dictionary.count = 0;
+	_Dictionary_clear((Dictionary *) self);
 }
 
 /**
@@ -134,69 +139,29 @@ static void removeAllObjects(MutableDictionary *self) {
  */
 static void removeObjectForKey(MutableDictionary *self, const id key) {
 
-	const size_t bin = HashForObject(HASH_SEED, key) % self->dictionary.capacity;
-
-	MutableArray *array = self->dictionary.elements[bin];
-	if (array) {
+	Dictionary *dict = (Dictionary *) self;
 
-		int index = $((Array *) array, indexOfObject, key);
-		if (index > -1) {
+	DictionaryEntry *entry = _Dictionary_find(dict, key, _Dictionary_hashForKey(dict, key));
+	if (entry) {
 
-			$(array, removeObjectAtIndex, index);
-			$(array, removeObjectAtIndex, index);
+		id k = entry->key, obj = entry->obj;
 
-			if (((Array *) array)->count == 0) {
-				release(array);
-				self->dictionary.elements[bin] = NULL;
-			}
+		_Dictionary_erase(dict, entry);
 
-			self->dictionary.count--;
-		}
+		release(k);
+		release(obj);
 	}
 }
 
 /**
- * @brief A helper for resizing Dictionaries as pairs are added to them.
- *
- * @remark Static method invocations are used for all operations.
+ * @see MutableDictionaryInterface::reserve(MutableDictionary *, size_t)
  */
-static void setObjectForKey_resize(Dictionary *dict) {
-
-	if (dict->capacity) {
+static void reserve(MutableDictionary *self, size_t count) {
 
-		const float load = dict->count / dict->capacity;
-		if (load >= MUTABLEDICTIONARY_MAX_LOAD) {
-
-			size_t capacity = dict->capacity;
-			id *elements = dict->elements;
-
-			dict->capacity = dict->capacity * MUTABLEDICTIONARY_GROW_FACTOR;
-			dict->count = 0;
-
-			dict->elements = calloc(dict->capacity, sizeof(id));
-			assert(dict->elements);
-
-			for (size_t i = 0; i < capacity; i++) {
-
-				Array *array = elements[i];
-				if (array) {
-
-					for (size_t j = 0; j < array->count; j += 2) {
-
-						id key = $(array, objectAtIndex, j);
-						id obj = $(array, objectAtIndex, j + 1);
-
-						$$(MutableDictionary, setObjectForKey, (MutableDictionary *) dict, obj, key);
-					}
-
-					release(array);
-				}
-			}
+	Dictionary *dict = (Dictionary *) self;
 
-			free(elements);
-		}
-	} else {
-		$$(MutableDictionary, initWithCapacity, (MutableDictionary *) dict, MUTABLEDICTIONARY_DEFAULT_CAPACITY);
+	if (count > dict->count + dict->growth) {
+		_Dictionary_resize(dict, count);
 	}
 }
 
@@ -207,23 +172,19 @@ static void setObjectForKey(MutableDictionary *self, const id obj, const id key)
 
 	Dictionary *dict = (Dictionary *) self;
 
-	setObjectForKey_resize(dict);
+	const uint64_t hash = _Dictionary_hashForKey(dict, key);
 
-	const size_t bin = HashForObject(HASH_SEED, key) % dict->capacity;
+	DictionaryEntry *entry = _Dictionary_find(dict, key, hash);
+	if (entry) {
+		id old = entry->obj;
+		entry->obj = retain(obj);
+		release(old);
 
-	MutableArray *array = dict->elements[bin];
-	if (array == NULL) {
-		array = dict->elements[bin] = $(alloc(MutableArray), init);
-	}
-
-	const int index = $((Array *) array, indexOfObject, key);
-	if (index > -1) {
-		$(array, setObjectAtIndex, obj, index + 1);
+		dict->mutations++;
 	} else {
-		$(array, addObject, key);
-		$(array, addObject, obj);
-
-		dict->count++;
+		entry = _Dictionary_insert(dict, hash);
+		entry->key = retain(key);
+		entry->obj = retain(obj);
 	}
 }
 
@@ -250,6 +211,14 @@ static void setObjectsForKeys(MutableDictionary *self, ...) {
 	va_end(args);
 }
 
+/**
+ * @see MutableDictionaryInterface::shrinkToFit(MutableDictionary *)
+ */
+static void shrinkToFit(MutableDictionary *self) {
+
+	_Dictionary_resize((Dictionary *) self, 0);
+}
+
 #pragma mark - Class lifecycle
 
 /**
@@ -268,10 +237,13 @@ static void initialize(Class *clazz) {
 	mutableDictionary->dictionaryWithCapacity = dictionaryWithCapacity;
 	mutableDictionary->init = init;
 	mutableDictionary->initWithCapacity = initWithCapacity;
+	mutableDictionary->initWithCapacityAndHashKey = initWithCapacityAndHashKey;
 	mutableDictionary->removeAllObjects = removeAllObjects;
 	mutableDictionary->removeObjectForKey = removeObjectForKey;
+	mutableDictionary->reserve = reserve;
 	mutableDictionary->setObjectForKey = setObjectForKey;
 	mutableDictionary->setObjectsForKeys = setObjectsForKeys;
+	mutableDictionary->shrinkToFit = shrinkToFit;
 }
 
 Class _MutableDictionary = {
@@ -115,6 +115,23 @@ struct MutableDictionaryInterface {
 	 */
 	MutableDictionary *(*initWithCapacity)(MutableDictionary *self, size_t capacity);
 
+	/**
+	 * @brief Initializes this MutableDictionary with the specified capacity and
+	 * HashKey.
+	 *
+	 * @param capacity The initial capacity.
+	 * @param key The secret HashKey with which to bin keys, e.g.
+	 * `HashKeyForProcess()` for untrusted keys, or `NULL` for unkeyed hashing.
+	 *
+	 * @return The initialized MutableDictionary, or `NULL` on error.
+	 *
+	 * @remark Copies of this MutableDictionary retain `key`.
+	 *
+	 * @relates MutableDictionary
+	 */
+	MutableDictionary *(*initWithCapacityAndHashKey)(MutableDictionary *self, size_t capacity,
+			const HashKey *key);
+
 	/**
 	 * @brief Removes all Objects from this MutableDictionary.
 	 *
@@ -129,6 +146,16 @@ struct MutableDictionaryInterface {
 	 */
 	void (*removeObjectForKey)(MutableDictionary *self, const id key);
 
+	/**
+	 * @brief Ensures that this MutableDictionary may hold `count` elements without
+	 * resizing, e.g. before adding a known number of elements in bulk.
+	 *
+	 * @param count The count of elements.
+	 *
+	 * @relates MutableDictionary
+	 */
+	void (*reserve)(MutableDictionary *self, size_t count);
+
 	/**
 	 * @brief Sets a pair in this MutableDictionary.
 	 *
@@ -142,6 +169,14 @@ struct MutableDictionaryInterface {
 	 * @relates MutableDictionary
 	 */
 	void (*setObjectsForKeys)(MutableDictionary *self, ...);
+
+	/**
+	 * @brief Resizes this MutableDictionary to the smallest capacity that holds its
+	 * elements, e.g. to return memory after removing many of them.
+	 *
+	 * @relates MutableDictionary
+	 */
+	void (*shrinkToFit)(MutableDictionary *self);
 };
 
 /**
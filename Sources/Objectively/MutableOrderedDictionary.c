@@ -0,0 +1,256 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <stdarg.h>
+
+#include <Objectively/Hash.h>
+#include <Objectively/MutableOrderedDictionary.h>
+
+#define _Class _MutableOrderedDictionary
+
+#pragma mark - ObjectInterface
+
+/**
+ * @see ObjectInterface::copy(const Object *)
+ */
+static Object *copy(const Object *self) {
+
+	const Dictionary *this = (Dictionary *) self;
+
+	MutableOrderedDictionary *copy = $(alloc(MutableOrderedDictionary), initWithCapacityAndHashKey, this->count, this->hashKey);
+
+	$(copy, addEntriesFromDictionary, this);
+
+	return (Object *) copy;
+}
+
+#pragma mark - MutableOrderedDictionaryInterface
+
+/**
+ * @brief DictionaryEnumerator for addEntriesFromDictionary.
+ */
+static BOOL addEntriesFromDictionary_enumerator(const Dictionary *dict, id obj, id key, id data) {
+
+	$((MutableOrderedDictionary *) data, setObjectForKey, obj, key); return NO;
+}
+
+/**
+ * @see MutableOrderedDictionaryInterface::addEntriesFromDictionary(MutableOrderedDictionary *, const Dictionary *)
+ */
+static void addEntriesFromDictionary(MutableOrderedDictionary *self, const Dictionary *dictionary) {
+
+	$(dictionary, enumerateObjectsAndKeys, addEntriesFromDictionary_enumerator, self);
+}
+
+/**
+ * @see MutableOrderedDictionaryInterface::dictionary(void)
+ */
+static MutableOrderedDictionary *dictionary(void) {
+
+	return $(alloc(MutableOrderedDictionary), init);
+}
+
+/**
+ * @see MutableOrderedDictionaryInterface::dictionaryWithCapacity(size_t)
+ */
+static MutableOrderedDictionary *dictionaryWithCapacity(size_t capacity) {
+
+	return $(alloc(MutableOrderedDictionary), initWithCapacity, capacity);
+}
+
+/**
+ * @see MutableOrderedDictionaryInterface::init(MutableOrderedDictionary *)
+ */
+static MutableOrderedDictionary *init(MutableOrderedDictionary *self) {
+
+	return $(self, initWithCapacity, 0);
+}
+
+/**
+ * @see MutableOrderedDictionaryInterface::initWithCapacity(MutableOrderedDictionary *, size_t)
+ */
+static MutableOrderedDictionary *initWithCapacity(MutableOrderedDictionary *self, size_t capacity) {
+
+	return $(self, initWithCapacityAndHashKey, capacity, HashKeyDefault());
+}
+
+/**
+ * @see MutableOrderedDictionaryInterface::initWithCapacityAndHashKey(MutableOrderedDictionary *, size_t, const HashKey *)
+ */
+static MutableOrderedDictionary *initWithCapacityAndHashKey(MutableOrderedDictionary *self, size_t capacity,
+		const HashKey *key) {
+
+	self = (MutableOrderedDictionary *) super(Object, self, init);
+	if (self) {
+
+		self->orderedDictionary.dictionary.hashKey = key;
+
+		if (capacity) {
+			_OrderedDictionary_reserve((OrderedDictionary *) self, capacity);
+		}
+	}
+
+	return self;
+}
+
+/**
+ * @brief DictionaryEnumerator for removeAllObjects.
+ */
+static BOOL removeAllObjects_enumerator(const Dictionary *dict, id obj, id key, id data) {
+
+	release(key);
+	release(obj);
+
+	return NO;
+}
+
+/**
+ * @see MutableOrderedDictionaryInterface::removeAllObjects(MutableOrderedDictionary *)
+ */
+static void removeAllObjects(MutableOrderedDictionary *self) {
+
+	$((Dictionary *) self, enumerateObjectsAndKeys, removeAllObjects_enumerator, NULL);
+
+	_OrderedDictionary_clear((OrderedDictionary *) self);
+}
+
+/**
+ * @see MutableOrderedDictionaryInterface::removeObjectForKey(MutableOrderedDictionary *, const id)
+ */
+static void removeObjectForKey(MutableOrderedDictionary *self, const id key) {
+
+	OrderedDictionary *dict = (OrderedDictionary *) self;
+
+	const uint64_t hash = _Dictionary_hashForKey((Dictionary *) dict, key);
+
+	DictionaryEntry *entry = _OrderedDictionary_find(dict, key, hash);
+	if (entry) {
+
+		id k = entry->key, obj = entry->obj;
+
+		_OrderedDictionary_erase(dict, entry);
+
+		release(k);
+		release(obj);
+	}
+}
+
+/**
+ * @see MutableOrderedDictionaryInterface::reserve(MutableOrderedDictionary *, size_t)
+ */
+static void reserve(MutableOrderedDictionary *self, size_t count) {
+
+	_OrderedDictionary_reserve((OrderedDictionary *) self, count);
+}
+
+/**
+ * @see MutableOrderedDictionaryInterface::setObjectForKey(MutableOrderedDictionary *, const id, const id)
+ */
+static void setObjectForKey(MutableOrderedDictionary *self, const id obj, const id key) {
+
+	OrderedDictionary *dict = (OrderedDictionary *) self;
+
+	const uint64_t hash = _Dictionary_hashForKey((Dictionary *) dict, key);
+
+	DictionaryEntry *entry = _OrderedDictionary_find(dict, key, hash);
+	if (entry) {
+		id old = entry->obj;
+		entry->obj = retain(obj);
+		release(old);
+
+		dict->dictionary.mutations++;
+	} else {
+		entry = _OrderedDictionary_insert(dict, hash);
+		entry->key = retain(key);
+		entry->obj = retain(obj);
+	}
+}
+
+/**
+ * @see MutableOrderedDictionaryInterface::setObjectsForKeys(MutableOrderedDictionary *, ...)
+ */
+static void setObjectsForKeys(MutableOrderedDictionary *self, ...) {
+
+	va_list args;
+	va_start(args, self);
+
+	while (YES) {
+
+		id obj = va_arg(args, id);
+		if (obj) {
+
+			id key = va_arg(args, id);
+			$(self, setObjectForKey, obj, key);
+		} else {
+			break;
+		}
+	}
+
+	va_end(args);
+}
+
+/**
+ * @see MutableOrderedDictionaryInterface::shrinkToFit(MutableOrderedDictionary *)
+ */
+static void shrinkToFit(MutableOrderedDictionary *self) {
+
+	_OrderedDictionary_compact((OrderedDictionary *) self);
+}
+
+#pragma mark - Class lifecycle
+
+/**
+ * @see Class::initialize(Class *)
+ */
+static void initialize(Class *clazz) {
+
+	ObjectInterface *object = (ObjectInterface *) clazz->interface;
+
+	object->copy = copy;
+
+	MutableOrderedDictionaryInterface *mutableDictionary = (MutableOrderedDictionaryInterface *) clazz->interface;
+
+	mutableDictionary->addEntriesFromDictionary = addEntriesFromDictionary;
+	mutableDictionary->dictionary = dictionary;
+	mutableDictionary->dictionaryWithCapacity = dictionaryWithCapacity;
+	mutableDictionary->init = init;
+	mutableDictionary->initWithCapacity = initWithCapacity;
+	mutableDictionary->initWithCapacityAndHashKey = initWithCapacityAndHashKey;
+	mutableDictionary->removeAllObjects = removeAllObjects;
+	mutableDictionary->removeObjectForKey = removeObjectForKey;
+	mutableDictionary->reserve = reserve;
+	mutableDictionary->setObjectForKey = setObjectForKey;
+	mutableDictionary->setObjectsForKeys = setObjectsForKeys;
+	mutableDictionary->shrinkToFit = shrinkToFit;
+}
+
+Class _MutableOrderedDictionary = {
+	.name = "MutableOrderedDictionary",
+	.superclass = &_OrderedDictionary,
+	.instanceSize = sizeof(MutableOrderedDictionary),
+	.interfaceOffset = offsetof(MutableOrderedDictionary, interface),
+	.interfaceSize = sizeof(MutableOrderedDictionaryInterface),
+	.initialize = initialize,
+};
+
+#undef _Class
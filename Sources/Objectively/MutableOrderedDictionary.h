@@ -0,0 +1,192 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef _Objectively_MutableOrderedDictionary_h_
+#define _Objectively_MutableOrderedDictionary_h_
+
+#include <Objectively/OrderedDictionary.h>
+
+/**
+ * @file
+ *
+ * @brief Mutable key-value stores that retain insertion order.
+ */
+
+typedef struct MutableOrderedDictionaryInterface MutableOrderedDictionaryInterface;
+
+/**
+ * @brief Mutable key-value stores that retain insertion order.
+ *
+ * @extends OrderedDictionary
+ *
+ * @ingroup Collections
+ */
+struct MutableOrderedDictionary {
+
+	/**
+	 * @brief The parent.
+	 *
+	 * @private
+	 */
+	OrderedDictionary orderedDictionary;
+
+	/**
+	 * @brief The typed interface.
+	 *
+	 * @private
+	 */
+	MutableOrderedDictionaryInterface *interface;
+};
+
+/**
+ * @brief The MutableOrderedDictionary interface.
+ */
+struct MutableOrderedDictionaryInterface {
+
+	/**
+	 * @brief The parent.
+	 */
+	OrderedDictionaryInterface orderedDictionaryInterface;
+
+	/**
+	 * @brief Adds the key-value entries from `dictionary` to this MutableOrderedDictionary,
+	 * in the order that `dictionary` enumerates them.
+	 *
+	 * @param dictionary A Dictionary.
+	 */
+	void (*addEntriesFromDictionary)(MutableOrderedDictionary *self, const Dictionary *dictionary);
+
+	/**
+	 * @brief Returns a new MutableOrderedDictionary.
+	 *
+	 * @return The new MutableOrderedDictionary, or `NULL` on error.
+	 *
+	 * @relates MutableOrderedDictionary
+	 */
+	MutableOrderedDictionary *(*dictionary)(void);
+
+	/**
+	 * @brief Returns a new MutableOrderedDictionary with the given `capacity`.
+	 *
+	 * @param capacity The desired initial capacity.
+	 *
+	 * @return The new MutableOrderedDictionary, or `NULL` on error.
+	 *
+	 * @relates MutableOrderedDictionary
+	 */
+	MutableOrderedDictionary *(*dictionaryWithCapacity)(size_t capacity);
+
+	/**
+	 * @brief Initializes this MutableOrderedDictionary.
+	 *
+	 * @return The initialized MutableOrderedDictionary, or `NULL` on error.
+	 *
+	 * @relates MutableOrderedDictionary
+	 */
+	MutableOrderedDictionary *(*init)(MutableOrderedDictionary *self);
+
+	/**
+	 * @brief Initializes this MutableOrderedDictionary with the specified capacity.
+	 *
+	 * @param capacity The initial capacity.
+	 *
+	 * @return The initialized MutableOrderedDictionary, or `NULL` on error.
+	 *
+	 * @relates MutableOrderedDictionary
+	 */
+	MutableOrderedDictionary *(*initWithCapacity)(MutableOrderedDictionary *self, size_t capacity);
+
+	/**
+	 * @brief Initializes this MutableOrderedDictionary with the specified capacity and
+	 * HashKey.
+	 *
+	 * @param capacity The initial capacity.
+	 * @param key The secret HashKey with which to bin keys, e.g.
+	 * `HashKeyForProcess()` for untrusted keys, or `NULL` for unkeyed hashing.
+	 *
+	 * @return The initialized MutableOrderedDictionary, or `NULL` on error.
+	 *
+	 * @remark Copies of this MutableOrderedDictionary retain `key`.
+	 *
+	 * @relates MutableOrderedDictionary
+	 */
+	MutableOrderedDictionary *(*initWithCapacityAndHashKey)(MutableOrderedDictionary *self, size_t capacity,
+			const HashKey *key);
+
+	/**
+	 * @brief Removes all Objects from this MutableOrderedDictionary.
+	 *
+	 * @relates MutableOrderedDictionary
+	 */
+	void (*removeAllObjects)(MutableOrderedDictionary *self);
+
+	/**
+	 * @brief Removes the specified Object from this MutableOrderedDictionary.
+	 *
+	 * @relates MutableOrderedDictionary
+	 */
+	void (*removeObjectForKey)(MutableOrderedDictionary *self, const id key);
+
+	/**
+	 * @brief Ensures that this MutableOrderedDictionary may hold `count` elements without
+	 * resizing, e.g. before adding a known number of elements in bulk.
+	 *
+	 * @param count The count of elements.
+	 *
+	 * @relates MutableOrderedDictionary
+	 */
+	void (*reserve)(MutableOrderedDictionary *self, size_t count);
+
+	/**
+	 * @brief Sets a pair in this MutableOrderedDictionary.
+	 *
+	 * @remark New keys are appended. Replacing the Object of an existing key
+	 * retains its position.
+	 *
+	 * @relates MutableOrderedDictionary
+	 */
+	void (*setObjectForKey)(MutableOrderedDictionary *self, const id obj, const id key);
+
+	/**
+	 * @brief Sets pairs in this MutableOrderedDictionary from the NULL-terminated list.
+	 *
+	 * @relates MutableOrderedDictionary
+	 */
+	void (*setObjectsForKeys)(MutableOrderedDictionary *self, ...);
+
+	/**
+	 * @brief Resizes this MutableOrderedDictionary to the smallest capacity that holds its
+	 * elements, e.g. to return memory after removing many of them. The holes left
+	 * by removed elements are compacted.
+	 *
+	 * @relates MutableOrderedDictionary
+	 */
+	void (*shrinkToFit)(MutableOrderedDictionary *self);
+};
+
+/**
+ * @brief The MutableOrderedDictionary Class.
+ */
+extern Class _MutableOrderedDictionary;
+
+#endif
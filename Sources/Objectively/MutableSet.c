@@ -23,18 +23,11 @@
 
 #include <assert.h>
 #include <stdarg.h>
-#include <stdlib.h>
 
-#include <Objectively/Hash.h>
-#include <Objectively/MutableArray.h>
 #include <Objectively/MutableSet.h>
 
 #define _Class _MutableSet
 
-#define MUTABLESET_DEFAULT_CAPACITY 64
-#define MUTABLESET_GROW_FACTOR 2.0
-#define MUTABLESET_MAX_LOAD 0.75
-
 #pragma mark - ObjectInterface
 
 /**
@@ -44,7 +37,7 @@ static Object *copy(const Object *self) {
 
 	Set *this = (Set *) self;
 
-	MutableSet *copy = $(alloc(MutableSet), initWithCapacity, this->capacity);
+	MutableSet *copy = $(alloc(MutableSet), initWithCapacity, this->count);
 
 	$(copy, addObjectsFromSet, this);
 
@@ -53,43 +46,6 @@ static Object *copy(const Object *self) {
 
 #pragma mark - MutableSetInterface
 
-/**
- * @brief A helper for resizing Sets as Objects are added to them.
- *
- * @remark Static method invocations are used for all operations.
- */
-static void addObject_resize(Set *set) {
-
-	if (set->capacity) {
-
-		const float load = set->count / set->capacity;
-		if (load >= MUTABLESET_MAX_LOAD) {
-
-			size_t capacity = set->capacity;
-			id *elements = set->elements;
-
-			set->capacity = set->capacity * MUTABLESET_GROW_FACTOR;
-			set->count = 0;
-
-			set->elements = calloc(set->capacity, sizeof(id));
-			assert(set->elements);
-
-			for (size_t i = 0; i < capacity; i++) {
-
-				Array *array = elements[i];
-				if (array) {
-					$$(MutableSet, addObjectsFromArray, (MutableSet *) set, array);
-					release(array);
-				}
-			}
-
-			free(elements);
-		}
-	} else {
-		$$(MutableSet, initWithCapacity, (MutableSet *) set, MUTABLESET_DEFAULT_CAPACITY);
-	}
-}
-
 /**
  * @see MutableSetInterface::addObject(MutableSet *, const id)
  */
@@ -97,18 +53,10 @@ static void addObject(MutableSet *self, const id obj) {
 
 	Set *set = (Set *) self;
 
-	addObject_resize(set);
-
-	const size_t bin = HashForObject(HASH_SEED, obj) % set->capacity;
+	const uint64_t hash = _Set_hashForObject(set, obj);
 
-	MutableArray *array = set->elements[bin];
-	if (array == NULL) {
-		array = set->elements[bin] = $(alloc(MutableArray), init);
-	}
-
-	if ($((Array *) array, containsObject, obj) == NO) {
-		$(array, addObject, obj);
-		set->count++;
+	if (_Set_find(set, obj, hash) == NULL) {
+		_Set_insert(set, hash)->obj = retain(obj);
 	}
 }
 
@@ -124,21 +72,13 @@ static void addObjectsFromArray(MutableSet *self, const Array *array) {
 	}
 }
 
-/**
- * @brief SetEnumerator for addObjectsFromSet.
- */
-static BOOL addObjectsFromSet_enumerator(const Set *set, id obj, id data) {
-
-	$((MutableSet *) data, addObject, obj); return NO;
-}
-
 /**
  * @see MutableSetInterface::addEntriesFromSet(MutableSet *, const Set *)
  */
 static void addObjectsFromSet(MutableSet *self, const Set *set) {
 
 	if (set) {
-		$(set, enumerateObjects, addObjectsFromSet_enumerator, self);
+		_Set_union((Set *) self, set);
 	}
 }
 
@@ -147,7 +87,7 @@ static void addObjectsFromSet(MutableSet *self, const Set *set) {
  */
 static MutableSet *init(MutableSet *self) {
 
-	return $(self, initWithCapacity, MUTABLESET_DEFAULT_CAPACITY);
+	return $(self, initWithCapacity, 0);
 }
 
 /**
@@ -158,32 +98,50 @@ static MutableSet *initWithCapacity(MutableSet *self, size_t capacity) {
 	self = (MutableSet *) super(Object, self, init);
 	if (self) {
 
-		self->set.capacity = capacity;
-		if (self->set.capacity) {
-
-			self->set.elements = calloc(self->set.capacity, sizeof(id));
-			assert(self->set.elements);
+		if (capacity) {
+			_Set_resize((Set *) self, capacity);
 		}
 	}
 
 	return self;
 }
 
+/**
+ * @see MutableSetInterface::intersectSet(MutableSet *, const Set *)
+ */
+static void intersectSet(MutableSet *self, const Set *set) {
+
+	assert(set);
+
+	_Set_intersect((Set *) self, set);
+}
+
+/**
+ * @see MutableSetInterface::minusSet(MutableSet *, const Set *)
+ */
+static void minusSet(MutableSet *self, const Set *set) {
+
+	assert(set);
+
+	_Set_minus((Set *) self, set);
+}
+
+/**
+ * @brief SetEnumerator for removeAllObjects.
+ */
+static BOOL removeAllObjects_enumerator(const Set *set, id obj, id data) {
+
+	release(obj); return NO;
+}
+
 /**
  * @see MutableSetInterface::removeAllObjects(MutableSet *)
  */
 static void removeAllObjects(MutableSet *self) {
 
-	for (size_t i = 0; i < self->set.capacity; i++) {
+	$((Set *) self, enumerateObjects, removeAllObjects_enumerator, NULL);
 
-		Array *array = self->set.elements[i];
-		if (array) {
-			release(array);
-			self->set.elements[i] = NULL;
-		}
-	}
-
-	self->set.count = 0;
+	_Set_clear((Set *) self);
 }
 
 /**
@@ -191,23 +149,28 @@ static void removeAllObjects(MutableSet *self) {
  */
 static void removeObject(MutableSet *self, const id obj) {
 
-	const size_t bin = HashForObject(HASH_SEED, obj) % self->set.capacity;
+	Set *set = (Set *) self;
 
-	MutableArray *array = self->set.elements[bin];
-	if (array) {
+	SetEntry *entry = _Set_find(set, obj, _Set_hashForObject(set, obj));
+	if (entry) {
 
-		int index = $((Array *) array, indexOfObject, obj);
-		if (index > -1) {
+		id that = entry->obj;
 
-			$(array, removeObjectAtIndex, index);
+		_Set_erase(set, entry);
 
-			if (((Array *) array)->count == 0) {
-				release(array);
-				self->set.elements[bin] = NULL;
-			}
+		release(that);
+	}
+}
 
-			self->set.count--;
-		}
+/**
+ * @see MutableSetInterface::reserve(MutableSet *, size_t)
+ */
+static void reserve(MutableSet *self, size_t count) {
+
+	Set *set = (Set *) self;
+
+	if (count > set->count + set->growth) {
+		_Set_resize(set, count);
 	}
 }
 
@@ -227,6 +190,24 @@ static MutableSet *setWithCapacity(size_t capacity) {
 	return $(alloc(MutableSet), initWithCapacity, capacity);
 }
 
+/**
+ * @see MutableSetInterface::shrinkToFit(MutableSet *)
+ */
+static void shrinkToFit(MutableSet *self) {
+
+	_Set_resize((Set *) self, 0);
+}
+
+/**
+ * @see MutableSetInterface::unionSet(MutableSet *, const Set *)
+ */
+static void unionSet(MutableSet *self, const Set *set) {
+
+	assert(set);
+
+	_Set_union((Set *) self, set);
+}
+
 #pragma mark - Class lifecycle
 
 /**
@@ -245,10 +226,15 @@ static void initialize(Class *clazz) {
 	mutableSet->addObjectsFromSet = addObjectsFromSet;
 	mutableSet->init = init;
 	mutableSet->initWithCapacity = initWithCapacity;
+	mutableSet->intersectSet = intersectSet;
+	mutableSet->minusSet = minusSet;
 	mutableSet->removeAllObjects = removeAllObjects;
 	mutableSet->removeObject = removeObject;
+	mutableSet->reserve = reserve;
 	mutableSet->set = set;
 	mutableSet->setWithCapacity = setWithCapacity;
+	mutableSet->shrinkToFit = shrinkToFit;
+	mutableSet->unionSet = unionSet;
 }
 
 Class _MutableSet = {
@@ -116,6 +116,26 @@ struct MutableSetInterface {
 	 */
 	MutableSet *(*initWithCapacity)(MutableSet *self, size_t capacity);
 
+	/**
+	 * @brief Removes the Objects of this Set that are not in `set`.
+	 *
+	 * @param set A Set.
+	 *
+	 * @relates MutableSet
+	 */
+	void (*intersectSet)(MutableSet *self, const Set *set);
+
+	/**
+	 * @brief Removes the Objects of this Set that are in `set`.
+	 *
+	 * @param set A Set.
+	 *
+	 * @remark The smaller of the two Sets is enumerated, and the larger probed.
+	 *
+	 * @relates MutableSet
+	 */
+	void (*minusSet)(MutableSet *self, const Set *set);
+
 	/**
 	 * @brief Removes all Objects from this Set.
 	 *
@@ -132,6 +152,16 @@ struct MutableSetInterface {
 	 */
 	void (*removeObject)(MutableSet *self, const id obj);
 
+	/**
+	 * @brief Ensures that this MutableSet may hold `count` elements without
+	 * resizing, e.g. before adding a known number of elements in bulk.
+	 *
+	 * @param count The count of elements.
+	 *
+	 * @relates MutableSet
+	 */
+	void (*reserve)(MutableSet *self, size_t count);
+
 	/**
 	 * @brief Returns a new MutableSet.
 	 *
@@ -151,6 +181,25 @@ struct MutableSetInterface {
 	 * @relates MutableSet
 	 */
 	MutableSet *(*setWithCapacity)(size_t capacity);
+
+	/**
+	 * @brief Resizes this MutableSet to the smallest capacity that holds its
+	 * elements, e.g. to return memory after removing many of them.
+	 *
+	 * @relates MutableSet
+	 */
+	void (*shrinkToFit)(MutableSet *self);
+
+	/**
+	 * @brief Adds the Objects of `set` that are not already in this Set.
+	 *
+	 * @param set A Set.
+	 *
+	 * @remark Equivalent to `addObjectsFromSet`.
+	 *
+	 * @relates MutableSet
+	 */
+	void (*unionSet)(MutableSet *self, const Set *set);
 };
 
 /**
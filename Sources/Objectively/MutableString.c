@@ -30,6 +30,7 @@
 #include <stdio.h>
 #include <string.h>
 
+#include <Objectively/Hash.h>
 #include <Objectively/MutableString.h>
 
 #define _Class _MutableString
@@ -46,6 +47,18 @@ static Object *copy(const Object *self) {
 	return (Object *) $(alloc(MutableString), initWithString, this);
 }
 
+/**
+ * @see ObjectInterface::hash64(const Object *)
+ */
+static uint64_t hash64(const Object *self) {
+
+	const String *this = (String *) self;
+
+	const RANGE range = { 0, this->length };
+
+	return HashForCharacters64(HASH_SEED, this->chars, range);
+}
+
 #pragma mark - MutableStringInterface
 
 /**
@@ -192,6 +205,7 @@ static void initialize(Class *clazz) {
 	ObjectInterface *object = (ObjectInterface *) clazz->interface;
 
 	object->copy = copy;
+	object->hash64 = hash64;
 
 	MutableStringInterface *mutableString = (MutableStringInterface *) clazz->interface;
 
@@ -23,6 +23,7 @@
 
 #include <assert.h>
 
+#include <Objectively/Arena.h>
 #include <Objectively/Null.h>
 #include <Objectively/Once.h>
 
@@ -49,7 +50,7 @@ static Null *null(void) {
 	static Once once;
 
 	DispatchOnce(once, {
-		_null = (Null *) $((Object *) alloc(Null), init);
+		WithoutArena(_null = immortalize($((Object *) alloc(Null), init)));
 	});
 
 	return _null;
@@ -58,30 +59,33 @@ static Null *null(void) {
 #pragma mark - Class lifecycle
 
 /**
- * @see Class::initialize(Class *)
+ * @see Class::destroy(Class *)
  */
-static void initialize(Class *clazz) {
-
-	((ObjectInterface *) clazz->interface)->copy = copy;
+static void destroy(Class *clazz) {
 
-	((NullInterface *) clazz->interface)->null = null;
+	if (_null) {
+		$((Object *) _null, dealloc);
+	}
 }
 
 /**
- * @see Class::destroy(Class *)
+ * @brief The static NullInterface.
  */
-static void destroy(Class *clazz) {
-
-	release(_null);
-}
+StaticInterface(static const NullInterface interface = {
+	.objectInterface = {
+		InheritObjectInterface,
+		.copy = copy,
+	},
+	.null = null,
+})
 
 Class _Null = {
 	.name = "Null",
 	.superclass = &_Object,
 	.instanceSize = sizeof(Null),
+	.interface = (id) &interface,
 	.interfaceOffset = offsetof(Null, interface),
 	.interfaceSize = sizeof(NullInterface),
-	.initialize = initialize,
 	.destroy = destroy,
 };
 
@@ -25,6 +25,7 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <Objectively/Hash.h>
 #include <Objectively/Object.h>
 #include <Objectively/String.h>
 
@@ -35,13 +36,12 @@
 /**
  * @see ObjectInterface::copy(const Object *)
  */
-static Object *copy(const Object *self) {
+Object *_Object_copy(const Object *self) {
 
-	id obj = calloc(1, self->clazz->instanceSize);
-	assert(obj);
+	Object *object = _alloc(self->clazz);
 
-	Object *object = memcpy(obj, self, self->clazz->instanceSize);
-	object->referenceCount = 1;
+	const size_t size = self->clazz->instanceSize - sizeof(Object);
+	memcpy((id) object + sizeof(Object), (id) self + sizeof(Object), size);
 
 	return object;
 }
@@ -49,15 +49,15 @@ static Object *copy(const Object *self) {
 /**
  * @see ObjectInterface::dealloc(Object *)
  */
-static void dealloc(Object *self) {
+void _Object_dealloc(Object *self) {
 
-	free(self);
+	_dealloc(self);
 }
 
 /**
  * @see ObjectInterface::description(const Object *)
  */
-static String *description(const Object *self) {
+String *_Object_description(const Object *self) {
 
 	return $(alloc(String), initWithFormat, "%s@%p", self->clazz->name, self);
 }
@@ -65,17 +65,36 @@ static String *description(const Object *self) {
 /**
  * @see ObjectInterface::hash(const Object *)
  */
-static int hash(const Object *self) {
+int _Object_hash(const Object *self) {
 
 	uintptr_t addr = (uintptr_t) self;
 
 	return (int) ((13 * addr) ^ (addr >> 15));
 }
 
+/**
+ * @see ObjectInterface::hash64(const Object *)
+ */
+uint64_t _Object_hash64(const Object *self) {
+
+	return HashForInteger64(HASH_SEED, (uint32_t) $(self, hash));
+}
+
+/**
+ * @see ObjectInterface::hashWithKey(const Object *, const HashKey *)
+ */
+uint64_t _Object_hashWithKey(const Object *self, const HashKey *key) {
+
+	const uint64_t hash = $(self, hash64);
+	const RANGE range = { 0, sizeof(hash) };
+
+	return HashForBytesWithKey(key, (const byte *) &hash, range);
+}
+
 /**
  * @see ObjectInterface::init(Object *)
  */
-static Object *init(Object *self) {
+Object *_Object_init(Object *self) {
 
 	return self;
 }
@@ -83,7 +102,7 @@ static Object *init(Object *self) {
 /**
  * @see ObjectInterface::isEqual(const Object *, const Object *)
  */
-static BOOL isEqual(const Object *self, const Object *other) {
+BOOL _Object_isEqual(const Object *self, const Object *other) {
 
 	return self == other;
 }
@@ -91,43 +110,26 @@ static BOOL isEqual(const Object *self, const Object *other) {
 /**
  * @see ObjectInterface::isKindOfClass(const Object *, const Class *)
  */
-static BOOL isKindOfClass(const Object *self, const Class *clazz) {
-
-	const Class *c = self->clazz;
-	while (c) {
-		if (c == clazz) {
-			return YES;
-		}
-		c = c->superclass;
-	}
+BOOL _Object_isKindOfClass(const Object *self, const Class *clazz) {
 
-	return NO;
+	return _isSubclassOfClass(self->clazz, clazz);
 }
 
 #pragma mark - Class lifecycle
 
 /**
- * @see Class::initialize(Class *)
+ * @brief The static ObjectInterface.
  */
-static void initialize(Class *clazz) {
-
-	ObjectInterface *object = (ObjectInterface *) clazz->interface;
-
-	object->copy = copy;
-	object->dealloc = dealloc;
-	object->description = description;
-	object->hash = hash;
-	object->init = init;
-	object->isEqual = isEqual;
-	object->isKindOfClass = isKindOfClass;
-}
+static const ObjectInterface interface = {
+	InheritObjectInterface
+};
 
 Class _Object = {
 	.name = "Object",
 	.instanceSize = sizeof(Object),
+	.interface = (id) &interface,
 	.interfaceOffset = offsetof(Object, interface),
 	.interfaceSize = sizeof(ObjectInterface),
-	.initialize = initialize,
 };
 
 #undef _Class
@@ -58,13 +58,34 @@ struct Object {
 	ObjectInterface *interface;
 
 	/**
-	 * @brief The reference count of this Object.
+	 * @brief The reference count of this Object, as held by its owner thread.
+	 *
+	 * @remark Reference counts are biased towards the thread that allocated
+	 * the Object, which maintains this count without atomic operations. For
+	 * Objects that never leave their owner thread, this is the reference count.
 	 *
 	 * @private
 	 */
 	unsigned referenceCount;
+
+	/**
+	 * @brief The reference count held by threads other than the owner, which
+	 * is maintained atomically.
+	 *
+	 * @private
+	 */
+	int sharedReferenceCount;
+
+	/**
+	 * @brief The owner thread of this Object, or the Arena from which it was
+	 * allocated.
+	 *
+	 * @private
+	 */
+	id owner;
 };
 
+typedef struct HashKey HashKey;
 typedef struct String String;
 
 /**
@@ -104,6 +125,34 @@ struct ObjectInterface {
 	 */
 	int (*hash)(const Object *self);
 
+	/**
+	 * @return A 64 bit hash for use in hash tables, etc.
+	 *
+	 * @remark The default implementation mixes `hash`, so that Objects that
+	 * are equal always have equal 64 bit hashes. Classes that override this
+	 * method must ensure the same.
+	 *
+	 * @relates Object
+	 */
+	uint64_t (*hash64)(const Object *self);
+
+	/**
+	 * @param key The secret HashKey.
+	 *
+	 * @return A 64 bit hash, keyed by `key`, for use in hash tables whose keys
+	 * are untrusted.
+	 *
+	 * @remark The default implementation keys `hash64`, which protects the
+	 * bins of a hash table, but not `hash64` itself, from collision attacks.
+	 * Classes whose `hash64` is derived from untrusted content, such as String
+	 * and Data, should hash that content with `key` directly.
+	 *
+	 * @see HashForObjectWithKey(const HashKey *, const id)
+	 *
+	 * @relates Object
+	 */
+	uint64_t (*hashWithKey)(const Object *self, const HashKey *key);
+
 	/**
 	 * @brief Initializes this Object.
 	 *
@@ -137,4 +186,76 @@ struct ObjectInterface {
  */
 extern Class _Object;
 
+/**
+ * @brief The Object method implementations.
+ *
+ * @remark These are exported so that Classes may inherit them at compile time
+ * with `InheritObjectInterface`. Call them through `super` otherwise.
+ *
+ * @private
+ */
+extern Object *_Object_copy(const Object *self);
+extern void _Object_dealloc(Object *self);
+extern String *_Object_description(const Object *self);
+extern int _Object_hash(const Object *self);
+extern uint64_t _Object_hash64(const Object *self);
+extern uint64_t _Object_hashWithKey(const Object *self, const HashKey *key);
+extern Object *_Object_init(Object *self);
+extern BOOL _Object_isEqual(const Object *self, const Object *other);
+extern BOOL _Object_isKindOfClass(const Object *self, const Class *clazz);
+
+/**
+ * @brief Initializes the methods of a static ObjectInterface.
+ *
+ * Static interfaces are statically initialized, and so require no runtime
+ * allocation or `initialize`. List the inherited methods first; any that are
+ * listed again afterwards are overridden.
+ *
+ * @code
+ * StaticInterface(static const BooleanInterface interface = {
+ *     .objectInterface = {
+ *         InheritObjectInterface,
+ *         .copy = copy,
+ *     },
+ *     .yes = yes,
+ * });
+ *
+ * Class _Boolean = {
+ *     .name = "Boolean",
+ *     .superclass = &_Object,
+ *     .interface = (id) &interface,
+ *     ...
+ * };
+ * @endcode
+ *
+ * @remark Classes that define a static interface may export a similar macro,
+ * so that their subclasses may also inherit their methods at compile time.
+ *
+ * @remark Overriding initializers are standard C, but are reported by
+ * `-Woverride-init`, which `-Wextra` enables. Declare static interfaces that
+ * override inherited methods with `StaticInterface`.
+ */
+#define InheritObjectInterface \
+	.copy = _Object_copy, \
+	.dealloc = _Object_dealloc, \
+	.description = _Object_description, \
+	.hash = _Object_hash, \
+	.hash64 = _Object_hash64, \
+	.hashWithKey = _Object_hashWithKey, \
+	.init = _Object_init, \
+	.isEqual = _Object_isEqual, \
+	.isKindOfClass = _Object_isKindOfClass
+
+/**
+ * @brief Declares a static interface whose initializer overrides inherited
+ * methods, e.g. those listed by `InheritObjectInterface`.
+ *
+ * @remark `-Woverride-init` is suppressed for the declaration only.
+ */
+#define StaticInterface(...) \
+	_Pragma("GCC diagnostic push") \
+	_Pragma("GCC diagnostic ignored \"-Woverride-init\"") \
+	__VA_ARGS__; \
+	_Pragma("GCC diagnostic pop")
+
 #endif
@@ -41,12 +41,16 @@ typedef long long int Once;
 
 /**
  * @brief Executes the given `block` at most one time.
+ *
+ * @remark Once `block` has executed, this costs a single (acquire) load.
  */
 #define DispatchOnce(once, block) \
-	if (__sync_val_compare_and_swap(&once, 0, -1) == 0) { \
-		block; once = 1; \
-	} else { \
-		while (once != 1) ; \
+	if (__atomic_load_n(&once, __ATOMIC_ACQUIRE) != 1) { \
+		if (__sync_val_compare_and_swap(&once, 0, -1) == 0) { \
+			block; __atomic_store_n(&once, 1, __ATOMIC_RELEASE); \
+		} else { \
+			while (__atomic_load_n(&once, __ATOMIC_ACQUIRE) != 1) ; \
+		} \
 	}
 
 #endif
@@ -175,9 +175,8 @@ static void start(Operation *self) {
 		self->isExecuting = NO;
 	}
 
-	self->isFinished = YES;
-
 	WithLock(self->locals.condition, {
+		self->isFinished = YES;
 		$(self->locals.condition, broadcast);
 	});
 
@@ -22,7 +22,10 @@
  */
 
 #include <assert.h>
+#include <stdlib.h>
+#include <unistd.h>
 
+#include <Objectively/Arena.h>
 #include <Objectively/Once.h>
 #include <Objectively/OperationQueue.h>
 
@@ -45,7 +48,11 @@ static void dealloc(Object *self) {
 
 	OperationQueue *this = (OperationQueue *) self;
 
-	$(this->locals.thread, cancel);
+	WithLock(this->locals.condition, {
+		$(this->locals.thread, cancel);
+		$(this->locals.condition, broadcast);
+	});
+
 	$(this->locals.thread, join, NULL);
 
 	release(this->locals.thread);
@@ -73,6 +80,124 @@ static void addOperation(OperationQueue *self, Operation *operation) {
 	});
 }
 
+/**
+ * @brief The shared pool of OperationQueues for `apply`.
+ */
+static struct {
+	OperationQueue **queues;
+	size_t count;
+} _pool;
+
+/**
+ * @brief Creates the pool, with one OperationQueue per processor beyond the first.
+ */
+static void createPool(void) {
+
+	long concurrency = sysconf(_SC_NPROCESSORS_ONLN);
+
+	const char *env = getenv("OBJECTIVELY_CONCURRENCY");
+	if (env) {
+		concurrency = strtol(env, NULL, 10);
+	}
+
+	if (concurrency > 1) {
+
+		_pool.count = concurrency - 1;
+		_pool.queues = calloc(_pool.count, sizeof(OperationQueue *));
+		assert(_pool.queues);
+
+		for (size_t i = 0; i < _pool.count; i++) {
+			_pool.queues[i] = $(alloc(OperationQueue), init);
+		}
+	}
+}
+
+/**
+ * @brief The state of an `apply`, which its Operations share.
+ */
+typedef struct {
+	size_t iterations;
+	ApplyFunction function;
+	id data;
+	size_t next;
+} Apply;
+
+/**
+ * @brief Claims and executes iterations of `apply` until none remain.
+ */
+static void applyIterations(Apply *apply) {
+
+	size_t iteration;
+	while ((iteration = __atomic_fetch_add(&apply->next, 1, __ATOMIC_RELAXED)) < apply->iterations) {
+		apply->function(iteration, apply->data);
+	}
+}
+
+/**
+ * @brief OperationFunction for the pooled Operations of `apply`.
+ */
+static void applyOperation(Operation *operation) {
+
+	Apply *apply = operation->data;
+
+	applyIterations(apply);
+}
+
+__thread OperationQueue *_currentQueue;
+
+/**
+ * @see OperationQueueInterface::apply(size_t, ApplyFunction, id)
+ */
+static void apply(size_t iterations, ApplyFunction function, id data) {
+
+	assert(function);
+
+	static Once once;
+
+	DispatchOnce(once, {
+		WithoutArena(createPool());
+	});
+
+	size_t count = iterations > 1 ? iterations - 1 : 0;
+	if (count > _pool.count) {
+		count = _pool.count;
+	}
+
+	for (size_t i = 0; i < _pool.count; i++) {
+		if (_pool.queues[i] == _currentQueue) {
+			count = 0;
+		}
+	}
+
+	Apply apply = {
+		.iterations = iterations,
+		.function = function,
+		.data = data
+	};
+
+	Operation **operations = NULL;
+	if (count) {
+		operations = calloc(count, sizeof(Operation *));
+		assert(operations);
+	}
+
+	WithoutArena({
+		for (size_t i = 0; i < count; i++) {
+			operations[i] = $(alloc(Operation), initWithFunction, applyOperation, &apply);
+			$(_pool.queues[i], addOperation, operations[i]);
+		}
+	});
+
+	applyIterations(&apply);
+
+	for (size_t i = 0; i < count; i++) {
+		$(operations[i], waitUntilFinished);
+		release(operations[i]);
+	}
+
+	free(operations);
+}
+
 /**
  * @see OperationQueueInterface::cancelAllOperations(OperationQueue *)
  */
@@ -87,8 +212,6 @@ static void cancelAllOperations(OperationQueue *self) {
 	release(operations);
 }
 
-__thread OperationQueue *_currentQueue;
-
 /**
  * @see OperationQueueInterface::currentQueue(void)
  */
@@ -130,7 +253,11 @@ static id run(Thread *thread) {
 		Date *date = $$(Date, dateWithTimeSinceNow, &interval);
 
 		WithLock(self->locals.condition, {
-			$(self->locals.condition, waitUntilDate, date);
+			if (((Array *) self->locals.operations)->count == 0 && thread->isCancelled == NO) {
+				$(self->locals.condition, wait);
+			} else {
+				$(self->locals.condition, waitUntilDate, date);
+			}
 		});
 
 		release(date);
@@ -220,6 +347,21 @@ static void waitUntilAllOperationsAreFinished(OperationQueue *self) {
 
 #pragma mark - Class lifecycle
 
+/**
+ * @see Class::destroy(Class *)
+ */
+static void destroy(Class *clazz) {
+
+	for (size_t i = 0; i < _pool.count; i++) {
+		release(_pool.queues[i]);
+	}
+
+	free(_pool.queues);
+
+	_pool.queues = NULL;
+	_pool.count = 0;
+}
+
 /**
  * @see Class::initialize(Class *)
  */
@@ -233,6 +375,7 @@ static void initialize(Class *clazz) {
 	OperationQueueInterface *queue = (OperationQueueInterface *) clazz->interface;
 
 	queue->addOperation = addOperation;
+	queue->apply = apply;
 	queue->cancelAllOperations = cancelAllOperations;
 	queue->currentQueue = currentQueue;
 	queue->init = init;
@@ -248,6 +391,7 @@ Class _OperationQueue = {
 	.instanceSize = sizeof(OperationQueue),
 	.interfaceOffset = offsetof(OperationQueue, interface),
 	.interfaceSize = sizeof(OperationQueueInterface),
-	.initialize = initialize, };
+	.initialize = initialize,
+	.destroy = destroy, };
 
 #undef _Class
@@ -38,6 +38,14 @@
 typedef struct OperationQueue OperationQueue;
 typedef struct OperationQueueInterface OperationQueueInterface;
 
+/**
+ * @brief The function type of `apply`.
+ *
+ * @param iteration The iteration, in `[0, iterations)`.
+ * @param data User data.
+ */
+typedef void (*ApplyFunction)(size_t iteration, id data);
+
 /**
  * @brief OperationQueues provide a thread of execution for Operations.
  *
@@ -108,6 +116,23 @@ struct OperationQueueInterface {
 	 */
 	void (*addOperation)(OperationQueue *self, Operation *operation);
 
+	/**
+	 * @brief Executes `function` once for each of `iterations`, concurrently,
+	 * returning when all iterations have finished.
+	 *
+	 * @param iterations The count of iterations.
+	 * @param function The ApplyFunction.
+	 * @param data User data.
+	 *
+	 * @remark Iterations are executed by the calling thread and by a pool of
+	 * OperationQueues, one per additional processor, which is shared by the
+	 * process. The size of the pool is read from `OBJECTIVELY_CONCURRENCY` in
+	 * the environment, if set. Calls from within the pool execute serially.
+	 *
+	 * @relates OperationQueue
+	 */
+	void (*apply)(size_t iterations, ApplyFunction function, id data);
+
 	/**
 	 * @brief Cancels all pending Operations residing within this Queue.
 	 *
@@ -0,0 +1,621 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <assert.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <Objectively/Hash.h>
+#include <Objectively/MutableOrderedDictionary.h>
+#include <Objectively/OrderedDictionary.h>
+#include <Objectively/Reclaimer.h>
+#include <Objectively/String.h>
+
+#define _Class _OrderedDictionary
+
+/**
+ * @brief The index of a slot that has never been used.
+ */
+#define INDEX_EMPTY 0
+
+/**
+ * @brief The index of a slot whose entry was removed.
+ */
+#define INDEX_DELETED UINT32_MAX
+
+/**
+ * @brief The minimum size of the index table.
+ */
+#define ORDEREDDICTIONARY_MIN_CAPACITY 8
+
+/**
+ * @return The count of entries that an index table of `capacity` slots may
+ * hold (2/3 load).
+ */
+#define usable(capacity) ((capacity) * 2 / 3)
+
+#pragma mark - Table
+
+/**
+ * @return The smallest index table capacity that may hold `count` entries.
+ */
+static size_t capacityForCount(size_t count) {
+
+	size_t capacity = ORDEREDDICTIONARY_MIN_CAPACITY;
+	while (usable(capacity) < count) {
+		capacity <<= 1;
+	}
+
+	return capacity;
+}
+
+/**
+ * @brief Compacts the entries of `self`, and rebuilds its index table with
+ * `capacity` slots, reusing the hashes of its entries.
+ */
+static void rebuild(OrderedDictionary *self, size_t capacity) {
+
+	size_t length = 0;
+	for (size_t i = 0; i < self->length; i++) {
+		if (self->entries[i].key) {
+			self->entries[length++] = self->entries[i];
+		}
+	}
+
+	assert(length == self->dictionary.count);
+
+	self->length = length;
+	self->capacity = capacity;
+
+	self->dictionary.mutations++;
+
+	free(self->indices);
+
+	if (capacity) {
+		self->entries = realloc(self->entries, usable(capacity) * sizeof(DictionaryEntry));
+		assert(self->entries);
+
+		self->indices = calloc(capacity, sizeof(uint32_t));
+		assert(self->indices);
+
+		const size_t mask = capacity - 1;
+
+		for (size_t i = 0; i < length; i++) {
+
+			size_t slot = self->entries[i].hash & mask;
+			while (self->indices[slot] != INDEX_EMPTY) {
+				slot = (slot + 1) & mask;
+			}
+
+			self->indices[slot] = (uint32_t) (i + 1);
+		}
+	} else {
+		free(self->entries);
+
+		self->entries = NULL;
+		self->indices = NULL;
+	}
+}
+
+DictionaryEntry *_OrderedDictionary_find(const OrderedDictionary *self, const id key,
+		const uint64_t hash) {
+
+	if (self->dictionary.count == 0) {
+		return NULL;
+	}
+
+	const size_t mask = self->capacity - 1;
+
+	for (size_t slot = hash & mask; ; slot = (slot + 1) & mask) {
+
+		const uint32_t index = self->indices[slot];
+		if (index == INDEX_EMPTY) {
+			return NULL;
+		}
+
+		if (index != INDEX_DELETED) {
+
+			DictionaryEntry *entry = self->entries + index - 1;
+			if (entry->hash == hash) {
+				if (entry->key == key || $((Object *) entry->key, isEqual, key)) {
+					return entry;
+				}
+			}
+		}
+	}
+}
+
+/**
+ * @brief Finds the entry whose key is a String equal to `bytes`.
+ *
+ * @see _OrderedDictionary_find(const OrderedDictionary *, const id, const uint64_t)
+ */
+static DictionaryEntry *findBytes(const OrderedDictionary *self, const byte *bytes,
+		const size_t length, const uint64_t hash) {
+
+	if (self->dictionary.count == 0) {
+		return NULL;
+	}
+
+	const size_t mask = self->capacity - 1;
+
+	for (size_t slot = hash & mask; ; slot = (slot + 1) & mask) {
+
+		const uint32_t index = self->indices[slot];
+		if (index == INDEX_EMPTY) {
+			return NULL;
+		}
+
+		if (index != INDEX_DELETED) {
+
+			DictionaryEntry *entry = self->entries + index - 1;
+			if (entry->hash == hash) {
+				if (_String_isEqualToBytes(entry->key, bytes, length)) {
+					return entry;
+				}
+			}
+		}
+	}
+}
+
+DictionaryEntry *_OrderedDictionary_insert(OrderedDictionary *self, const uint64_t hash) {
+
+	if (self->length == usable(self->capacity)) {
+		rebuild(self, capacityForCount(self->dictionary.count * 2 + 1));
+	}
+
+	const size_t mask = self->capacity - 1;
+
+	size_t slot = hash & mask;
+	while (self->indices[slot] != INDEX_EMPTY && self->indices[slot] != INDEX_DELETED) {
+		slot = (slot + 1) & mask;
+	}
+
+	self->indices[slot] = (uint32_t) (self->length + 1);
+	self->dictionary.count++;
+	self->dictionary.mutations++;
+
+	DictionaryEntry *entry = self->entries + self->length++;
+	entry->hash = hash;
+
+	self->dictionary.hashes += hash;
+
+	return entry;
+}
+
+void _OrderedDictionary_erase(OrderedDictionary *self, DictionaryEntry *entry) {
+
+	const uint32_t index = (uint32_t) (entry - self->entries + 1);
+	const size_t mask = self->capacity - 1;
+
+	size_t slot = entry->hash & mask;
+	while (self->indices[slot] != index) {
+		slot = (slot + 1) & mask;
+	}
+
+	self->indices[slot] = INDEX_DELETED;
+
+	entry->key = entry->obj = NULL;
+
+	self->dictionary.count--;
+	self->dictionary.hashes -= entry->hash;
+	self->dictionary.mutations++;
+}
+
+void _OrderedDictionary_clear(OrderedDictionary *self) {
+
+	if (self->capacity) {
+		memset(self->indices, 0, self->capacity * sizeof(uint32_t));
+	}
+
+	self->length = 0;
+	self->dictionary.count = 0;
+	self->dictionary.hashes = 0;
+	self->dictionary.mutations++;
+}
+
+void _OrderedDictionary_reserve(OrderedDictionary *self, size_t count) {
+
+	if (count > self->dictionary.count) {
+		if (count - self->dictionary.count > usable(self->capacity) - self->length) {
+			rebuild(self, capacityForCount(count));
+		}
+	}
+}
+
+void _OrderedDictionary_compact(OrderedDictionary *self) {
+
+	if (self->dictionary.count) {
+		rebuild(self, capacityForCount(self->dictionary.count));
+	} else {
+		rebuild(self, 0);
+	}
+}
+
+#pragma mark - ObjectInterface
+
+/**
+ * @see ObjectInterface::copy(const Object *)
+ */
+static Object *copy(const Object *self) {
+
+	const Dictionary *this = (Dictionary *) self;
+
+	OrderedDictionary *that = $(alloc(OrderedDictionary), initWithDictionary, this);
+
+	return (Object *) that;
+}
+
+/**
+ * @see ObjectInterface::dealloc(Object *)
+ */
+static void dealloc(Object *self) {
+
+	OrderedDictionary *this = (OrderedDictionary *) self;
+
+	if (_reclaim(self, this->dictionary.count, dealloc)) {
+		return;
+	}
+
+	for (size_t i = 0; i < this->length; i++) {
+		if (this->entries[i].key) {
+			release(this->entries[i].key);
+			release(this->entries[i].obj);
+		}
+	}
+
+	free(this->entries);
+	free(this->indices);
+
+	this->dictionary.count = 0;
+
+	super(Object, self, dealloc);
+}
+
+/**
+ * @see ObjectInterface::hash(const Object *)
+ */
+static int hash(const Object *self) {
+
+	const OrderedDictionary *this = (OrderedDictionary *) self;
+
+	int hash = HashForInteger(HASH_SEED, this->dictionary.count);
+
+	for (size_t i = 0; i < this->length; i++) {
+		if (this->entries[i].key) {
+			hash += HashForObject(HashForObject(HASH_SEED, this->entries[i].key), this->entries[i].obj);
+		}
+	}
+
+	return hash;
+}
+
+#pragma mark - DictionaryInterface
+
+/**
+ * @see DictionaryInterface::enumerateObjectsAndKeys(const Dictionary *, DictionaryEnumerator, id)
+ */
+static void enumerateObjectsAndKeys(const Dictionary *self, DictionaryEnumerator enumerator,
+		id data) {
+
+	assert(enumerator);
+
+	const OrderedDictionary *this = (OrderedDictionary *) self;
+
+	for (size_t i = 0; i < this->length; i++) {
+
+		const DictionaryEntry *entry = this->entries + i;
+		if (entry->key) {
+			if (enumerator(self, entry->obj, entry->key, data)) {
+				return;
+			}
+		}
+	}
+}
+
+/**
+ * @see DictionaryInterface::enumerateObjectsAndKeysConcurrently(const Dictionary *, DictionaryEnumerator, id)
+ */
+static void enumerateObjectsAndKeysConcurrently(const Dictionary *self,
+		DictionaryEnumerator enumerator, id data) {
+
+	const OrderedDictionary *this = (OrderedDictionary *) self;
+
+	_Dictionary_enumerateEntriesConcurrently(self, this->entries, NULL, this->length, enumerator, data);
+}
+
+/**
+ * @see DictionaryInterface::filterObjectsAndKeys(const Dictionary *, DictionaryEnumerator, id)
+ */
+static Dictionary *filterObjectsAndKeys(const Dictionary *self, DictionaryEnumerator enumerator,
+		id data) {
+
+	assert(enumerator);
+
+	const OrderedDictionary *this = (OrderedDictionary *) self;
+
+	MutableOrderedDictionary *dictionary = $(alloc(MutableOrderedDictionary), initWithCapacityAndHashKey,
+			0, self->hashKey);
+
+	for (size_t i = 0; i < this->length; i++) {
+
+		const DictionaryEntry *entry = this->entries + i;
+		if (entry->key) {
+			if (enumerator(self, entry->obj, entry->key, data)) {
+				$(dictionary, setObjectForKey, entry->obj, entry->key);
+			}
+		}
+	}
+
+	return (Dictionary *) dictionary;
+}
+
+/**
+ * @see DictionaryInterface::filterObjectsAndKeysConcurrently(const Dictionary *, DictionaryEnumerator, id)
+ */
+static Dictionary *filterObjectsAndKeysConcurrently(const Dictionary *self,
+		DictionaryEnumerator enumerator, id data) {
+
+	const OrderedDictionary *this = (OrderedDictionary *) self;
+
+	size_t count;
+	DictionaryEntry *matches = _Dictionary_filterEntriesConcurrently(self, this->entries, NULL,
+			this->length, enumerator, data, &count);
+
+	MutableOrderedDictionary *dictionary = $(alloc(MutableOrderedDictionary), initWithCapacityAndHashKey,
+			count, self->hashKey);
+
+	for (size_t i = 0; i < count; i++) {
+
+		DictionaryEntry *entry = _OrderedDictionary_insert((OrderedDictionary *) dictionary, matches[i].hash);
+
+		entry->key = retain(matches[i].key);
+		entry->obj = retain(matches[i].obj);
+	}
+
+	free(matches);
+
+	return (Dictionary *) dictionary;
+}
+
+/**
+ * @see DictionaryInterface::nextObjects(const Dictionary *, Cursor *)
+ */
+static size_t nextObjects(const Dictionary *self, Cursor *cursor) {
+
+	const OrderedDictionary *this = (OrderedDictionary *) self;
+
+	_CursorCheckMutations(cursor, &self->mutations);
+
+	cursor->objects = cursor->objectBuffer;
+	cursor->keys = cursor->keyBuffer;
+	cursor->count = 0;
+
+	for (; cursor->state < this->length && cursor->count < CURSOR_BATCH_SIZE; cursor->state++) {
+
+		const DictionaryEntry *entry = this->entries + cursor->state;
+		if (entry->key) {
+			cursor->keys[cursor->count] = entry->key;
+			cursor->objects[cursor->count] = entry->obj;
+			cursor->count++;
+		}
+	}
+
+	return cursor->count;
+}
+
+/**
+ * @see DictionaryInterface::objectForBytes(const Dictionary *, const byte *, size_t)
+ */
+static id objectForBytes(const Dictionary *self, const byte *bytes, size_t length) {
+
+	const OrderedDictionary *this = (OrderedDictionary *) self;
+
+	const uint64_t hash = _String_hashForBytes(self->hashKey, bytes, length);
+
+	const DictionaryEntry *entry = findBytes(this, bytes, length, hash);
+	if (entry) {
+		return entry->obj;
+	}
+
+	return NULL;
+}
+
+/**
+ * @see DictionaryInterface::objectForKey(const Dictionary *, const id)
+ */
+static id objectForKey(const Dictionary *self, const id key) {
+
+	const OrderedDictionary *this = (OrderedDictionary *) self;
+
+	const DictionaryEntry *entry = _OrderedDictionary_find(this, key, _Dictionary_hashForKey(self, key));
+	if (entry) {
+		return entry->obj;
+	}
+
+	return NULL;
+}
+
+#pragma mark - OrderedDictionaryInterface
+
+/**
+ * @see OrderedDictionaryInterface::dictionaryWithDictionary(const Dictionary *)
+ */
+static OrderedDictionary *dictionaryWithDictionary(const Dictionary *dictionary) {
+
+	return $(alloc(OrderedDictionary), initWithDictionary, dictionary);
+}
+
+/**
+ * @see OrderedDictionaryInterface::dictionaryWithObjectsAndKeys(id, ...)
+ */
+static OrderedDictionary *dictionaryWithObjectsAndKeys(id obj, ...) {
+
+	OrderedDictionary *dict = (OrderedDictionary *) super(Object, alloc(OrderedDictionary), init);
+	if (dict) {
+
+		dict->dictionary.hashKey = HashKeyDefault();
+
+		va_list args;
+		va_start(args, obj);
+
+		while (obj) {
+			id key = va_arg(args, id);
+
+			$$(MutableOrderedDictionary, setObjectForKey, (MutableOrderedDictionary *) dict, obj, key);
+
+			obj = va_arg(args, id);
+		}
+
+		va_end(args);
+	}
+
+	return dict;
+}
+
+/**
+ * @brief DictionaryEnumerator for initWithDictionary.
+ */
+static BOOL initWithDictionary_enumerator(const Dictionary *dict, id obj, id key, id data) {
+
+	OrderedDictionary *this = (OrderedDictionary *) data;
+
+	DictionaryEntry *entry = _OrderedDictionary_insert(this, _Dictionary_hashForKey((Dictionary *) this, key));
+
+	entry->key = retain(key);
+	entry->obj = retain(obj);
+
+	return NO;
+}
+
+/**
+ * @see OrderedDictionaryInterface::initWithDictionary(OrderedDictionary *, const Dictionary *)
+ */
+static OrderedDictionary *initWithDictionary(OrderedDictionary *self, const Dictionary *dictionary) {
+
+	self = (OrderedDictionary *) super(Object, self, init);
+	if (self) {
+		if (dictionary) {
+
+			self->dictionary.hashKey = dictionary->hashKey;
+
+			_OrderedDictionary_reserve(self, dictionary->count);
+
+			$(dictionary, enumerateObjectsAndKeys, initWithDictionary_enumerator, self);
+		} else {
+			self->dictionary.hashKey = HashKeyDefault();
+		}
+	}
+
+	return self;
+}
+
+/**
+ * @see OrderedDictionaryInterface::initWithObjectsAndKeys(OrderedDictionary *, ...)
+ */
+static OrderedDictionary *initWithObjectsAndKeys(OrderedDictionary *self, ...) {
+
+	self = (OrderedDictionary *) super(Object, self, init);
+	if (self) {
+
+		self->dictionary.hashKey = HashKeyDefault();
+
+		va_list args;
+		va_start(args, self);
+
+		while (YES) {
+
+			id obj = va_arg(args, id);
+			if (obj) {
+
+				id key = va_arg(args, id);
+				$$(MutableOrderedDictionary, setObjectForKey, (MutableOrderedDictionary *) self, obj, key);
+			} else {
+				break;
+			}
+		}
+
+		va_end(args);
+	}
+
+	return self;
+}
+
+/**
+ * @see OrderedDictionaryInterface::mutableCopy(const OrderedDictionary *)
+ */
+static MutableOrderedDictionary *mutableCopy(const OrderedDictionary *self) {
+
+	MutableOrderedDictionary *copy = $(alloc(MutableOrderedDictionary), initWithCapacityAndHashKey,
+			self->dictionary.count, self->dictionary.hashKey);
+	if (copy) {
+		$(copy, addEntriesFromDictionary, (Dictionary *) self);
+	}
+
+	return copy;
+}
+
+#pragma mark - Class lifecycle
+
+/**
+ * @see Class::initialize(Class *)
+ */
+static void initialize(Class *clazz) {
+
+	ObjectInterface *object = (ObjectInterface *) clazz->interface;
+
+	object->copy = copy;
+	object->dealloc = dealloc;
+	object->hash = hash;
+
+	DictionaryInterface *dictionary = (DictionaryInterface *) clazz->interface;
+
+	dictionary->enumerateObjectsAndKeys = enumerateObjectsAndKeys;
+	dictionary->enumerateObjectsAndKeysConcurrently = enumerateObjectsAndKeysConcurrently;
+	dictionary->filterObjectsAndKeys = filterObjectsAndKeys;
+	dictionary->filterObjectsAndKeysConcurrently = filterObjectsAndKeysConcurrently;
+	dictionary->nextObjects = nextObjects;
+	dictionary->objectForBytes = objectForBytes;
+	dictionary->objectForKey = objectForKey;
+
+	OrderedDictionaryInterface *orderedDictionary = (OrderedDictionaryInterface *) clazz->interface;
+
+	orderedDictionary->dictionaryWithDictionary = dictionaryWithDictionary;
+	orderedDictionary->dictionaryWithObjectsAndKeys = dictionaryWithObjectsAndKeys;
+	orderedDictionary->initWithDictionary = initWithDictionary;
+	orderedDictionary->initWithObjectsAndKeys = initWithObjectsAndKeys;
+	orderedDictionary->mutableCopy = mutableCopy;
+}
+
+Class _OrderedDictionary = {
+	.name = "OrderedDictionary",
+	.superclass = &_Dictionary,
+	.instanceSize = sizeof(OrderedDictionary),
+	.interfaceOffset = offsetof(OrderedDictionary, interface),
+	.interfaceSize = sizeof(OrderedDictionaryInterface),
+	.initialize = initialize,
+};
+
+#undef _Class
+
@@ -0,0 +1,190 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef _Objectively_OrderedDictionary_h_
+#define _Objectively_OrderedDictionary_h_
+
+#include <Objectively/Dictionary.h>
+
+/**
+ * @file
+ *
+ * @brief Immutable key-value stores that retain insertion order.
+ */
+
+typedef struct OrderedDictionary OrderedDictionary;
+typedef struct OrderedDictionaryInterface OrderedDictionaryInterface;
+
+/**
+ * @brief Immutable key-value stores that retain insertion order.
+ *
+ * OrderedDictionary uses the compact layout: its entries are stored densely,
+ * in insertion order, and located through a sparse table of 32 bit indices.
+ * Enumeration is therefore a linear scan of the entries, in insertion order.
+ * Entries removed from a MutableOrderedDictionary leave holes, which are
+ * skipped, until the table is next resized.
+ *
+ * OrderedDictionary is a Dictionary, and is equal to any Dictionary with the
+ * same pairs, regardless of their order.
+ *
+ * @extends Dictionary
+ *
+ * @ingroup Collections
+ */
+struct OrderedDictionary {
+
+	/**
+	 * @brief The parent.
+	 *
+	 * @private
+	 */
+	Dictionary dictionary;
+
+	/**
+	 * @brief The typed interface.
+	 *
+	 * @private
+	 */
+	OrderedDictionaryInterface *interface;
+
+	/**
+	 * @brief The entries, in insertion order. Removed entries have `NULL` keys.
+	 *
+	 * @private
+	 */
+	DictionaryEntry *entries;
+
+	/**
+	 * @brief The count of entries in use, including removed entries.
+	 *
+	 * @private
+	 */
+	size_t length;
+
+	/**
+	 * @brief The sparse index table, whose slots are either empty (`0`),
+	 * deleted, or an index into `entries` plus one.
+	 *
+	 * @private
+	 */
+	uint32_t *indices;
+
+	/**
+	 * @brief The size of `indices`, a power of two, or `0`.
+	 *
+	 * @private
+	 */
+	size_t capacity;
+};
+
+typedef struct MutableOrderedDictionary MutableOrderedDictionary;
+
+/**
+ * @brief The OrderedDictionary interface.
+ */
+struct OrderedDictionaryInterface {
+
+	/**
+	 * @brief The parent interface.
+	 */
+	DictionaryInterface dictionaryInterface;
+
+	/**
+	 * @brief Returns a new OrderedDictionary containing all pairs from `dictionary`.
+	 *
+	 * @param dictionary A Dictionary.
+	 *
+	 * @return The new OrderedDictionary, or `NULL` on error.
+	 *
+	 * @remark If `dictionary` is ordered, its order is retained.
+	 *
+	 * @relates OrderedDictionary
+	 */
+	OrderedDictionary *(*dictionaryWithDictionary)(const Dictionary *dictionary);
+
+	/**
+	 * @brief Returns a new OrderedDictionary containing pairs from the given
+	 * arguments, in order.
+	 *
+	 * @param obj The first in a NULL-terminated list of Objects and keys.
+	 *
+	 * @return The new OrderedDictionary, or `NULL` on error.
+	 *
+	 * @relates OrderedDictionary
+	 */
+	OrderedDictionary *(*dictionaryWithObjectsAndKeys)(id obj, ...);
+
+	/**
+	 * @brief Initializes this OrderedDictionary to contain all pairs from `dictionary`.
+	 *
+	 * @param dictionary A Dictionary.
+	 *
+	 * @return The initialized OrderedDictionary, or `NULL` on error.
+	 *
+	 * @remark If `dictionary` is ordered, its order is retained.
+	 *
+	 * @relates OrderedDictionary
+	 */
+	OrderedDictionary *(*initWithDictionary)(OrderedDictionary *self, const Dictionary *dictionary);
+
+	/**
+	 * @brief Initializes this OrderedDictionary with the NULL-terminated list
+	 * of Objects and keys, in order.
+	 *
+	 * @return The initialized OrderedDictionary, or `NULL` on error.
+	 *
+	 * @relates OrderedDictionary
+	 */
+	OrderedDictionary *(*initWithObjectsAndKeys)(OrderedDictionary *self, ...);
+
+	/**
+	 * @return A MutableOrderedDictionary with the contents of this
+	 * OrderedDictionary, in order.
+	 *
+	 * @relates OrderedDictionary
+	 */
+	MutableOrderedDictionary *(*mutableCopy)(const OrderedDictionary *self);
+};
+
+/**
+ * @brief The OrderedDictionary Class.
+ */
+extern Class _OrderedDictionary;
+
+/**
+ * @brief The OrderedDictionary table primitives, which MutableOrderedDictionary
+ * shares.
+ *
+ * @see _Dictionary_find(const Dictionary *, const id, const uint64_t)
+ *
+ * @private
+ */
+extern DictionaryEntry *_OrderedDictionary_find(const OrderedDictionary *self, const id key,
+		const uint64_t hash);
+extern DictionaryEntry *_OrderedDictionary_insert(OrderedDictionary *self, const uint64_t hash);
+extern void _OrderedDictionary_erase(OrderedDictionary *self, DictionaryEntry *entry);
+extern void _OrderedDictionary_clear(OrderedDictionary *self);
+extern void _OrderedDictionary_reserve(OrderedDictionary *self, size_t count);
+extern void _OrderedDictionary_compact(OrderedDictionary *self);
+
+#endif
@@ -0,0 +1,236 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <assert.h>
+#include <execinfo.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <pthread.h>
+
+#include <Objectively/Profile.h>
+
+/**
+ * @brief The maximum depth of sampled call stacks.
+ */
+#define PROFILE_MAX_FRAMES 64
+
+/**
+ * @brief The number of buckets in the sample table. This must be a power of two.
+ */
+#define PROFILE_BUCKETS 4096
+
+/**
+ * @brief The frames of `_profileAlloc` and `_alloc`, which are not recorded.
+ */
+#define PROFILE_SKIP_FRAMES 2
+
+/**
+ * @brief A sampled instance.
+ */
+typedef struct Sample {
+
+	/**
+	 * @brief The sampled instance.
+	 */
+	id obj;
+
+	/**
+	 * @brief The Class of the sampled instance.
+	 */
+	const Class *clazz;
+
+	/**
+	 * @brief The estimated bytes that this sample represents.
+	 */
+	size_t weight;
+
+	/**
+	 * @brief The depth of `frames`.
+	 */
+	int depth;
+
+	/**
+	 * @brief The allocating call stack, innermost frame first.
+	 */
+	void *frames[PROFILE_MAX_FRAMES];
+
+	/**
+	 * @brief The next Sample in this bucket.
+	 */
+	struct Sample *next;
+} Sample;
+
+size_t _profileInterval;
+
+/**
+ * @brief The bytes the calling thread must allocate before its next sample.
+ */
+static __thread size_t _bytesUntilSample;
+
+/**
+ * @brief `YES` once `_bytesUntilSample` has been seeded for the calling thread.
+ */
+static __thread BOOL _isCountingDown;
+
+/**
+ * @brief The live Samples, hashed by instance address.
+ */
+static Sample *_samples[PROFILE_BUCKETS];
+
+/**
+ * @brief The lock guarding `_samples`.
+ */
+static pthread_mutex_t _samplesLock = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+ * @return The bucket for `obj` in `_samples`.
+ */
+static size_t bucketForObject(const id obj) {
+	return (((uintptr_t) obj) >> 4) & (PROFILE_BUCKETS - 1);
+}
+
+/**
+ * @return A pseudo-random interval in [0, 2 * interval), so that samples are
+ * not biased by periodic allocation patterns.
+ */
+static size_t nextInterval(size_t interval) {
+	static __thread unsigned int seed;
+
+	if (seed == 0) {
+		seed = (unsigned int) (uintptr_t) &seed;
+	}
+
+	return (size_t) (((double) rand_r(&seed) / RAND_MAX) * 2.0 * interval);
+}
+
+BOOL _profileAlloc(const id obj) {
+
+	const size_t interval = _profileInterval;
+	const size_t size = ((Object *) obj)->clazz->instanceSize;
+
+	if (_isCountingDown == NO) {
+		_bytesUntilSample = nextInterval(interval);
+		_isCountingDown = YES;
+	}
+
+	if (_bytesUntilSample > size) {
+		_bytesUntilSample -= size;
+		return NO;
+	}
+
+	_bytesUntilSample = nextInterval(interval);
+
+	Sample *sample = malloc(sizeof(Sample));
+	assert(sample);
+
+	void *frames[PROFILE_MAX_FRAMES + PROFILE_SKIP_FRAMES];
+	const int depth = backtrace(frames, lengthof(frames)) - PROFILE_SKIP_FRAMES;
+
+	sample->obj = obj;
+	sample->clazz = ((Object *) obj)->clazz;
+	sample->weight = max(interval, size);
+	sample->depth = max(depth, 0);
+
+	memcpy(sample->frames, frames + PROFILE_SKIP_FRAMES, sample->depth * sizeof(void *));
+
+	const size_t bucket = bucketForObject(obj);
+
+	pthread_mutex_lock(&_samplesLock);
+
+	sample->next = _samples[bucket];
+	_samples[bucket] = sample;
+
+	pthread_mutex_unlock(&_samplesLock);
+
+	return YES;
+}
+
+void _profileDealloc(const id obj) {
+
+	Sample *sample = NULL;
+
+	pthread_mutex_lock(&_samplesLock);
+
+	for (Sample **s = &_samples[bucketForObject(obj)]; *s; s = &(*s)->next) {
+		if ((*s)->obj == obj) {
+			sample = *s;
+			*s = sample->next;
+			break;
+		}
+	}
+
+	pthread_mutex_unlock(&_samplesLock);
+
+	free(sample);
+}
+
+/**
+ * @brief Writes the name of the function in `symbol`, as formatted by
+ * `backtrace_symbols`, or else its address, to `file`.
+ */
+static void writeFrame(FILE *file, const char *symbol, const void *frame) {
+
+	const char *name = strchr(symbol, '(');
+	if (name) {
+		name++;
+
+		const size_t length = strcspn(name, "+)");
+		if (length) {
+			fprintf(file, "%.*s;", (int) length, name);
+			return;
+		}
+	}
+
+	fprintf(file, "%p;", frame);
+}
+
+BOOL ProfileWrite(const char *path) {
+
+	FILE *file = fopen(path, "w");
+	if (file == NULL) {
+		return NO;
+	}
+
+	pthread_mutex_lock(&_samplesLock);
+
+	for (size_t i = 0; i < PROFILE_BUCKETS; i++) {
+		for (const Sample *sample = _samples[i]; sample; sample = sample->next) {
+
+			char **symbols = backtrace_symbols((void *const *) sample->frames, sample->depth);
+
+			for (int j = sample->depth - 1; j >= 0; j--) {
+				writeFrame(file, symbols ? symbols[j] : "", sample->frames[j]);
+			}
+
+			fprintf(file, "%s %zu\n", sample->clazz->name, sample->weight);
+
+			free(symbols);
+		}
+	}
+
+	pthread_mutex_unlock(&_samplesLock);
+
+	return fclose(file) == 0;
+}
@@ -0,0 +1,82 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef _Objectively_Profile_h_
+#define _Objectively_Profile_h_
+
+#include <Objectively/Object.h>
+
+/**
+ * @file
+ *
+ * @brief A sampling profiler of live Objects.
+ *
+ * When enabled, the allocating call stack of roughly one instance per
+ * `_profileInterval` bytes allocated is recorded, along with its Class and
+ * size. Samples are retained until their instance is deallocated, so that the
+ * profile describes the live heap, attributed to the code paths that created
+ * it.
+ *
+ * Profiles are written in the collapsed stack format understood by
+ * `flamegraph.pl` and similar tools. Link with `-rdynamic` for function names.
+ */
+
+/**
+ * @brief The mean number of bytes allocated between samples. Profiling is
+ * disabled when this is `0` (the default).
+ *
+ * @remark This is read from `OBJECTIVELY_PROFILE` in the environment at
+ * startup, and may be assigned at any time.
+ */
+extern size_t _profileInterval;
+
+/**
+ * @brief Samples the newly allocated `obj`, if it is due.
+ *
+ * @return `YES` if `obj` was sampled, `NO` otherwise.
+ *
+ * @private
+ */
+extern BOOL _profileAlloc(const id obj);
+
+/**
+ * @brief Discards the sample of `obj`, which is being deallocated.
+ *
+ * @private
+ */
+extern void _profileDealloc(const id obj);
+
+/**
+ * @brief Writes the live heap profile to the given file.
+ *
+ * @param path The path of the file to write.
+ *
+ * @return `YES` if the profile was written, `NO` on error.
+ *
+ * @remark Each line is a semicolon-delimited call stack, outermost frame
+ * first, ending with the Class name. It is followed by the estimated bytes
+ * of live instances allocated from that stack.
+ */
+extern BOOL ProfileWrite(const char *path);
+
+#endif
@@ -0,0 +1,212 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <assert.h>
+#include <stdlib.h>
+
+#include <pthread.h>
+
+#include <Objectively/Once.h>
+#include <Objectively/Reclaimer.h>
+
+/**
+ * @brief A collection awaiting the reclaimer.
+ */
+typedef struct {
+
+	/**
+	 * @brief The collection.
+	 */
+	Object *obj;
+
+	/**
+	 * @brief The `dealloc` implementation to call.
+	 */
+	void (*dealloc)(Object *);
+} Reclamation;
+
+size_t _reclaimThreshold;
+
+/**
+ * @brief The queue of collections awaiting the reclaimer.
+ */
+static Reclamation _queue[RECLAIMER_CAPACITY];
+
+/**
+ * @brief The index of the head of `_queue`.
+ */
+static size_t _head;
+
+/**
+ * @brief The metrics.
+ */
+static ReclaimerStatistics _statistics;
+
+/**
+ * @brief `YES` while the reclaimer is deallocating a collection.
+ */
+static BOOL _isReclaiming;
+
+/**
+ * @brief The lock guarding the queue and metrics.
+ */
+static pthread_mutex_t _lock = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+ * @brief Signaled when collections are queued.
+ */
+static pthread_cond_t _queued = PTHREAD_COND_INITIALIZER;
+
+/**
+ * @brief Signaled when the queue is drained.
+ */
+static pthread_cond_t _drained = PTHREAD_COND_INITIALIZER;
+
+/**
+ * @brief `YES` on the reclaimer thread.
+ */
+static __thread BOOL _isReclaimer;
+
+/**
+ * @brief The reclaimer thread.
+ */
+static void *reclaimer(void *data) {
+
+	_isReclaimer = YES;
+
+	pthread_mutex_lock(&_lock);
+
+	while (YES) {
+
+		while (_statistics.depth == 0) {
+			pthread_cond_wait(&_queued, &_lock);
+		}
+
+		const Reclamation reclamation = _queue[_head];
+
+		_head = (_head + 1) % RECLAIMER_CAPACITY;
+		_statistics.depth--;
+
+		_isReclaiming = YES;
+
+		pthread_mutex_unlock(&_lock);
+
+		reclamation.dealloc(reclamation.obj);
+
+		pthread_mutex_lock(&_lock);
+
+		_isReclaiming = NO;
+		_statistics.reclaimed++;
+
+		if (_statistics.depth == 0) {
+			pthread_cond_broadcast(&_drained);
+		}
+	}
+
+	return NULL;
+}
+
+/**
+ * @brief Starts the reclaimer thread.
+ */
+static void startReclaimer(void) {
+
+	pthread_t thread;
+
+	int err = pthread_create(&thread, NULL, reclaimer, NULL);
+	assert(err == 0);
+
+	err = pthread_detach(thread);
+	assert(err == 0);
+
+	atexit(ReclaimerWait);
+}
+
+BOOL _reclaim(Object *obj, size_t count, void (*dealloc)(Object *)) {
+
+	const size_t threshold = _reclaimThreshold;
+
+	if (threshold == 0 || count < threshold || _isReclaimer) {
+		return NO;
+	}
+
+	if (obj->referenceCount == REFERENCE_COUNT_IMMORTAL) {
+		return NO;
+	}
+
+	static Once once;
+
+	DispatchOnce(once, {
+		startReclaimer();
+	});
+
+	BOOL queued = NO;
+
+	pthread_mutex_lock(&_lock);
+
+	if (_statistics.depth < RECLAIMER_CAPACITY) {
+
+		_queue[(_head + _statistics.depth) % RECLAIMER_CAPACITY] = (Reclamation) {
+			.obj = obj,
+			.dealloc = dealloc
+		};
+
+		_statistics.depth++;
+		_statistics.maxDepth = max(_statistics.maxDepth, _statistics.depth);
+		_statistics.queued++;
+
+		pthread_cond_signal(&_queued);
+
+		queued = YES;
+	} else {
+		_statistics.rejected++;
+	}
+
+	pthread_mutex_unlock(&_lock);
+
+	return queued;
+}
+
+ReclaimerStatistics ReclaimerGetStatistics(void) {
+
+	pthread_mutex_lock(&_lock);
+
+	const ReclaimerStatistics statistics = _statistics;
+
+	pthread_mutex_unlock(&_lock);
+
+	return statistics;
+}
+
+void ReclaimerWait(void) {
+
+	assert(_isReclaimer == NO);
+
+	pthread_mutex_lock(&_lock);
+
+	while (_statistics.depth || _isReclaiming) {
+		pthread_cond_wait(&_drained, &_lock);
+	}
+
+	pthread_mutex_unlock(&_lock);
+}
@@ -0,0 +1,113 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef _Objectively_Reclaimer_h_
+#define _Objectively_Reclaimer_h_
+
+#include <Objectively/Object.h>
+
+/**
+ * @file
+ *
+ * @brief Background deallocation of large collections.
+ *
+ * Deallocating a large collection releases each of its elements, which may in
+ * turn deallocate entire Object graphs. When enabled, collections of at least
+ * `_reclaimThreshold` elements are instead deallocated by a background
+ * reclaimer thread, off the releasing thread's hot path.
+ */
+
+/**
+ * @brief The maximum number of collections awaiting the reclaimer. When the
+ * queue is full, collections are deallocated by the releasing thread.
+ */
+#define RECLAIMER_CAPACITY 256
+
+/**
+ * @brief Reclaimer metrics.
+ */
+typedef struct {
+
+	/**
+	 * @brief The count of collections handed to the reclaimer.
+	 */
+	size_t queued;
+
+	/**
+	 * @brief The count of collections deallocated by the reclaimer.
+	 */
+	size_t reclaimed;
+
+	/**
+	 * @brief The count of collections deallocated by the releasing thread
+	 * because the queue was full.
+	 */
+	size_t rejected;
+
+	/**
+	 * @brief The count of collections awaiting the reclaimer.
+	 */
+	size_t depth;
+
+	/**
+	 * @brief The greatest `depth` observed.
+	 */
+	size_t maxDepth;
+} ReclaimerStatistics;
+
+/**
+ * @brief The minimum element count of collections deallocated in the
+ * background. Background deallocation is disabled when this is `0` (the
+ * default).
+ *
+ * @remark This is read from `OBJECTIVELY_RECLAIM` in the environment at
+ * startup, and may be assigned at any time.
+ */
+extern size_t _reclaimThreshold;
+
+/**
+ * @brief Hands `obj`, which is being deallocated, to the reclaimer, if it has
+ * at least `_reclaimThreshold` elements.
+ *
+ * @param obj The collection.
+ * @param count The element count of `obj`.
+ * @param dealloc The `dealloc` implementation that the reclaimer should call.
+ *
+ * @return `YES` if `obj` will be deallocated by the reclaimer, in which case
+ * the caller must return immediately. `NO` if the caller should proceed.
+ *
+ * @private
+ */
+extern BOOL _reclaim(Object *obj, size_t count, void (*dealloc)(Object *));
+
+/**
+ * @return The reclaimer's metrics.
+ */
+extern ReclaimerStatistics ReclaimerGetStatistics(void);
+
+/**
+ * @brief Waits for the reclaimer to deallocate all queued collections.
+ */
+extern void ReclaimerWait(void);
+
+#endif
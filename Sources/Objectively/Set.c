@@ -24,15 +24,194 @@
 #include <assert.h>
 #include <stdarg.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include <Objectively/Hash.h>
 #include <Objectively/MutableArray.h>
 #include <Objectively/MutableSet.h>
+#include <Objectively/OperationQueue.h>
+#include <Objectively/Reclaimer.h>
 #include <Objectively/Set.h>
 #include <Objectively/String.h>
 
+#include "SwissTable.h"
+
 #define _Class _Set
 
+/**
+ * @brief The count of slots in each iteration of the concurrent methods.
+ */
+#define CONCURRENT_CHUNK_SIZE 4096
+
+#if SET_GROUP_SIZE != SWISS_TABLE_GROUP_SIZE
+#error SET_GROUP_SIZE must equal SWISS_TABLE_GROUP_SIZE
+#endif
+
+#pragma mark - Table
+
+/**
+ * @brief Allocates an empty table of `capacity` slots for `self`.
+ */
+static void allocate(Set *self, size_t capacity) {
+
+	self->entries = SwissTableAllocate(SwissTableOf(self), capacity);
+}
+
+uint64_t _Set_hashForObject(const Set *self, const id obj) {
+
+	return HashForObject64(HASH_SEED, obj);
+}
+
+/**
+ * @brief SwissTableEquality for _Set_find.
+ */
+static BOOL find_equality(const void *entry, const void *obj) {
+
+	const id other = ((const SetEntry *) entry)->obj;
+
+	return other == obj || $((Object *) other, isEqual, obj);
+}
+
+SetEntry *_Set_find(const Set *self, const id obj, const uint64_t hash) {
+
+	if (self->count == 0) {
+		return NULL;
+	}
+
+	return SwissTableFind(self->control, self->entries, self->capacity, sizeof(SetEntry),
+			hash, find_equality, obj);
+}
+
+/**
+ * @brief The bytes of a String for findBytes.
+ */
+typedef struct {
+	const byte *bytes;
+	size_t length;
+} Bytes;
+
+/**
+ * @brief SwissTableEquality for findBytes.
+ */
+static BOOL findBytes_equality(const void *entry, const void *data) {
+
+	const Bytes *bytes = data;
+
+	return _String_isEqualToBytes(((const SetEntry *) entry)->obj, bytes->bytes, bytes->length);
+}
+
+/**
+ * @brief Finds the entry whose Object is a String equal to `bytes`.
+ *
+ * @see _Set_find(const Set *, const id, const uint64_t)
+ */
+static SetEntry *findBytes(const Set *self, const byte *bytes, const size_t length,
+		const uint64_t hash) {
+
+	if (self->count == 0) {
+		return NULL;
+	}
+
+	const Bytes data = { .bytes = bytes, .length = length };
+
+	return SwissTableFind(self->control, self->entries, self->capacity, sizeof(SetEntry),
+			hash, findBytes_equality, &data);
+}
+
+SetEntry *_Set_insert(Set *self, const uint64_t hash) {
+
+	self->entries = SwissTableReserve(SwissTableOf(self));
+
+	return SwissTableInsert(SwissTableOf(self), self->entries, hash);
+}
+
+void _Set_erase(Set *self, SetEntry *entry) {
+
+	SwissTableErase(SwissTableOf(self), self->entries, entry);
+
+	entry->obj = NULL;
+}
+
+void _Set_clear(Set *self) {
+
+	SwissTableClear(SwissTableOf(self));
+}
+
+void _Set_resize(Set *self, size_t count) {
+
+	self->entries = SwissTableResize(SwissTableOf(self), count);
+}
+
+#pragma mark - Algebra
+
+/**
+ * @brief Removes and releases the Object of `entry` from `self`.
+ */
+static void removeEntry(Set *self, SetEntry *entry) {
+
+	const id obj = entry->obj;
+
+	_Set_erase(self, entry);
+
+	release(obj);
+}
+
+void _Set_intersect(Set *self, const Set *set) {
+
+	for (size_t i = 0; i < self->capacity; i++) {
+		if (isFull(self->control[i])) {
+
+			SetEntry *entry = self->entries + i;
+
+			if (_Set_find(set, entry->obj, entry->hash) == NULL) {
+				removeEntry(self, entry);
+			}
+		}
+	}
+}
+
+void _Set_minus(Set *self, const Set *set) {
+
+	if (set->count < self->count) {
+		for (size_t i = 0; i < set->capacity; i++) {
+			if (isFull(set->control[i])) {
+
+				const SetEntry *entry = set->entries + i;
+
+				SetEntry *existing = _Set_find(self, entry->obj, entry->hash);
+				if (existing) {
+					removeEntry(self, existing);
+				}
+			}
+		}
+	} else {
+		for (size_t i = 0; i < self->capacity; i++) {
+			if (isFull(self->control[i])) {
+
+				SetEntry *entry = self->entries + i;
+
+				if (_Set_find(set, entry->obj, entry->hash)) {
+					removeEntry(self, entry);
+				}
+			}
+		}
+	}
+}
+
+void _Set_union(Set *self, const Set *set) {
+
+	for (size_t i = 0; i < set->capacity; i++) {
+		if (isFull(set->control[i])) {
+
+			const SetEntry *entry = set->entries + i;
+
+			if (_Set_find(self, entry->obj, entry->hash) == NULL) {
+				_Set_insert(self, entry->hash)->obj = retain(entry->obj);
+			}
+		}
+	}
+}
+
 #pragma mark - ObjectInterface
 
 /**
@@ -54,11 +233,17 @@ static void dealloc(Object *self) {
 
 	Set *this = (Set *) self;
 
+	if (_reclaim(self, this->count, dealloc)) {
+		return;
+	}
+
 	for (size_t i = 0; i < this->capacity; i++) {
-		release(this->elements[i]);
+		if (isFull(this->control[i])) {
+			release(this->entries[i].obj);
+		}
 	}
 
-	free(this->elements);
+	free(this->control);
 
 	super(Object, self, dealloc);
 }
@@ -83,8 +268,8 @@ static int hash(const Object *self) {
 	int hash = HashForInteger(HASH_SEED, this->count);
 
 	for (size_t i = 0; i < this->capacity; i++) {
-		if (this->elements[i]) {
-			hash = HashForObject(hash, this->elements[i]);
+		if (isFull(this->control[i])) {
+			hash += HashForObject(HASH_SEED, this->entries[i].obj);
 		}
 	}
 
@@ -105,22 +290,22 @@ static BOOL isEqual(const Object *self, const Object *other) {
 		const Set *this = (Set *) self;
 		const Set *that = (Set *) other;
 
-		if (this->count == that->count) {
+		if (this->count != that->count || this->hashes != that->hashes) {
+			return NO;
+		}
 
-			Array *objects = $(this, allObjects);
+		for (size_t i = 0; i < this->capacity; i++) {
+			if (isFull(this->control[i])) {
 
-			for (size_t i = 0; i < objects->count; i++) {
-				const id obj = $(objects, objectAtIndex, i);
+				const SetEntry *entry = this->entries + i;
 
-				if ($(that, containsObject, obj) == NO) {
-					release(objects);
+				if (_Set_find(that, entry->obj, entry->hash) == NULL) {
 					return NO;
 				}
 			}
-
-			release(objects);
-			return YES;
 		}
+
+		return YES;
 	}
 
 	return NO;
@@ -149,18 +334,27 @@ static Array *allObjects(const Set *self) {
 }
 
 /**
- * @see SetInterface::containsObject(const Set *, const id)
+ * @see SetInterface::containsBytes(const Set *, const byte *, size_t)
  */
-static BOOL containsObject(const Set *self, const id obj) {
+static BOOL containsBytes(const Set *self, const byte *bytes, size_t length) {
 
-	const size_t bin = HashForObject(HASH_SEED, obj) % self->capacity;
+	return findBytes(self, bytes, length, _String_hashForBytes(NULL, bytes, length)) != NULL;
+}
 
-	const Array *array = self->elements[bin];
-	if (array) {
-		return $(array, containsObject, obj);
-	}
+/**
+ * @see SetInterface::containsCharacters(const Set *, const char *)
+ */
+static BOOL containsCharacters(const Set *self, const char *chars) {
 
-	return NO;
+	return $(self, containsBytes, (const byte *) chars, strlen(chars));
+}
+
+/**
+ * @see SetInterface::containsObject(const Set *, const id)
+ */
+static BOOL containsObject(const Set *self, const id obj) {
+
+	return _Set_find(self, obj, _Set_hashForObject(self, obj)) != NULL;
 }
 
 /**
@@ -171,21 +365,86 @@ static void enumerateObjects(const Set *self, SetEnumerator enumerator, id data)
 	assert(enumerator);
 
 	for (size_t i = 0; i < self->capacity; i++) {
+		if (isFull(self->control[i])) {
+			if (enumerator(self, self->entries[i].obj, data)) {
+				return;
+			}
+		}
+	}
+}
 
-		Array *array = self->elements[i];
-		if (array) {
+/**
+ * @brief The state of the concurrent methods, which their iterations share.
+ */
+typedef struct {
+	const Set *set;
+	SetEnumerator enumerator;
+	id data;
+	BOOL stop;
+	SetEntry *matches;
+	size_t *offsets;
+	size_t *counts;
+} Concurrent;
 
-			for (size_t j = 0; j < array->count; j++) {
-				id obj = $(array, objectAtIndex, j);
+/**
+ * @return The count of iterations of the concurrent methods for `set`.
+ */
+static size_t chunks(const Set *set) {
 
-				if (enumerator(self, obj, data)) {
-					return;
-				}
+	return (set->capacity + CONCURRENT_CHUNK_SIZE - 1) / CONCURRENT_CHUNK_SIZE;
+}
+
+/**
+ * @return The slot after the last slot of `chunk`.
+ */
+static size_t chunkEnd(const Set *set, size_t chunk) {
+
+	const size_t end = (chunk + 1) * CONCURRENT_CHUNK_SIZE;
+
+	return end < set->capacity ? end : set->capacity;
+}
+
+/**
+ * @brief ApplyFunction for enumerateObjectsConcurrently.
+ */
+static void enumerateObjectsConcurrently_apply(size_t chunk, id data) {
+
+	Concurrent *concurrent = data;
+
+	const Set *self = concurrent->set;
+	const size_t end = chunkEnd(self, chunk);
+
+	for (size_t i = chunk * CONCURRENT_CHUNK_SIZE; i < end; i++) {
+		if (isFull(self->control[i])) {
+
+			if (__atomic_load_n(&concurrent->stop, __ATOMIC_RELAXED)) {
+				break;
+			}
+
+			if (concurrent->enumerator(self, self->entries[i].obj, concurrent->data)) {
+				__atomic_store_n(&concurrent->stop, YES, __ATOMIC_RELAXED);
+				break;
 			}
 		}
 	}
 }
 
+/**
+ * @see SetInterface::enumerateObjectsConcurrently(const Set *, SetEnumerator, id)
+ */
+static void enumerateObjectsConcurrently(const Set *self, SetEnumerator enumerator, id data) {
+
+	assert(enumerator);
+
+	Concurrent concurrent = {
+		.set = self,
+		.enumerator = enumerator,
+		.data = data
+	};
+
+	$$(OperationQueue, apply, chunks(self), enumerateObjectsConcurrently_apply, &concurrent);
+}
+
 /**
  * @see SetInterface::filterObjects(const Set *, SetEnumerator, id)
  */
@@ -196,20 +455,115 @@ static Set *filterObjects(const Set *self, SetEnumerator enumerator, id data) {
 	MutableSet *set = $(alloc(MutableSet), init);
 
 	for (size_t i = 0; i < self->capacity; i++) {
+		if (isFull(self->control[i])) {
 
-		Array *array = self->elements[i];
-		if (array) {
+			const id obj = self->entries[i].obj;
 
-			for (size_t j = 0; j < array->count; j++) {
-				id obj = $(array, objectAtIndex, j);
+			if (enumerator(self, obj, data)) {
+				$(set, addObject, obj);
+			}
+		}
+	}
 
-				if (enumerator(self, obj, data)) {
-					$(set, addObject, obj);
-				}
+	return (Set *) set;
+}
+
+/**
+ * @return The count of full slots of `chunk`.
+ */
+static size_t chunkFull(const Set *set, size_t chunk) {
+
+	const size_t end = chunkEnd(set, chunk);
+
+	size_t count = 0;
+
+	for (size_t i = chunk * CONCURRENT_CHUNK_SIZE; i < end; i += SET_GROUP_SIZE) {
+		count += __builtin_popcount(SwissTableMatchFull(set->control + i));
+	}
+
+	return count;
+}
+
+/**
+ * @brief ApplyFunction for filterObjectsConcurrently, which gathers the
+ * matches of each chunk into its own region of the shared buffer, so that
+ * they are merged without locking.
+ */
+static void filterObjectsConcurrently_apply(size_t chunk, id data) {
+
+	Concurrent *concurrent = data;
+
+	const Set *self = concurrent->set;
+	const size_t end = chunkEnd(self, chunk);
+
+	SetEntry *matches = concurrent->matches + concurrent->offsets[chunk];
+	size_t count = 0;
+
+	for (size_t i = chunk * CONCURRENT_CHUNK_SIZE; i < end; i++) {
+		if (isFull(self->control[i])) {
+			if (concurrent->enumerator(self, self->entries[i].obj, concurrent->data)) {
+				matches[count++] = self->entries[i];
 			}
 		}
 	}
 
+	concurrent->counts[chunk] = count;
+}
+
+/**
+ * @see SetInterface::filterObjectsConcurrently(const Set *, SetEnumerator, id)
+ */
+static Set *filterObjectsConcurrently(const Set *self, SetEnumerator enumerator, id data) {
+
+	assert(enumerator);
+
+	if (self->count == 0) {
+		return (Set *) $(alloc(MutableSet), init);
+	}
+
+	const size_t count = chunks(self);
+
+	Concurrent concurrent = {
+		.set = self,
+		.enumerator = enumerator,
+		.data = data,
+		.matches = malloc(self->count * sizeof(SetEntry)),
+		.offsets = malloc(count * sizeof(size_t)),
+		.counts = calloc(count, sizeof(size_t))
+	};
+
+	assert(concurrent.matches);
+	assert(concurrent.offsets);
+	assert(concurrent.counts);
+
+	size_t offset = 0;
+	for (size_t i = 0; i < count; i++) {
+		concurrent.offsets[i] = offset;
+		offset += chunkFull(self, i);
+	}
+
+	assert(offset == self->count);
+
+	$$(OperationQueue, apply, count, filterObjectsConcurrently_apply, &concurrent);
+
+	size_t total = 0;
+	for (size_t i = 0; i < count; i++) {
+		total += concurrent.counts[i];
+	}
+
+	MutableSet *set = $(alloc(MutableSet), initWithCapacity, total);
+
+	for (size_t i = 0; i < count; i++) {
+		const SetEntry *matches = concurrent.matches + concurrent.offsets[i];
+		for (size_t j = 0; j < concurrent.counts[i]; j++) {
+			_Set_insert((Set *) set, matches[j].hash)->obj = retain(matches[j].obj);
+		}
+	}
+
+	free(concurrent.matches);
+	free(concurrent.offsets);
+	free(concurrent.counts);
+
 	return (Set *) set;
 }
 
@@ -236,14 +590,6 @@ static Set *initWithArray(Set *self, const Array *array) {
 	return self;
 }
 
-/**
- * @brief SetEnumerator for initWithSet.
- */
-static BOOL initWithSet_enumerator(const Set *set, id obj, id data) {
-
-	$$(MutableSet, addObject, (MutableSet *) data, obj); return NO;
-}
-
 /**
  * @see SetInterface::initWithSet(Set *, const Set *)
  */
@@ -252,7 +598,22 @@ static Set *initWithSet(Set *self, const Set *set) {
 	self = (Set *) super(Object, self, init);
 	if (self) {
 		if (set) {
-			$(set, enumerateObjects, initWithSet_enumerator, self);
+
+			allocate(self, set->capacity);
+
+			if (self->capacity) {
+				memcpy(self->control, set->control, self->capacity + self->capacity * sizeof(SetEntry));
+
+				for (size_t i = 0; i < self->capacity; i++) {
+					if (isFull(self->control[i])) {
+						retain(self->entries[i].obj);
+					}
+				}
+			}
+
+			self->count = set->count;
+			self->growth = set->growth;
+			self->hashes = set->hashes;
 		}
 	}
 
@@ -286,6 +647,154 @@ static Set *initWithObjects(Set *self, ...) {
 	return self;
 }
 
+/**
+ * @see SetInterface::intersectsSet(const Set *, const Set *)
+ */
+static BOOL intersectsSet(const Set *self, const Set *set) {
+
+	assert(set);
+
+	const Set *smaller = self->count < set->count ? self : set;
+	const Set *larger = smaller == self ? set : self;
+
+	for (size_t i = 0; i < smaller->capacity; i++) {
+		if (isFull(smaller->control[i])) {
+
+			const SetEntry *entry = smaller->entries + i;
+
+			if (_Set_find(larger, entry->obj, entry->hash)) {
+				return YES;
+			}
+		}
+	}
+
+	return NO;
+}
+
+/**
+ * @see SetInterface::isSubsetOfSet(const Set *, const Set *)
+ */
+static BOOL isSubsetOfSet(const Set *self, const Set *set) {
+
+	assert(set);
+
+	if (self->count > set->count) {
+		return NO;
+	}
+
+	for (size_t i = 0; i < self->capacity; i++) {
+		if (isFull(self->control[i])) {
+
+			const SetEntry *entry = self->entries + i;
+
+			if (_Set_find(set, entry->obj, entry->hash) == NULL) {
+				return NO;
+			}
+		}
+	}
+
+	return YES;
+}
+
+/**
+ * @see SetInterface::nextObjects(const Set *, Cursor *)
+ */
+static size_t nextObjects(const Set *self, Cursor *cursor) {
+
+	_CursorCheckMutations(cursor, &self->mutations);
+
+	cursor->objects = cursor->objectBuffer;
+	cursor->count = 0;
+
+	while (cursor->state < self->capacity && cursor->count + SET_GROUP_SIZE <= CURSOR_BATCH_SIZE) {
+
+		const SetEntry *entries = self->entries + cursor->state;
+
+		for (unsigned m = SwissTableMatchFull(self->control + cursor->state); m; m &= m - 1) {
+			cursor->objects[cursor->count++] = entries[__builtin_ctz(m)].obj;
+		}
+
+		cursor->state += SET_GROUP_SIZE;
+	}
+
+	return cursor->count;
+}
+
+/**
+ * @see SetInterface::setByIntersectingSet(const Set *, const Set *)
+ */
+static Set *setByIntersectingSet(const Set *self, const Set *set) {
+
+	assert(set);
+
+	const Set *smaller = self->count < set->count ? self : set;
+	const Set *larger = smaller == self ? set : self;
+
+	Set *intersection = (Set *) $(alloc(MutableSet), initWithCapacity, smaller->count);
+
+	for (size_t i = 0; i < smaller->capacity; i++) {
+		if (isFull(smaller->control[i])) {
+
+			const SetEntry *entry = smaller->entries + i;
+
+			if (_Set_find(larger, entry->obj, entry->hash)) {
+				_Set_insert(intersection, entry->hash)->obj = retain(entry->obj);
+			}
+		}
+	}
+
+	return intersection;
+}
+
+/**
+ * @see SetInterface::setBySubtractingSet(const Set *, const Set *)
+ */
+static Set *setBySubtractingSet(const Set *self, const Set *set) {
+
+	assert(set);
+
+	if (set->count < self->count) {
+
+		Set *difference = $((Set *) alloc(MutableSet), initWithSet, self);
+
+		_Set_minus(difference, set);
+
+		return difference;
+	}
+
+	Set *difference = (Set *) $(alloc(MutableSet), initWithCapacity, self->count);
+
+	for (size_t i = 0; i < self->capacity; i++) {
+		if (isFull(self->control[i])) {
+
+			const SetEntry *entry = self->entries + i;
+
+			if (_Set_find(set, entry->obj, entry->hash) == NULL) {
+				_Set_insert(difference, entry->hash)->obj = retain(entry->obj);
+			}
+		}
+	}
+
+	return difference;
+}
+
+/**
+ * @see SetInterface::setByUnioningSet(const Set *, const Set *)
+ */
+static Set *setByUnioningSet(const Set *self, const Set *set) {
+
+	assert(set);
+
+	const Set *smaller = self->count < set->count ? self : set;
+	const Set *larger = smaller == self ? set : self;
+
+	Set *that = $((Set *) alloc(MutableSet), initWithSet, larger);
+
+	_Set_union(that, smaller);
+
+	return that;
+}
+
 /**
  * @see SetInterface::setWithArray(const Array *)
  */
@@ -342,12 +851,22 @@ static void initialize(Class *clazz) {
 	SetInterface *set = (SetInterface *) clazz->interface;
 
 	set->allObjects = allObjects;
+	set->containsBytes = containsBytes;
+	set->containsCharacters = containsCharacters;
 	set->containsObject = containsObject;
 	set->enumerateObjects = enumerateObjects;
+	set->enumerateObjectsConcurrently = enumerateObjectsConcurrently;
 	set->filterObjects = filterObjects;
+	set->filterObjectsConcurrently = filterObjectsConcurrently;
 	set->initWithArray = initWithArray;
 	set->initWithSet = initWithSet;
 	set->initWithObjects = initWithObjects;
+	set->intersectsSet = intersectsSet;
+	set->isSubsetOfSet = isSubsetOfSet;
+	set->nextObjects = nextObjects;
+	set->setByIntersectingSet = setByIntersectingSet;
+	set->setBySubtractingSet = setBySubtractingSet;
+	set->setByUnioningSet = setByUnioningSet;
 	set->setWithArray = setWithArray;
 	set->setWithObjects = setWithObjects;
 	set->setWithSet = setWithSet;
@@ -25,6 +25,7 @@
 #define _Objectively_Set_h_
 
 #include <Objectively/Array.h>
+#include <Objectively/Cursor.h>
 #include <Objectively/Object.h>
 
 /**
@@ -53,6 +54,29 @@ typedef struct SetInterface SetInterface;
  */
 typedef BOOL (*SetEnumerator)(const Set *set, id obj, id data);
 
+/**
+ * @brief The number of slots whose control bytes are probed together.
+ */
+#define SET_GROUP_SIZE 16
+
+/**
+ * @brief A slot of a Set.
+ *
+ * @private
+ */
+typedef struct {
+
+	/**
+	 * @brief The hash of `obj`.
+	 */
+	uint64_t hash;
+
+	/**
+	 * @brief The Object.
+	 */
+	id obj;
+} SetEntry;
+
 /**
  * @brief Immutable sets.
  *
@@ -77,7 +101,8 @@ struct Set {
 	SetInterface *interface;
 
 	/**
-	 * @brief The internal size (number of bins).
+	 * @brief The internal size (number of slots), a power of two multiple of
+	 * `SET_GROUP_SIZE`, or `0`.
 	 *
 	 * @private
 	 */
@@ -89,11 +114,42 @@ struct Set {
 	size_t count;
 
 	/**
-	 * @brief The elements.
+	 * @brief The control bytes, one per slot, which are either empty, deleted,
+	 * or the low 7 bits of the hash of the slot's Object.
+	 *
+	 * @private
+	 */
+	byte *control;
+
+	/**
+	 * @brief The slots, which share an allocation with `control`.
+	 *
+	 * @private
+	 */
+	SetEntry *entries;
+
+	/**
+	 * @brief The count of elements that may be inserted before resizing.
+	 *
+	 * @private
+	 */
+	size_t growth;
+
+	/**
+	 * @brief The count of mutations, with which Cursors detect modification
+	 * during enumeration.
+	 *
+	 * @private
+	 */
+	size_t mutations;
+
+	/**
+	 * @brief The sum of the hashes of the elements, with which most unequal
+	 * Sets are told apart without probing.
 	 *
 	 * @private
 	 */
-	id *elements;
+	uint64_t hashes;
 };
 
 /**
@@ -113,6 +169,33 @@ struct SetInterface {
 	 */
 	Array *(*allObjects)(const Set *self);
 
+	/**
+	 * @brief Tests for a String matching the given bytes, without instantiating
+	 * a String.
+	 *
+	 * @param bytes The UTF-8 encoded characters of the String.
+	 * @param length The length of `bytes`.
+	 *
+	 * @return `YES` if this Set contains a String equal to `bytes`, `NO` otherwise.
+	 *
+	 * @relates Set
+	 */
+	BOOL (*containsBytes)(const Set *self, const byte *bytes, size_t length);
+
+	/**
+	 * @brief Tests for a String matching the given null-terminated characters,
+	 * without instantiating a String.
+	 *
+	 * @param chars The null-terminated UTF-8 encoded characters of the String.
+	 *
+	 * @return `YES` if this Set contains a String equal to `chars`, `NO` otherwise.
+	 *
+	 * @see containsBytes(const Set *, const byte *, size_t)
+	 *
+	 * @relates Set
+	 */
+	BOOL (*containsCharacters)(const Set *self, const char *chars);
+
 	/**
 	 * @return `YES` if this Set contains the given Object, `NO` otherwise.
 	 *
@@ -132,6 +215,22 @@ struct SetInterface {
 	 */
 	void (*enumerateObjects)(const Set *self, SetEnumerator enumerator, id data);
 
+	/**
+	 * @brief Enumerate the elements of this Set concurrently with the given
+	 * function.
+	 *
+	 * @param enumerator The enumerator function, which must be thread-safe.
+	 * @param data User data.
+	 *
+	 * @remark The enumerator should return `YES` to break the iteration, though
+	 * elements already being enumerated by other threads will still finish.
+	 *
+	 * @see OperationQueueInterface::apply(size_t, ApplyFunction, id)
+	 *
+	 * @relates Set
+	 */
+	void (*enumerateObjectsConcurrently)(const Set *self, SetEnumerator enumerator, id data);
+
 	/**
 	 * @brief Creates a new Set with elements that pass the filter function.
 	 *
@@ -144,6 +243,21 @@ struct SetInterface {
 	 */
 	Set *(*filterObjects)(const Set *self, SetEnumerator enumerator, id data);
 
+	/**
+	 * @brief Creates a new Set with elements that pass the filter function,
+	 * which is called concurrently.
+	 *
+	 * @param enumerator The enumerator function, which must be thread-safe.
+	 * @param data User data.
+	 *
+	 * @return The new, filtered Set.
+	 *
+	 * @see OperationQueueInterface::apply(size_t, ApplyFunction, id)
+	 *
+	 * @relates Set
+	 */
+	Set *(*filterObjectsConcurrently)(const Set *self, SetEnumerator enumerator, id data);
+
 	/**
 	 * @brief Initializes this Set to contain the Objects in `array`.
 	 *
@@ -175,6 +289,80 @@ struct SetInterface {
 	 */
 	Set *(*initWithSet)(Set *self, const Set *set);
 
+	/**
+	 * @param set A Set.
+	 *
+	 * @return `YES` if this Set and `set` have at least one Object in common.
+	 *
+	 * @remark The smaller of the two Sets is enumerated, and the larger probed.
+	 *
+	 * @relates Set
+	 */
+	BOOL (*intersectsSet)(const Set *self, const Set *set);
+
+	/**
+	 * @param set A Set.
+	 *
+	 * @return `YES` if every Object in this Set is also in `set`.
+	 *
+	 * @relates Set
+	 */
+	BOOL (*isSubsetOfSet)(const Set *self, const Set *set);
+
+	/**
+	 * @brief Fills `cursor` with the next batch of Objects in this Set.
+	 *
+	 * @param cursor The Cursor, initialized with `CursorInit` before the first batch.
+	 *
+	 * @return The count of Objects in the batch, or `0` when enumeration is complete.
+	 *
+	 * @see foreach
+	 *
+	 * @relates Set
+	 */
+	size_t (*nextObjects)(const Set *self, Cursor *cursor);
+
+	/**
+	 * @brief Creates a new Set with the Objects that are in both this Set and `set`.
+	 *
+	 * @param set A Set.
+	 *
+	 * @return The new Set.
+	 *
+	 * @remark The smaller of the two Sets is enumerated, and the larger probed.
+	 *
+	 * @relates Set
+	 */
+	Set *(*setByIntersectingSet)(const Set *self, const Set *set);
+
+	/**
+	 * @brief Creates a new Set with the Objects of this Set that are not in `set`.
+	 *
+	 * @param set A Set.
+	 *
+	 * @return The new Set.
+	 *
+	 * @remark If `set` is the smaller of the two, this Set is copied and the
+	 * Objects of `set` are removed from the copy.
+	 *
+	 * @relates Set
+	 */
+	Set *(*setBySubtractingSet)(const Set *self, const Set *set);
+
+	/**
+	 * @brief Creates a new Set with the Objects that are in either this Set or `set`.
+	 *
+	 * @param set A Set.
+	 *
+	 * @return The new Set.
+	 *
+	 * @remark The larger of the two Sets is copied, and the Objects of the
+	 * smaller are added to the copy.
+	 *
+	 * @relates Set
+	 */
+	Set *(*setByUnioningSet)(const Set *self, const Set *set);
+
 	/**
 	 * @brief Returns a new Set with the contents of `array`.
 	 *
@@ -214,4 +402,34 @@ struct SetInterface {
  */
 extern Class _Set;
 
+/**
+ * @brief The Set table primitives, which MutableSet shares.
+ *
+ * Set is an open-addressing hash table, laid out as Dictionary is, but whose
+ * slots hold only an Object and its hash.
+ *
+ * @see _Dictionary_find(const Dictionary *, const id, const uint64_t)
+ *
+ * @private
+ */
+extern uint64_t _Set_hashForObject(const Set *self, const id obj);
+extern SetEntry *_Set_find(const Set *self, const id obj, const uint64_t hash);
+extern SetEntry *_Set_insert(Set *self, const uint64_t hash);
+extern void _Set_erase(Set *self, SetEntry *entry);
+extern void _Set_clear(Set *self);
+extern void _Set_resize(Set *self, size_t count);
+
+/**
+ * @brief The in-place Set algebra primitives, which MutableSet shares.
+ *
+ * Objects are probed with the hashes stored in the slots of the enumerated
+ * Set, so that they are never rehashed. Removed Objects are released, and
+ * added Objects retained.
+ *
+ * @private
+ */
+extern void _Set_intersect(Set *self, const Set *set);
+extern void _Set_minus(Set *self, const Set *set);
+extern void _Set_union(Set *self, const Set *set);
+
 #endif
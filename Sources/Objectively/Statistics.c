@@ -0,0 +1,72 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <Objectively/MutableDictionary.h>
+#include <Objectively/Number.h>
+#include <Objectively/Statistics.h>
+#include <Objectively/String.h>
+
+/**
+ * @brief Sets the Number `value` for the key `name` in `dictionary`.
+ */
+static void setNumberForKey(MutableDictionary *dictionary, double value, const char *name) {
+
+	Number *number = $$(Number, numberWithValue, value);
+	String *key = $$(String, stringWithCharacters, name);
+
+	$(dictionary, setObjectForKey, number, key);
+
+	release(number);
+	release(key);
+}
+
+/**
+ * @brief ClassEnumerator for StatisticsSnapshot.
+ */
+static void snapshotClass(const Class *clazz, id data) {
+
+	const ClassStatistics statistics = statisticsForClass(clazz);
+
+	MutableDictionary *dictionary = $$(MutableDictionary, dictionary);
+
+	setNumberForKey(dictionary, statistics.instances, "instances");
+	setNumberForKey(dictionary, statistics.allocations, "allocations");
+	setNumberForKey(dictionary, statistics.instanceBytes, "instanceBytes");
+	setNumberForKey(dictionary, statistics.highWaterMark, "highWaterMark");
+
+	String *name = $$(String, stringWithCharacters, clazz->name);
+
+	$((MutableDictionary *) data, setObjectForKey, dictionary, name);
+
+	release(dictionary);
+	release(name);
+}
+
+Dictionary *StatisticsSnapshot(void) {
+
+	MutableDictionary *snapshot = $$(MutableDictionary, dictionary);
+
+	enumerateClasses(snapshotClass, snapshot);
+
+	return (Dictionary *) snapshot;
+}
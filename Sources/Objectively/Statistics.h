@@ -0,0 +1,49 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef _Objectively_Statistics_h_
+#define _Objectively_Statistics_h_
+
+#include <Objectively/Dictionary.h>
+
+/**
+ * @file
+ *
+ * @brief Allocation statistics for all initialized Classes.
+ *
+ * Snapshots may be written as JSON with `JSONSerialization`, e.g. to find the
+ * Classes responsible for memory bloat in a running application.
+ */
+
+/**
+ * @return A snapshot of the allocation statistics of all initialized Classes.
+ *
+ * @remark The snapshot is keyed by Class name. Each value is a Dictionary of
+ * Numbers with the keys `instances`, `allocations`, `instanceBytes` and
+ * `highWaterMark`.
+ *
+ * @see statisticsForClass(const Class *)
+ */
+extern Dictionary *StatisticsSnapshot(void);
+
+#endif
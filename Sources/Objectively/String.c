@@ -39,6 +39,30 @@
 
 #define _Class _String
 
+#pragma mark - Bytes
+
+uint64_t _String_hashForBytes(const HashKey *key, const byte *bytes, const size_t length) {
+
+	const RANGE range = { 0, length };
+
+	if (key) {
+		return HashForBytesWithKey(key, bytes, range);
+	}
+
+	return HashForInteger64(HASH_SEED, HashForBytes64(HASH_SEED, bytes, range));
+}
+
+BOOL _String_isEqualToBytes(const id obj, const byte *bytes, const size_t length) {
+
+	const String *string = (String *) obj;
+
+	if ($((Object *) obj, isKindOfClass, &_String)) {
+		return string->length == length && memcmp(string->chars, bytes, length) == 0;
+	}
+
+	return NO;
+}
+
 #pragma mark - ObjectInterface
 
 /**
@@ -77,11 +101,38 @@ static String *description(const Object *self) {
  */
 static int hash(const Object *self) {
 
+	return (int) $(self, hash64);
+}
+
+/**
+ * @see ObjectInterface::hash64(const Object *)
+ */
+static uint64_t hash64(const Object *self) {
+
+	String *this = (String *) self;
+
+	uint64_t hash = __atomic_load_n(&this->hash, __ATOMIC_RELAXED);
+	if (hash == 0) {
+
+		const RANGE range = { 0, this->length };
+		hash = HashForCharacters64(HASH_SEED, this->chars, range);
+
+		__atomic_store_n(&this->hash, hash, __ATOMIC_RELAXED);
+	}
+
+	return hash;
+}
+
+/**
+ * @see ObjectInterface::hashWithKey(const Object *, const HashKey *)
+ */
+static uint64_t hashWithKey(const Object *self, const HashKey *key) {
+
 	String *this = (String *) self;
 
 	const RANGE range = { 0, this->length };
 
-	return HashForCharacters(HASH_SEED, this->chars, range);
+	return HashForCharactersWithKey(key, this->chars, range);
 }
 
 /**
@@ -100,6 +151,13 @@ static BOOL isEqual(const Object *self, const Object *other) {
 
 		if (this->length == that->length) {
 
+			const uint64_t thisHash = __atomic_load_n(&this->hash, __ATOMIC_RELAXED);
+			const uint64_t thatHash = __atomic_load_n(&that->hash, __ATOMIC_RELAXED);
+
+			if (thisHash && thatHash && thisHash != thatHash) {
+				return NO;
+			}
+
 			const RANGE range = { 0, this->length };
 			return $(this, compareTo, that, range) == SAME;
 		}
@@ -595,6 +653,8 @@ static void initialize(Class *clazz) {
 	object->dealloc = dealloc;
 	object->description = description;
 	object->hash = hash;
+	object->hash64 = hash64;
+	object->hashWithKey = hashWithKey;
 	object->isEqual = isEqual;
 
 	StringInterface *string = (StringInterface *) clazz->interface;
@@ -106,6 +106,15 @@ struct String {
 	 * @brief The length of the String in bytes.
 	 */
 	size_t length;
+
+	/**
+	 * @brief The memoized 64 bit hash, or `0` if it has not been computed.
+	 *
+	 * @remark MutableStrings do not memoize their hash.
+	 *
+	 * @private
+	 */
+	uint64_t hash;
 };
 
 typedef struct MutableString MutableString;
@@ -433,6 +442,19 @@ struct StringInterface {
  */
 extern Class _String;
 
+/**
+ * @brief The byte-wise String primitives, with which collections look up String
+ * keys by their characters, without instantiating a String.
+ *
+ * `_String_hashForBytes` returns the hash that `HashForObjectWithKey` returns
+ * for a String of `bytes`. `_String_isEqualToBytes` returns `YES` if `obj` is a
+ * String of exactly `bytes`.
+ *
+ * @private
+ */
+extern uint64_t _String_hashForBytes(const HashKey *key, const byte *bytes, const size_t length);
+extern BOOL _String_isEqualToBytes(const id obj, const byte *bytes, const size_t length);
+
 /**
  * @param encoding A StringEncoding.
  *
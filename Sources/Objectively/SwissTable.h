@@ -0,0 +1,404 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef _Objectively_SwissTable_h_
+#define _Objectively_SwissTable_h_
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include <Objectively/Types.h>
+
+/**
+ * @file
+ *
+ * @brief The open addressing hash table of Dictionary and Set.
+ *
+ * Each slot has a control byte, which is either empty, deleted, or the low 7
+ * bits of the hash of the slot's entry. The control bytes of
+ * `SWISS_TABLE_GROUP_SIZE` slots are matched against a hash at once, and
+ * groups are probed quadratically. The entries follow the control bytes in
+ * the same allocation. They are opaque to the table, except that each begins
+ * with the `uint64_t` hash of its key.
+ *
+ * The table members are those of the Dictionary or Set, which the functions
+ * below maintain through a SwissTable.
+ *
+ * @private
+ */
+
+/**
+ * @brief The number of slots whose control bytes are probed together.
+ */
+#define SWISS_TABLE_GROUP_SIZE 16
+
+/**
+ * @brief The control byte of a slot that has never been used.
+ */
+#define CONTROL_EMPTY 0x80
+
+/**
+ * @brief The control byte of a slot whose entry was removed.
+ */
+#define CONTROL_DELETED 0xfe
+
+/**
+ * @return `YES` if `c` is the control byte of a slot in use.
+ */
+#define isFull(c) (((c) & 0x80) == 0)
+
+/**
+ * @return The count of elements that `capacity` slots may hold (7/8 load).
+ */
+#define maxLoad(capacity) ((capacity) - (capacity) / 8)
+
+/**
+ * @brief The table members of a Dictionary or Set, and the size of its entries.
+ */
+typedef struct {
+	size_t *capacity;
+	size_t *count;
+	byte **control;
+	size_t *growth;
+	size_t *mutations;
+	uint64_t *hashes;
+	size_t entrySize;
+} SwissTable;
+
+/**
+ * @return The SwissTable of `self`, a Dictionary or Set.
+ */
+#define SwissTableOf(self) ((SwissTable) { \
+	.capacity = &(self)->capacity, \
+	.count = &(self)->count, \
+	.control = &(self)->control, \
+	.growth = &(self)->growth, \
+	.mutations = &(self)->mutations, \
+	.hashes = &(self)->hashes, \
+	.entrySize = sizeof(*(self)->entries) \
+})
+
+/**
+ * @brief A function pointer for SwissTableFind.
+ *
+ * @return `YES` if `entry`, whose hash is that of the search, is a match for `data`.
+ */
+typedef BOOL (*SwissTableEquality)(const void *entry, const void *data);
+
+/**
+ * @return A mask of the slots in `group` whose control bytes equal `c`.
+ */
+static inline unsigned SwissTableMatch(const byte *group, const byte c) {
+
+#if defined(__SSE2__)
+	const __m128i control = _mm_loadu_si128((const __m128i *) group);
+
+	return (unsigned) _mm_movemask_epi8(_mm_cmpeq_epi8(control, _mm_set1_epi8((char) c)));
+#else
+	unsigned mask = 0;
+
+	for (int i = 0; i < SWISS_TABLE_GROUP_SIZE; i++) {
+		if (group[i] == c) {
+			mask |= 1u << i;
+		}
+	}
+
+	return mask;
+#endif
+}
+
+/**
+ * @return A mask of the slots in `group` that are empty or deleted.
+ */
+static inline unsigned SwissTableMatchAvailable(const byte *group) {
+
+#if defined(__SSE2__)
+	return (unsigned) _mm_movemask_epi8(_mm_loadu_si128((const __m128i *) group));
+#else
+	unsigned mask = 0;
+
+	for (int i = 0; i < SWISS_TABLE_GROUP_SIZE; i++) {
+		if (group[i] & 0x80) {
+			mask |= 1u << i;
+		}
+	}
+
+	return mask;
+#endif
+}
+
+/**
+ * @return A mask of the slots in `group` that are in use.
+ */
+static inline unsigned SwissTableMatchFull(const byte *group) {
+
+	return ~SwissTableMatchAvailable(group) & ((1u << SWISS_TABLE_GROUP_SIZE) - 1);
+}
+
+/**
+ * @return The smallest capacity that may hold `count` elements.
+ */
+static inline size_t SwissTableCapacityForCount(size_t count) {
+
+	if (count == 0) {
+		return 0;
+	}
+
+	size_t capacity = SWISS_TABLE_GROUP_SIZE;
+	while (maxLoad(capacity) < count) {
+		capacity <<= 1;
+	}
+
+	return capacity;
+}
+
+/**
+ * @return The entries of the table whose control bytes are `control`.
+ */
+static inline void *SwissTableEntries(byte *control, size_t capacity) {
+
+	return capacity ? control + capacity : NULL;
+}
+
+/**
+ * @return The index of the first slot available to `hash` in `control`.
+ */
+static inline size_t SwissTableAvailable(const byte *control, size_t capacity, uint64_t hash) {
+
+	const size_t mask = capacity / SWISS_TABLE_GROUP_SIZE - 1;
+	size_t group = (hash >> 7) & mask;
+
+	for (size_t step = 1; ; step++) {
+
+		const unsigned m = SwissTableMatchAvailable(control + group * SWISS_TABLE_GROUP_SIZE);
+		if (m) {
+			return group * SWISS_TABLE_GROUP_SIZE + __builtin_ctz(m);
+		}
+
+		group = (group + step) & mask;
+	}
+}
+
+/**
+ * @brief Allocates an empty table of `capacity` slots.
+ *
+ * @return The entries of the new table.
+ */
+static inline void *SwissTableAllocate(SwissTable table, size_t capacity) {
+
+	*table.capacity = capacity;
+	*table.count = 0;
+	*table.hashes = 0;
+
+	if (capacity) {
+		*table.control = malloc(capacity + capacity * table.entrySize);
+		assert(*table.control);
+
+		memset(*table.control, CONTROL_EMPTY, capacity);
+
+		*table.growth = maxLoad(capacity);
+	} else {
+		*table.control = NULL;
+		*table.growth = 0;
+	}
+
+	return SwissTableEntries(*table.control, capacity);
+}
+
+/**
+ * @brief Moves the entries of `table` into a new table of `capacity` slots,
+ * reusing their hashes.
+ *
+ * @return The entries of the new table.
+ */
+static inline void *SwissTableRehash(SwissTable table, size_t capacity) {
+
+	byte *control = *table.control;
+	const byte *entries = SwissTableEntries(control, *table.capacity);
+	const size_t oldCapacity = *table.capacity;
+
+	byte *newEntries = SwissTableAllocate(table, capacity);
+
+	for (size_t i = 0; i < oldCapacity; i++) {
+		if (isFull(control[i])) {
+
+			const byte *entry = entries + i * table.entrySize;
+			const uint64_t hash = *(const uint64_t *) entry;
+
+			const size_t index = SwissTableAvailable(*table.control, capacity, hash);
+
+			(*table.control)[index] = hash & 0x7f;
+			memcpy(newEntries + index * table.entrySize, entry, table.entrySize);
+
+			*table.growth -= 1;
+			*table.count += 1;
+			*table.hashes += hash;
+		}
+	}
+
+	free(control);
+
+	return newEntries;
+}
+
+/**
+ * @brief Grows `table`, or rehashes it in place to purge deleted slots, when
+ * no empty slots remain available to insertions.
+ *
+ * @return The entries of the table.
+ */
+static inline void *SwissTableReserve(SwissTable table) {
+
+	if (*table.growth == 0) {
+
+		size_t capacity = *table.capacity;
+		if (capacity == 0) {
+			capacity = SWISS_TABLE_GROUP_SIZE;
+		} else if (*table.count * 2 >= maxLoad(capacity)) {
+			capacity <<= 1;
+		}
+
+		return SwissTableRehash(table, capacity);
+	}
+
+	return SwissTableEntries(*table.control, *table.capacity);
+}
+
+/**
+ * @brief Finds the entry whose hash is `hash` and for which `equal` is `YES`.
+ *
+ * @return The entry, or `NULL`.
+ */
+static inline void *SwissTableFind(const byte *control, const void *entries, size_t capacity,
+		size_t entrySize, uint64_t hash, SwissTableEquality equal, const void *data) {
+
+	const size_t mask = capacity / SWISS_TABLE_GROUP_SIZE - 1;
+	size_t group = (hash >> 7) & mask;
+
+	for (size_t step = 1; ; step++) {
+
+		const byte *g = control + group * SWISS_TABLE_GROUP_SIZE;
+
+		for (unsigned m = SwissTableMatch(g, hash & 0x7f); m; m &= m - 1) {
+
+			const size_t index = group * SWISS_TABLE_GROUP_SIZE + __builtin_ctz(m);
+			const byte *entry = (const byte *) entries + index * entrySize;
+
+			if (*(const uint64_t *) entry == hash && equal(entry, data)) {
+				return (void *) entry;
+			}
+		}
+
+		if (SwissTableMatch(g, CONTROL_EMPTY)) {
+			return NULL;
+		}
+
+		group = (group + step) & mask;
+	}
+}
+
+/**
+ * @brief Claims a slot of `table` for `hash`. The table must have been
+ * reserved with SwissTableReserve.
+ *
+ * @return The entry of the slot, whose hash is set.
+ */
+static inline void *SwissTableInsert(SwissTable table, void *entries, uint64_t hash) {
+
+	byte *control = *table.control;
+
+	const size_t index = SwissTableAvailable(control, *table.capacity, hash);
+
+	if (control[index] == CONTROL_EMPTY) {
+		*table.growth -= 1;
+	}
+
+	control[index] = hash & 0x7f;
+
+	*table.count += 1;
+	*table.mutations += 1;
+	*table.hashes += hash;
+
+	byte *entry = (byte *) entries + index * table.entrySize;
+	*(uint64_t *) entry = hash;
+
+	return entry;
+}
+
+/**
+ * @brief Frees the slot of `entry`. Its members are not cleared.
+ */
+static inline void SwissTableErase(SwissTable table, const void *entries, const void *entry) {
+
+	byte *control = *table.control;
+
+	const size_t index = ((const byte *) entry - (const byte *) entries) / table.entrySize;
+
+	if (SwissTableMatch(control + (index & ~(SWISS_TABLE_GROUP_SIZE - 1)), CONTROL_EMPTY)) {
+		control[index] = CONTROL_EMPTY;
+		*table.growth += 1;
+	} else {
+		control[index] = CONTROL_DELETED;
+	}
+
+	*table.count -= 1;
+	*table.mutations += 1;
+	*table.hashes -= *(const uint64_t *) entry;
+}
+
+/**
+ * @brief Frees all slots of `table`. Their entries are not cleared.
+ */
+static inline void SwissTableClear(SwissTable table) {
+
+	if (*table.capacity) {
+		memset(*table.control, CONTROL_EMPTY, *table.capacity);
+		*table.growth = maxLoad(*table.capacity);
+	}
+
+	*table.count = 0;
+	*table.hashes = 0;
+	*table.mutations += 1;
+}
+
+/**
+ * @brief Rehashes `table` to the smallest capacity that may hold `count`
+ * elements, or its current elements if there are more.
+ *
+ * @return The entries of the table.
+ */
+static inline void *SwissTableResize(SwissTable table, size_t count) {
+
+	void *entries = SwissTableRehash(table, SwissTableCapacityForCount(count > *table.count ? count : *table.count));
+
+	*table.mutations += 1;
+
+	return entries;
+}
+
+#endif
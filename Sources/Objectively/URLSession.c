@@ -26,6 +26,7 @@
 #define _NO_BOOL_TYPEDEF
 #include <curl/curl.h>
 
+#include <Objectively/Arena.h>
 #include <Objectively/Once.h>
 #include <Objectively/URLSession.h>
 
@@ -292,7 +293,7 @@ static URLSession *sharedInstance(void) {
 	static Once once;
 
 	DispatchOnce(once, {
-		_sharedInstance = $(alloc(URLSession), init);
+		WithoutArena(_sharedInstance = $(alloc(URLSession), init));
 	});
 
 	return _sharedInstance;
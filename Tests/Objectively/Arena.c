@@ -0,0 +1,136 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <check.h>
+#include <string.h>
+
+#include <Objectively.h>
+
+START_TEST(arena)
+	{
+		Arena *arena = $(alloc(Arena), initWithBlockSize, 256);
+		ck_assert(arena != NULL);
+
+		ck_assert_ptr_eq(NULL, $$(Arena, currentArena));
+
+		String *outside = $$(String, stringWithCharacters, "outside");
+
+		const char *json = "{\"array\": [1, \"two\", true, null], \"object\": {\"key\": \"value\"}}";
+		Data *data = $$(Data, dataWithBytes, (const byte *) json, strlen(json));
+
+		Dictionary *dictionary = NULL;
+
+		WithArena(arena, {
+			ck_assert_ptr_eq(arena, $$(Arena, currentArena));
+
+			dictionary = $$(JSONSerialization, objectFromData, data, 0);
+			ck_assert(dictionary != NULL);
+
+			Array *array = $(dictionary, objectForKey, $$(String, stringWithCharacters, "array"));
+			ck_assert_int_eq(4, array->count);
+
+			ck_assert_ptr_eq($$(Boolean, yes), $(array, objectAtIndex, 2));
+			ck_assert_ptr_eq($$(Null, null), $(array, objectAtIndex, 3));
+
+			MutableArray *strings = $(alloc(MutableArray), init);
+			$(strings, addObject, outside);
+			release(strings);
+		});
+
+		ck_assert_ptr_eq(NULL, $$(Arena, currentArena));
+
+		ck_assert_int_eq(REFERENCE_COUNT_IMMORTAL, retainCount(dictionary));
+		release(dictionary);
+
+		ck_assert_int_eq(2, retainCount(outside));
+
+		release(arena);
+
+		ck_assert_int_eq(1, retainCount(outside));
+
+		ck_assert_int_eq(REFERENCE_COUNT_IMMORTAL, retainCount($$(Null, null)));
+
+		release(outside);
+		release(data);
+
+	}END_TEST
+
+START_TEST(statistics)
+	{
+		_initialize(&_Object);
+		_initialize(&_String);
+
+		const ClassStatistics objects = statisticsForClass(&_Object);
+		const ClassStatistics strings = statisticsForClass(&_String);
+
+		Arena *arena = $(alloc(Arena), init);
+
+		WithArena(arena, {
+			for (int i = 0; i < 10; i++) {
+				$(alloc(Object), init);
+				$$(String, stringWithCharacters, "arena");
+			}
+		});
+
+		ck_assert_int_eq(objects.instances + 10, statisticsForClass(&_Object).instances);
+		ck_assert_int_eq(strings.instances + 10, statisticsForClass(&_String).instances);
+
+		release(arena);
+
+		ck_assert_int_eq(objects.instances, statisticsForClass(&_Object).instances);
+		ck_assert_int_eq(strings.instances, statisticsForClass(&_String).instances);
+
+		arena = $(alloc(Arena), init);
+
+		WithArena(arena, {
+			for (int i = 0; i < 10; i++) {
+				$(alloc(Object), init);
+			}
+		});
+
+		ck_assert_int_eq(objects.instances + 10, statisticsForClass(&_Object).instances);
+
+		release(arena);
+
+		ck_assert_int_eq(objects.instances, statisticsForClass(&_Object).instances);
+
+	}END_TEST
+
+int main(int argc, char **argv) {
+
+	TCase *tcase = tcase_create("arena");
+	tcase_add_test(tcase, arena);
+	tcase_add_test(tcase, statistics);
+
+	Suite *suite = suite_create("arena");
+	suite_add_tcase(suite, tcase);
+
+	SRunner *runner = srunner_create(suite);
+
+	srunner_run_all(runner, CK_VERBOSE);
+	int failed = srunner_ntests_failed(runner);
+
+	srunner_free(runner);
+
+	return failed;
+}
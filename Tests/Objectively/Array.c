@@ -56,9 +56,9 @@ START_TEST(array)
 		ck_assert_int_eq(1, $(array, indexOfObject, two));
 		ck_assert_int_eq(2, $(array, indexOfObject, three));
 
-		ck_assert_int_eq(2, one->referenceCount);
-		ck_assert_int_eq(2, two->referenceCount);
-		ck_assert_int_eq(2, three->referenceCount);
+		ck_assert_int_eq(2, retainCount(one));
+		ck_assert_int_eq(2, retainCount(two));
+		ck_assert_int_eq(2, retainCount(three));
 
 		release(one);
 		release(two);
@@ -79,10 +79,101 @@ START_TEST(array)
 
 	}END_TEST
 
+START_TEST(fastEnumeration)
+	{
+		MutableArray *array = $$(MutableArray, array);
+
+		for (int i = 0; i < 100; i++) {
+			Number *number = $$(Number, numberWithValue, i);
+			$(array, addObject, number);
+			release(number);
+		}
+
+		int sum = 0;
+		foreach(Number *number, (Array *) array) {
+			if (number->value == 50) {
+				continue;
+			}
+			sum += number->value;
+		}
+
+		ck_assert_int_eq(4950 - 50, sum);
+
+		int count = 0;
+		foreach(Number *number, (Array *) array) {
+			if (number->value == 10) {
+				break;
+			}
+			count++;
+		}
+
+		ck_assert_int_eq(10, count);
+
+		Cursor cursor;
+		ck_assert_int_eq(100, $((Array *) array, nextObjects, CursorInit(&cursor)));
+		ck_assert_ptr_eq(((Array *) array)->elements, cursor.objects);
+		ck_assert_int_eq(0, $((Array *) array, nextObjects, &cursor));
+
+		release(array);
+
+	}END_TEST
+
+BOOL sumConcurrently(const Array *array, id obj, id data) {
+
+	__atomic_fetch_add((int *) data, ((Number *) obj)->value, __ATOMIC_RELAXED); return NO;
+}
+
+BOOL isEven(const Array *array, id obj, id data) {
+
+	return ((int) ((Number *) obj)->value) % 2 == 0;
+}
+
+id twice(const Array *array, id obj, id data) {
+
+	return $$(Number, numberWithValue, ((Number *) obj)->value * 2);
+}
+
+START_TEST(concurrency)
+	{
+		MutableArray *array = $$(MutableArray, array);
+
+		for (int i = 0; i < 10000; i++) {
+			Number *number = $$(Number, numberWithValue, i);
+			$(array, addObject, number);
+			release(number);
+		}
+
+		int sum = 0;
+		$((Array *) array, enumerateObjectsConcurrently, sumConcurrently, &sum);
+
+		ck_assert_int_eq(49995000, sum);
+
+		Array *evens = $((Array *) array, filterObjectsConcurrently, isEven, NULL);
+
+		ck_assert_int_eq(5000, evens->count);
+		for (size_t i = 0; i < evens->count; i++) {
+			ck_assert_int_eq(i * 2, ((Number *) $(evens, objectAtIndex, i))->value);
+		}
+
+		Array *mapped = $((Array *) array, mapObjects, twice, NULL);
+
+		ck_assert_int_eq(10000, mapped->count);
+		for (size_t i = 0; i < mapped->count; i++) {
+			ck_assert_int_eq(i * 2, ((Number *) $(mapped, objectAtIndex, i))->value);
+		}
+
+		release(evens);
+		release(mapped);
+		release(array);
+
+	}END_TEST
+
 int main(int argc, char **argv) {
 
 	TCase *tcase = tcase_create("array");
 	tcase_add_test(tcase, array);
+	tcase_add_test(tcase, fastEnumeration);
+	tcase_add_test(tcase, concurrency);
 
 	Suite *suite = suite_create("array");
 	suite_add_tcase(suite, tcase);
@@ -0,0 +1,125 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <check.h>
+
+#include <Objectively.h>
+
+START_TEST(autoreleasePool)
+	{
+		Object *object = $(alloc(Object), init);
+		String *string = $$(String, stringWithCharacters, "autorelease");
+
+		const AutoreleasePool pool = AutoreleasePoolPush();
+
+		retain(object);
+
+		ck_assert_ptr_eq(object, autorelease(object));
+		ck_assert_int_eq(2, retainCount(object));
+
+		WithAutoreleasePool({
+			autorelease(retain(string));
+			autorelease(retain(string));
+
+			ck_assert_int_eq(3, retainCount(string));
+		});
+
+		ck_assert_int_eq(1, retainCount(string));
+		ck_assert_int_eq(2, retainCount(object));
+
+		ck_assert_ptr_eq(NULL, autorelease(NULL));
+
+		AutoreleasePoolPop(pool);
+
+		ck_assert_int_eq(1, retainCount(object));
+
+		release(object);
+		release(string);
+
+	}END_TEST
+
+START_TEST(autoreleasePoolGrowth)
+	{
+		Object *object = $(alloc(Object), init);
+
+		WithAutoreleasePool({
+			for (size_t i = 0; i < 10000; i++) {
+				autorelease(retain(object));
+			}
+
+			ck_assert_int_eq(10001, retainCount(object));
+		});
+
+		ck_assert_int_eq(1, retainCount(object));
+
+		release(object);
+
+	}END_TEST
+
+START_TEST(unbalanced)
+	{
+		Object *object = $(alloc(Object), init);
+
+		const AutoreleasePool outer = AutoreleasePoolPush();
+		const AutoreleasePool inner = AutoreleasePoolPush();
+
+		ck_assert(inner != outer);
+
+		autorelease(retain(object));
+		ck_assert_int_eq(2, retainCount(object));
+
+		AutoreleasePoolPop(outer);
+
+		ck_assert_int_eq(1, retainCount(object));
+
+		const AutoreleasePool pool = AutoreleasePoolPush();
+		ck_assert_int_eq(outer, pool);
+
+		autorelease(retain(object));
+		AutoreleasePoolPop(pool);
+
+		ck_assert_int_eq(1, retainCount(object));
+
+		release(object);
+
+	}END_TEST
+
+int main(int argc, char **argv) {
+
+	TCase *tcase = tcase_create("autoreleasePool");
+	tcase_add_test(tcase, autoreleasePool);
+	tcase_add_test(tcase, unbalanced);
+	tcase_add_test(tcase, autoreleasePoolGrowth);
+
+	Suite *suite = suite_create("autoreleasePool");
+	suite_add_tcase(suite, tcase);
+
+	SRunner *runner = srunner_create(suite);
+
+	srunner_run_all(runner, CK_VERBOSE);
+	int failed = srunner_ntests_failed(runner);
+
+	srunner_free(runner);
+
+	return failed;
+}
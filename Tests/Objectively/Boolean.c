@@ -33,6 +33,16 @@ START_TEST(date)
 		Boolean *no = $$(Boolean, no);
 		ck_assert(no->bool == NO);
 
+		ck_assert(_Boolean.locals.isStatic);
+		ck_assert_ptr_eq(_Boolean.interface, ((Object *) yes)->interface);
+		ck_assert_ptr_eq(_Object_hash, ((ObjectInterface *) _Boolean.interface)->hash);
+
+		release(retain(yes));
+		release(no);
+
+		ck_assert_int_eq(REFERENCE_COUNT_IMMORTAL, retainCount(yes));
+		ck_assert_int_eq(REFERENCE_COUNT_IMMORTAL, retainCount(no));
+
 	}END_TEST
 
 int main(int argc, char **argv) {
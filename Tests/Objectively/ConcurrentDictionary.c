@@ -0,0 +1,269 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <check.h>
+#include <pthread.h>
+
+#include <Objectively.h>
+
+#define KEYS 4096
+#define THREADS 4
+#define ROUNDS 64
+
+static ConcurrentDictionary *dict;
+static Number *numbers[KEYS];
+static volatile int writing;
+
+START_TEST(concurrentDictionary)
+	{
+		ConcurrentDictionary *dict = $(alloc(ConcurrentDictionary), init);
+
+		ck_assert(dict != NULL);
+		ck_assert_ptr_eq(&_ConcurrentDictionary, classof(dict));
+		ck_assert_int_eq(0, $(dict, count));
+
+		String *keyOne = str("one");
+		String *keyTwo = str("two");
+
+		Object *objectOne = alloc(Object);
+		Object *objectTwo = alloc(Object);
+
+		$(dict, setObjectForKey, objectOne, keyOne);
+		$(dict, setObjectForKey, objectTwo, keyTwo);
+
+		ck_assert_int_eq(2, $(dict, count));
+
+		id obj = $(dict, objectForKey, keyOne);
+		ck_assert_ptr_eq(objectOne, obj);
+		release(obj);
+
+		$(dict, setObjectForKey, objectTwo, keyOne);
+
+		ck_assert_int_eq(2, $(dict, count));
+
+		obj = $(dict, objectForKey, keyOne);
+		ck_assert_ptr_eq(objectTwo, obj);
+		release(obj);
+
+		Dictionary *snapshot = $(dict, snapshot);
+
+		ck_assert_int_eq(2, snapshot->count);
+		ck_assert_ptr_eq(objectTwo, $(snapshot, objectForKey, keyOne));
+		ck_assert_ptr_eq(objectTwo, $(snapshot, objectForKey, keyTwo));
+
+		release(snapshot);
+
+		$(dict, removeObjectForKey, keyOne);
+
+		ck_assert_int_eq(1, $(dict, count));
+		ck_assert_ptr_eq(NULL, $(dict, objectForKey, keyOne));
+
+		for (int i = 0; i < 10000; i++) {
+			Number *number = $(alloc(Number), initWithValue, i);
+			$(dict, setObjectForKey, number, number);
+			release(number);
+		}
+
+		ck_assert_int_eq(10001, $(dict, count));
+
+		for (int i = 0; i < 10000; i++) {
+			Number *number = $(alloc(Number), initWithValue, i);
+
+			obj = $(dict, objectForKey, number);
+			ck_assert($((Object *) number, isEqual, obj));
+			release(obj);
+
+			release(number);
+		}
+
+		$(dict, removeAllObjects);
+
+		ck_assert_int_eq(0, $(dict, count));
+		ck_assert_ptr_eq(NULL, $(dict, objectForKey, keyTwo));
+
+		release(dict);
+
+		ck_assert_int_eq(1, retainCount(objectOne));
+		ck_assert_int_eq(1, retainCount(objectTwo));
+
+		release(objectOne);
+		release(objectTwo);
+
+		release(keyOne);
+		release(keyTwo);
+
+	}END_TEST
+
+START_TEST(sections)
+	{
+		ConcurrentDictionary *dict = $(alloc(ConcurrentDictionary), init);
+
+		String *key = str("key");
+		Object *object = $(alloc(Object), init);
+
+		$(dict, setObjectForKey, object, key);
+		ck_assert_int_eq(2, retainCount(object));
+
+		$(dict, removeObjectForKey, key);
+		ck_assert_int_eq(1, retainCount(object));
+
+		$(dict, setObjectForKey, object, key);
+
+		$(dict, enter);
+
+		ck_assert_ptr_eq(object, $(dict, unretainedObjectForKey, key));
+		ck_assert_int_eq(2, retainCount(object));
+
+		$(dict, removeObjectForKey, key);
+
+		ck_assert_ptr_eq(NULL, $(dict, unretainedObjectForKey, key));
+		ck_assert_int_eq(2, retainCount(object));
+
+		$(dict, leave);
+
+		ck_assert_int_eq(2, retainCount(object));
+
+		release(dict);
+
+		ck_assert_int_eq(1, retainCount(object));
+		release(object);
+		release(key);
+
+	}END_TEST
+
+static void *writer(void *data) {
+
+	const int offset = (int) (intptr_t) data;
+
+	for (int round = 0; round < ROUNDS; round++) {
+		for (int i = offset; i < KEYS; i += THREADS) {
+			if ((i + round) & 1) {
+				$(dict, setObjectForKey, numbers[i], numbers[i]);
+			} else {
+				$(dict, removeObjectForKey, numbers[i]);
+			}
+		}
+	}
+
+	for (int i = offset; i < KEYS; i += THREADS) {
+		$(dict, setObjectForKey, numbers[i], numbers[i]);
+	}
+
+	return NULL;
+}
+
+static void *reader(void *data) {
+
+	size_t *found = (size_t *) data;
+
+	while (__atomic_load_n(&writing, __ATOMIC_ACQUIRE)) {
+		for (int i = 0; i < KEYS; i++) {
+
+			id obj = $(dict, objectForKey, numbers[i]);
+			if (obj) {
+				ck_assert_ptr_eq(numbers[i], obj);
+				release(obj);
+				(*found)++;
+			}
+		}
+
+		$(dict, enter);
+
+		for (int i = 0; i < KEYS; i++) {
+
+			id obj = $(dict, unretainedObjectForKey, numbers[i]);
+			if (obj) {
+				ck_assert_ptr_eq(numbers[i], obj);
+				(*found)++;
+			}
+		}
+
+		$(dict, leave);
+	}
+
+	return NULL;
+}
+
+START_TEST(threads)
+	{
+		dict = $(alloc(ConcurrentDictionary), init);
+
+		for (int i = 0; i < KEYS; i++) {
+			numbers[i] = $(alloc(Number), initWithValue, i);
+		}
+
+		writing = 1;
+
+		pthread_t readers[THREADS], writers[THREADS];
+		size_t found[THREADS] = { 0 };
+
+		for (int i = 0; i < THREADS; i++) {
+			pthread_create(&readers[i], NULL, reader, &found[i]);
+			pthread_create(&writers[i], NULL, writer, (void *) (intptr_t) i);
+		}
+
+		for (int i = 0; i < THREADS; i++) {
+			pthread_join(writers[i], NULL);
+		}
+
+		__atomic_store_n(&writing, 0, __ATOMIC_RELEASE);
+
+		for (int i = 0; i < THREADS; i++) {
+			pthread_join(readers[i], NULL);
+		}
+
+		ck_assert_int_eq(KEYS, $(dict, count));
+
+		for (int i = 0; i < KEYS; i++) {
+			id obj = $(dict, objectForKey, numbers[i]);
+			ck_assert_ptr_eq(numbers[i], obj);
+			release(obj);
+		}
+
+		release(dict);
+
+		for (int i = 0; i < KEYS; i++) {
+			release(numbers[i]);
+		}
+
+	}END_TEST
+
+int main(int argc, char **argv) {
+
+	TCase *tcase = tcase_create("concurrentDictionary");
+	tcase_add_test(tcase, concurrentDictionary);
+	tcase_add_test(tcase, sections);
+	tcase_add_test(tcase, threads);
+
+	Suite *suite = suite_create("concurrentDictionary");
+	suite_add_tcase(suite, tcase);
+
+	SRunner *runner = srunner_create(suite);
+
+	srunner_run_all(runner, CK_VERBOSE);
+	int failed = srunner_ntests_failed(runner);
+
+	srunner_free(runner);
+
+	return failed;
+}
@@ -57,9 +57,16 @@ START_TEST(dictionary)
 		ck_assert_ptr_eq(objectTwo, $(dict, objectForKey, keyTwo));
 		ck_assert_ptr_eq(objectThree, $(dict, objectForKey, keyThree));
 
-		ck_assert_int_eq(2, objectOne->referenceCount);
-		ck_assert_int_eq(2, objectTwo->referenceCount);
-		ck_assert_int_eq(2, objectThree->referenceCount);
+		ck_assert_ptr_eq(objectOne, $(dict, objectForCharacters, "one"));
+		ck_assert_ptr_eq(objectTwo, $(dict, objectForCharacters, "two"));
+		ck_assert_ptr_eq(NULL, $(dict, objectForCharacters, "four"));
+
+		ck_assert_ptr_eq(objectThree, $(dict, objectForBytes, (const byte *) "threefold", 5));
+		ck_assert_ptr_eq(NULL, $(dict, objectForBytes, (const byte *) "threefold", 4));
+
+		ck_assert_int_eq(2, retainCount(objectOne));
+		ck_assert_int_eq(2, retainCount(objectTwo));
+		ck_assert_int_eq(2, retainCount(objectThree));
 
 		release(objectOne);
 		release(objectTwo);
@@ -85,10 +92,188 @@ START_TEST(dictionary)
 
 	}END_TEST
 
+START_TEST(objectForCharacters)
+	{
+		Object *obj = alloc(Object);
+
+		MutableDictionary *dict = $(alloc(MutableDictionary), initWithCapacityAndHashKey, 0,
+				HashKeyForProcess());
+
+		for (int i = 0; i < 100; i++) {
+			String *key = str("%d", i);
+			$(dict, setObjectForKey, obj, key);
+			release(key);
+		}
+
+		$(dict, setObjectForKey, obj, obj);
+
+		ck_assert_ptr_eq(obj, $((Dictionary *) dict, objectForCharacters, "42"));
+		ck_assert_ptr_eq(obj, $((Dictionary *) dict, objectForBytes, (const byte *) "9999", 2));
+		ck_assert_ptr_eq(NULL, $((Dictionary *) dict, objectForCharacters, "100"));
+
+		release(dict);
+		release(obj);
+
+	}END_TEST
+
+START_TEST(fastEnumeration)
+	{
+		MutableDictionary *dict = $$(MutableDictionary, dictionary);
+
+		for (int i = 0; i < 1000; i++) {
+			Number *number = $$(Number, numberWithValue, i);
+			String *key = str("%d", i);
+			$(dict, setObjectForKey, number, key);
+			release(number);
+			release(key);
+		}
+
+		int sum = 0, count = 0;
+		foreachKeyAndObject(String *key, Number *number, (Dictionary *) dict) {
+			ck_assert_int_eq(number->value, atoi(key->chars));
+			sum += number->value;
+			count++;
+		}
+
+		ck_assert_int_eq(1000, count);
+		ck_assert_int_eq(499500, sum);
+
+		count = 0;
+		foreach(Number *number, (Dictionary *) dict) {
+			ck_assert(number != NULL);
+			if (++count == 100) {
+				break;
+			}
+		}
+
+		ck_assert_int_eq(100, count);
+
+		count = 0;
+		foreachKeyAndObject(String *key, Number *number, (Dictionary *) dict) {
+			ck_assert_ptr_eq(number, $((Dictionary *) dict, objectForKey, key));
+			if (++count == 100) {
+				break;
+			}
+		}
+
+		ck_assert_int_eq(100, count);
+
+		release(dict);
+
+	}END_TEST
+
+START_TEST(equality)
+	{
+		MutableDictionary *a = $$(MutableDictionary, dictionary);
+		MutableDictionary *b = $(alloc(MutableDictionary), initWithCapacityAndHashKey, 0, HashKeyForProcess());
+		MutableOrderedDictionary *c = $$(MutableOrderedDictionary, dictionary);
+
+		for (int i = 0; i < 100; i++) {
+			Number *number = $$(Number, numberWithValue, i);
+			String *key = str("%d", i);
+			$(a, setObjectForKey, number, key);
+			release(number);
+			release(key);
+		}
+
+		for (int i = 99; i >= 0; i--) {
+			Number *number = $$(Number, numberWithValue, i);
+			String *key = str("%d", i);
+			$(b, setObjectForKey, number, key);
+			$(c, setObjectForKey, number, key);
+			release(number);
+			release(key);
+		}
+
+		ck_assert($((Object *) a, isEqual, (Object *) b));
+		ck_assert($((Object *) b, isEqual, (Object *) a));
+		ck_assert($((Object *) a, isEqual, (Object *) c));
+		ck_assert($((Object *) c, isEqual, (Object *) a));
+
+		Number *number = $$(Number, numberWithValue, -1);
+		String *key = str("%d", 50);
+		$(a, setObjectForKey, number, key);
+		release(key);
+
+		ck_assert(!$((Object *) a, isEqual, (Object *) b));
+		ck_assert(!$((Object *) c, isEqual, (Object *) a));
+
+		key = str("%d", 100);
+		$(b, setObjectForKey, number, key);
+		$(c, setObjectForKey, number, key);
+		release(key);
+		release(number);
+
+		key = str("%d", 50);
+		$(b, removeObjectForKey, key);
+		$(c, removeObjectForKey, key);
+		release(key);
+
+		ck_assert(!$((Object *) a, isEqual, (Object *) b));
+		ck_assert(!$((Object *) a, isEqual, (Object *) c));
+		ck_assert($((Object *) b, isEqual, (Object *) c));
+
+		release(a);
+		release(b);
+		release(c);
+
+	}END_TEST
+
+static BOOL sumConcurrently(const Dictionary *dictionary, id obj, id key, id data) {
+
+	__atomic_fetch_add((int *) data, ((Number *) obj)->value, __ATOMIC_RELAXED); return NO;
+}
+
+static BOOL isEven(const Dictionary *dictionary, id obj, id key, id data) {
+
+	return ((int) ((Number *) obj)->value) % 2 == 0;
+}
+
+START_TEST(concurrency)
+	{
+		MutableDictionary *dict = $$(MutableDictionary, dictionary);
+
+		for (int i = 0; i < 10000; i++) {
+			Number *number = $$(Number, numberWithValue, i);
+			String *key = str("%d", i);
+			$(dict, setObjectForKey, number, key);
+			release(number);
+			release(key);
+		}
+
+		int sum = 0;
+		$((Dictionary *) dict, enumerateObjectsAndKeysConcurrently, sumConcurrently, &sum);
+
+		ck_assert_int_eq(49995000, sum);
+
+		Dictionary *evens = $((Dictionary *) dict, filterObjectsAndKeysConcurrently, isEven, NULL);
+
+		ck_assert_int_eq(5000, evens->count);
+
+		for (int i = 0; i < 10000; i++) {
+			String *key = str("%d", i);
+			Number *number = $(evens, objectForKey, key);
+			if (i % 2 == 0) {
+				ck_assert_int_eq(i, number->value);
+			} else {
+				ck_assert(number == NULL);
+			}
+			release(key);
+		}
+
+		release(evens);
+		release(dict);
+
+	}END_TEST
+
 int main(int argc, char **argv) {
 
 	TCase *tcase = tcase_create("dictionary");
 	tcase_add_test(tcase, dictionary);
+	tcase_add_test(tcase, objectForCharacters);
+	tcase_add_test(tcase, fastEnumeration);
+	tcase_add_test(tcase, equality);
+	tcase_add_test(tcase, concurrency);
 
 	Suite *suite = suite_create("dictionary");
 	suite_add_tcase(suite, tcase);
@@ -0,0 +1,153 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <check.h>
+
+#include <Objectively.h>
+
+static BOOL enumerator(const Dictionary *dictionary, id obj, id key, id data) {
+
+	(* (int *) data)++; return NO;
+}
+
+START_TEST(frozenDictionary)
+	{
+		MutableDictionary *dict = $$(MutableDictionary, dictionary);
+
+		String *keys[1000];
+		for (int i = 0; i < 1000; i++) {
+			keys[i] = $(alloc(String), initWithFormat, "%d", i);
+			$(dict, setObjectForKey, keys[i], keys[i]);
+		}
+
+		Dictionary *frozen = $((Dictionary *) dict, frozenCopy);
+
+		ck_assert(frozen != NULL);
+		ck_assert_ptr_eq(&_FrozenDictionary, classof(frozen));
+		ck_assert_int_eq(1000, frozen->count);
+		ck_assert_int_eq(1000, ((FrozenDictionary *) frozen)->size);
+
+		for (int i = 0; i < 1000; i++) {
+			ck_assert_ptr_eq(keys[i], $(frozen, objectForKey, keys[i]));
+			ck_assert_int_eq(5, retainCount(keys[i]));
+		}
+
+		for (int i = 1000; i < 2000; i++) {
+			String *missing = $(alloc(String), initWithFormat, "%d", i);
+			ck_assert_ptr_eq(NULL, $(frozen, objectForKey, missing));
+			ck_assert_ptr_eq(NULL, $(frozen, objectForCharacters, missing->chars));
+			release(missing);
+		}
+
+		ck_assert_ptr_eq(keys[42], $(frozen, objectForCharacters, "42"));
+		ck_assert_ptr_eq(keys[999], $(frozen, objectForBytes, (const byte *) "9990", 3));
+
+		int counter = 0;
+		$(frozen, enumerateObjectsAndKeys, enumerator, &counter);
+		ck_assert_int_eq(1000, counter);
+
+		ck_assert($((Object *) frozen, isEqual, (Object *) dict));
+		ck_assert($((Object *) dict, isEqual, (Object *) frozen));
+		ck_assert_int_eq($((Object *) dict, hash), $((Object *) frozen, hash));
+
+		Dictionary *refrozen = $(frozen, frozenCopy);
+		ck_assert_ptr_eq(frozen, refrozen);
+		release(refrozen);
+
+		Dictionary *copy = (Dictionary *) $((Object *) frozen, copy);
+		ck_assert_ptr_eq(&_FrozenDictionary, classof(copy));
+		ck_assert($((Object *) frozen, isEqual, (Object *) copy));
+		release(copy);
+
+		Dictionary *thawed = $$(Dictionary, dictionaryWithDictionary, frozen);
+		ck_assert_ptr_eq(&_Dictionary, classof(thawed));
+		ck_assert($((Object *) frozen, isEqual, (Object *) thawed));
+		release(thawed);
+
+		release(frozen);
+		release(dict);
+
+		for (int i = 0; i < 1000; i++) {
+			ck_assert_int_eq(1, retainCount(keys[i]));
+			release(keys[i]);
+		}
+
+	}END_TEST
+
+START_TEST(empty)
+	{
+		Dictionary *dict = $(alloc(Dictionary), initWithDictionary, NULL);
+		Dictionary *frozen = $(dict, frozenCopy);
+
+		ck_assert_ptr_eq(&_FrozenDictionary, classof(frozen));
+		ck_assert_int_eq(0, frozen->count);
+
+		String *key = str("key");
+		ck_assert_ptr_eq(NULL, $(frozen, objectForKey, key));
+		release(key);
+
+		release(frozen);
+		release(dict);
+
+	}END_TEST
+
+START_TEST(collision)
+	{
+		Number *quarter = $$(Number, numberWithValue, 0.25);
+		Number *half = $$(Number, numberWithValue, 0.5);
+
+		ck_assert_int_eq($((Object *) quarter, hash), $((Object *) half, hash));
+
+		Dictionary *dict = $$(Dictionary, dictionaryWithObjectsAndKeys, quarter, quarter, half, half, NULL);
+		Dictionary *frozen = $(dict, frozenCopy);
+
+		ck_assert_ptr_eq(&_Dictionary, classof(frozen));
+		ck_assert_ptr_eq(quarter, $(frozen, objectForKey, quarter));
+		ck_assert_ptr_eq(half, $(frozen, objectForKey, half));
+
+		release(frozen);
+		release(dict);
+		release(quarter);
+		release(half);
+
+	}END_TEST
+
+int main(int argc, char **argv) {
+
+	TCase *tcase = tcase_create("frozenDictionary");
+	tcase_add_test(tcase, frozenDictionary);
+	tcase_add_test(tcase, empty);
+	tcase_add_test(tcase, collision);
+
+	Suite *suite = suite_create("frozenDictionary");
+	suite_add_tcase(suite, tcase);
+
+	SRunner *runner = srunner_create(suite);
+
+	srunner_run_all(runner, CK_VERBOSE);
+	int failed = srunner_ntests_failed(runner);
+
+	srunner_free(runner);
+
+	return failed;
+}
@@ -0,0 +1,139 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <check.h>
+#include <string.h>
+
+#include <Objectively.h>
+
+START_TEST(hash)
+	{
+		const char *chars = "hello world, hello world";
+
+		const RANGE hello = { 0, 5 };
+		const RANGE world = { 6, 5 };
+		const RANGE helloAgain = { 13, 5 };
+		const RANGE worldAgain = { 19, 5 };
+
+		ck_assert_int_eq(HashForCharacters(HASH_SEED, chars, hello), HashForCharacters(HASH_SEED, chars, helloAgain));
+		ck_assert_int_eq(HashForCharacters(HASH_SEED, chars, world), HashForCharacters(HASH_SEED, chars, worldAgain));
+		ck_assert(HashForCharacters(HASH_SEED, chars, hello) != HashForCharacters(HASH_SEED, chars, world));
+
+		ck_assert(HashForCharacters64(HASH_SEED, chars, hello) == HashForCharacters64(HASH_SEED, chars, helloAgain));
+		ck_assert(HashForCharacters64(HASH_SEED, chars, world) == HashForCharacters64(HASH_SEED, chars, worldAgain));
+		ck_assert(HashForCharacters64(HASH_SEED, chars, hello) != HashForCharacters64(HASH_SEED, chars, world));
+
+		byte bytes[256];
+		for (size_t i = 0; i < sizeof(bytes); i++) {
+			bytes[i] = (byte) i;
+		}
+
+		for (int length = 0; length < 128; length++) {
+			const RANGE range = { 0, length };
+			const RANGE offset = { 64, length };
+
+			const uint64_t hash = HashForBytes64(HASH_SEED, bytes, range);
+
+			ck_assert(hash == HashForBytes64(HASH_SEED, bytes, range));
+			ck_assert(hash != HashForBytes64(HASH_SEED + 1, bytes, range));
+
+			if (length) {
+				const RANGE shorter = { 0, length - 1 };
+
+				ck_assert(hash != HashForBytes64(HASH_SEED, bytes, offset));
+				ck_assert(hash != HashForBytes64(HASH_SEED, bytes, shorter));
+			}
+		}
+
+		String *string = $$(String, stringWithCharacters, "hello");
+		MutableString *mutableString = $(alloc(MutableString), initWithString, string);
+
+		ck_assert($((Object *) string, hash64) == $((Object *) mutableString, hash64));
+		ck_assert($((Object *) string, hash64) == HashForCharacters64(HASH_SEED, chars, hello));
+
+		Number *number = $$(Number, numberWithValue, 1.0);
+		Number *other = $$(Number, numberWithValue, 1.0);
+
+		ck_assert($((Object *) number, hash64) == $((Object *) other, hash64));
+
+		release(string);
+		release(mutableString);
+		release(number);
+		release(other);
+
+	}END_TEST
+
+START_TEST(keyed)
+	{
+		byte bytes[15];
+		for (size_t i = 0; i < sizeof(bytes); i++) {
+			bytes[i] = (byte) i;
+		}
+
+		const HashKey key = { 0x0706050403020100ull, 0x0f0e0d0c0b0a0908ull };
+		const RANGE range = { 0, sizeof(bytes) };
+
+		ck_assert(HashForBytesWithKey(&key, bytes, range) == 0xd320d86d2a519956ull);
+
+		const HashKey *processKey = HashKeyForProcess();
+
+		ck_assert(processKey == HashKeyForProcess());
+		ck_assert(HashForBytesWithKey(processKey, bytes, range) != HashForBytesWithKey(&key, bytes, range));
+
+		String *string = $$(String, stringWithCharacters, "hello");
+		MutableString *mutableString = $(alloc(MutableString), initWithString, string);
+
+		ck_assert(HashForObjectWithKey(&key, string) == HashForObjectWithKey(&key, mutableString));
+		ck_assert(HashForObjectWithKey(&key, string) != HashForObjectWithKey(processKey, string));
+		ck_assert(HashForObjectWithKey(NULL, string) == HashForObject64(HASH_SEED, string));
+
+		Number *number = $$(Number, numberWithValue, 1.0);
+		Number *other = $$(Number, numberWithValue, 1.0);
+
+		ck_assert(HashForObjectWithKey(&key, number) == HashForObjectWithKey(&key, other));
+
+		release(string);
+		release(mutableString);
+		release(number);
+		release(other);
+
+	}END_TEST
+
+int main(int argc, char **argv) {
+
+	TCase *tcase = tcase_create("hash");
+	tcase_add_test(tcase, hash);
+	tcase_add_test(tcase, keyed);
+
+	Suite *suite = suite_create("hash");
+	suite_add_tcase(suite, tcase);
+
+	SRunner *runner = srunner_create(suite);
+
+	srunner_run_all(runner, CK_VERBOSE);
+	int failed = srunner_ntests_failed(runner);
+
+	srunner_free(runner);
+
+	return failed;
+}
@@ -35,6 +35,11 @@ START_TEST(json)
 		Dictionary *dict0 = $$(JSONSerialization, objectFromData, data, 0);
 		ck_assert(dict0->count);
 
+		Dictionary *keyed = $$(JSONSerialization, objectFromData, data, JSON_READ_KEYED_HASH);
+		ck_assert_ptr_eq(HashKeyForProcess(), keyed->hashKey);
+		ck_assert($((Object *) dict0, isEqual, (Object *) keyed));
+
+		release(keyed);
 		release(data);
 		data = $$(JSONSerialization, dataFromObject, dict0, 0);
 
@@ -61,14 +61,14 @@ START_TEST(mutableArray)
 		ck_assert_int_eq(1, $((Array *) array, indexOfObject, two));
 		ck_assert_int_eq(2, $((Array *) array, indexOfObject, three));
 
-		ck_assert_int_eq(2, one->referenceCount);
-		ck_assert_int_eq(2, two->referenceCount);
-		ck_assert_int_eq(2, three->referenceCount);
+		ck_assert_int_eq(2, retainCount(one));
+		ck_assert_int_eq(2, retainCount(two));
+		ck_assert_int_eq(2, retainCount(three));
 
 		$(array, removeObject, one);
 
 		ck_assert(!$((Array *) array, containsObject, one));
-		ck_assert_int_eq(1, one->referenceCount);
+		ck_assert_int_eq(1, retainCount(one));
 		ck_assert_int_eq(2, ((Array *) array)->count);
 
 		$(array, removeAllObjects);
@@ -76,10 +76,10 @@ START_TEST(mutableArray)
 		ck_assert_int_eq(0, ((Array *) array)->count);
 
 		ck_assert(!$((Array *) array, containsObject, two));
-		ck_assert_int_eq(1, two->referenceCount);
+		ck_assert_int_eq(1, retainCount(two));
 
 		ck_assert(!$((Array *) array, containsObject, three));
-		ck_assert_int_eq(1, three->referenceCount);
+		ck_assert_int_eq(1, retainCount(three));
 
 		release(one);
 		release(two);
@@ -33,7 +33,7 @@ START_TEST(mutableDictionary)
 		ck_assert_ptr_eq(&_MutableDictionary, classof(dict));
 
 		ck_assert_int_eq(0, ((Dictionary *) dict)->count);
-		ck_assert_int_eq(4, ((Dictionary *) dict)->capacity);
+		ck_assert_int_eq(DICTIONARY_GROUP_SIZE, ((Dictionary *) dict)->capacity);
 
 		Object *objectOne = alloc(Object);
 		Object *objectTwo = alloc(Object);
@@ -53,14 +53,14 @@ START_TEST(mutableDictionary)
 		ck_assert_ptr_eq(objectTwo, $((Dictionary *) dict, objectForKey, keyTwo));
 		ck_assert_ptr_eq(objectThree, $((Dictionary *) dict, objectForKey, keyThree));
 
-		ck_assert_int_eq(2, objectOne->referenceCount);
-		ck_assert_int_eq(2, objectTwo->referenceCount);
-		ck_assert_int_eq(2, objectThree->referenceCount);
+		ck_assert_int_eq(2, retainCount(objectOne));
+		ck_assert_int_eq(2, retainCount(objectTwo));
+		ck_assert_int_eq(2, retainCount(objectThree));
 
 		$(dict, removeObjectForKey, keyOne);
 
 		ck_assert_ptr_eq(NULL, $((Dictionary *) dict, objectForKey, keyOne));
-		ck_assert_int_eq(1, objectOne->referenceCount);
+		ck_assert_int_eq(1, retainCount(objectOne));
 		ck_assert_int_eq(2, ((Dictionary *) dict)->count);
 
 		$(dict, removeAllObjects);
@@ -68,10 +68,10 @@ START_TEST(mutableDictionary)
 		ck_assert_int_eq(0, ((Dictionary *) dict)->count);
 
 		ck_assert_ptr_eq(NULL, $((Dictionary *) dict, objectForKey, keyTwo));
-		ck_assert_int_eq(1, objectTwo->referenceCount);
+		ck_assert_int_eq(1, retainCount(objectTwo));
 
 		ck_assert_ptr_eq(NULL, $((Dictionary *) dict, objectForKey, keyThree));
-		ck_assert_int_eq(1, objectThree->referenceCount);
+		ck_assert_int_eq(1, retainCount(objectThree));
 
 		release(objectOne);
 		release(objectTwo);
@@ -102,10 +102,158 @@ START_TEST(mutableDictionary)
 
 	}END_TEST
 
+START_TEST(churn)
+	{
+		MutableDictionary *dict = $(alloc(MutableDictionary), init);
+
+		ck_assert_int_eq(0, ((Dictionary *) dict)->capacity);
+
+		Number *numbers[1000];
+		for (int i = 0; i < 1000; i++) {
+			numbers[i] = $(alloc(Number), initWithValue, i);
+		}
+
+		for (int round = 0; round < 16; round++) {
+
+			for (int i = 0; i < 1000; i++) {
+				$(dict, setObjectForKey, numbers[i], numbers[i]);
+			}
+
+			ck_assert_int_eq(1000, ((Dictionary *) dict)->count);
+
+			for (int i = 0; i < 1000; i += 2) {
+				$(dict, removeObjectForKey, numbers[i]);
+			}
+
+			ck_assert_int_eq(500, ((Dictionary *) dict)->count);
+
+			for (int i = 0; i < 1000; i++) {
+				const id obj = $((Dictionary *) dict, objectForKey, numbers[i]);
+				ck_assert_ptr_eq(i & 1 ? numbers[i] : NULL, obj);
+			}
+		}
+
+		ck_assert(((Dictionary *) dict)->capacity <= 2048);
+
+		for (int i = 0; i < 1000; i++) {
+			ck_assert_int_eq(i & 1 ? 3 : 1, retainCount(numbers[i]));
+		}
+
+		$(dict, removeAllObjects);
+
+		for (int i = 0; i < 1000; i++) {
+			ck_assert_int_eq(1, retainCount(numbers[i]));
+			release(numbers[i]);
+		}
+
+		release(dict);
+
+	}END_TEST
+
+START_TEST(capacity)
+	{
+		MutableDictionary *dict = $(alloc(MutableDictionary), init);
+
+		$(dict, reserve, 1000);
+
+		const size_t capacity = ((Dictionary *) dict)->capacity;
+		ck_assert(capacity >= 1000);
+
+		Number *numbers[1000];
+		for (int i = 0; i < 1000; i++) {
+			numbers[i] = $(alloc(Number), initWithValue, i);
+			$(dict, setObjectForKey, numbers[i], numbers[i]);
+		}
+
+		ck_assert_int_eq(1000, ((Dictionary *) dict)->count);
+		ck_assert_int_eq(capacity, ((Dictionary *) dict)->capacity);
+
+		for (int i = 10; i < 1000; i++) {
+			$(dict, removeObjectForKey, numbers[i]);
+		}
+
+		$(dict, shrinkToFit);
+
+		ck_assert_int_eq(10, ((Dictionary *) dict)->count);
+		ck_assert_int_eq(DICTIONARY_GROUP_SIZE, ((Dictionary *) dict)->capacity);
+
+		for (int i = 0; i < 1000; i++) {
+			const id obj = $((Dictionary *) dict, objectForKey, numbers[i]);
+			ck_assert_ptr_eq(i < 10 ? numbers[i] : NULL, obj);
+		}
+
+		$(dict, removeAllObjects);
+		$(dict, shrinkToFit);
+
+		ck_assert_int_eq(0, ((Dictionary *) dict)->capacity);
+
+		for (int i = 0; i < 1000; i++) {
+			ck_assert_int_eq(1, retainCount(numbers[i]));
+			release(numbers[i]);
+		}
+
+		release(dict);
+
+	}END_TEST
+
+START_TEST(keyed)
+	{
+		const HashKey *key = HashKeyForProcess();
+
+		MutableDictionary *dict = $(alloc(MutableDictionary), initWithCapacityAndHashKey, 0, key);
+
+		ck_assert_ptr_eq(key, ((Dictionary *) dict)->hashKey);
+
+		String *missing = str("missing");
+
+		ck_assert_ptr_eq(NULL, $((Dictionary *) dict, objectForKey, missing));
+
+		release(missing);
+
+		for (int i = 0; i < 1024; i++) {
+
+			Object *object = $(alloc(Object), init);
+			String *key = $(alloc(String), initWithFormat, "%d", i);
+
+			$(dict, setObjectForKey, object, key);
+
+			release(object);
+			release(key);
+		}
+
+		ck_assert_int_eq(1024, ((Dictionary *) dict)->count);
+		ck_assert_ptr_eq(key, ((Dictionary *) dict)->hashKey);
+
+		Dictionary *copy = (Dictionary *) $((Object *) dict, copy);
+		Dictionary *immutableCopy = $$(Dictionary, dictionaryWithDictionary, (Dictionary *) dict);
+
+		ck_assert_ptr_eq(key, copy->hashKey);
+		ck_assert_ptr_eq(key, immutableCopy->hashKey);
+
+		for (int i = 0; i < 1024; i++) {
+
+			String *key = $(alloc(String), initWithFormat, "%d", i);
+
+			ck_assert($((Dictionary *) dict, objectForKey, key) != NULL);
+			ck_assert($(copy, objectForKey, key) != NULL);
+			ck_assert($(immutableCopy, objectForKey, key) != NULL);
+
+			release(key);
+		}
+
+		release(copy);
+		release(immutableCopy);
+		release(dict);
+
+	}END_TEST
+
 int main(int argc, char **argv) {
 
 	TCase *tcase = tcase_create("mutableDictionary");
 	tcase_add_test(tcase, mutableDictionary);
+	tcase_add_test(tcase, churn);
+	tcase_add_test(tcase, capacity);
+	tcase_add_test(tcase, keyed);
 
 	Suite *suite = suite_create("mutableDictionary");
 	suite_add_tcase(suite, tcase);
@@ -0,0 +1,219 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <check.h>
+
+#include <Objectively.h>
+
+static BOOL enumerator(const Dictionary *dictionary, id obj, id key, id data) {
+
+	$((MutableArray *) data, addObject, key); return NO;
+}
+
+START_TEST(mutableOrderedDictionary)
+	{
+		MutableOrderedDictionary *dict = $$(MutableOrderedDictionary, dictionaryWithCapacity, 4);
+
+		ck_assert(dict != NULL);
+		ck_assert_ptr_eq(&_MutableOrderedDictionary, classof(dict));
+
+		ck_assert_int_eq(0, ((Dictionary *) dict)->count);
+
+		Object *objectOne = alloc(Object);
+		Object *objectTwo = alloc(Object);
+		Object *objectThree = alloc(Object);
+
+		String *keyOne = str("one");
+		String *keyTwo = str("two");
+		String *keyThree = str("three");
+
+		$(dict, setObjectsForKeys, objectOne, keyOne, objectTwo, keyTwo, objectThree, keyThree, NULL);
+
+		ck_assert_int_eq(3, ((Dictionary *) dict)->count);
+
+		ck_assert_ptr_eq(objectOne, $((Dictionary *) dict, objectForKey, keyOne));
+		ck_assert_ptr_eq(objectTwo, $((Dictionary *) dict, objectForKey, keyTwo));
+		ck_assert_ptr_eq(objectThree, $((Dictionary *) dict, objectForKey, keyThree));
+
+		$(dict, removeObjectForKey, keyOne);
+		$(dict, setObjectForKey, objectOne, keyTwo);
+		$(dict, setObjectForKey, objectOne, keyOne);
+
+		ck_assert_int_eq(3, ((Dictionary *) dict)->count);
+		ck_assert_int_eq(1, retainCount(objectTwo));
+		ck_assert_int_eq(3, retainCount(objectOne));
+
+		MutableArray *order = $$(MutableArray, array);
+		$((Dictionary *) dict, enumerateObjectsAndKeys, enumerator, order);
+
+		ck_assert_int_eq(3, ((Array *) order)->count);
+		ck_assert_ptr_eq(keyTwo, $((Array *) order, objectAtIndex, 0));
+		ck_assert_ptr_eq(keyThree, $((Array *) order, objectAtIndex, 1));
+		ck_assert_ptr_eq(keyOne, $((Array *) order, objectAtIndex, 2));
+
+		release(order);
+
+		$(dict, removeAllObjects);
+
+		ck_assert_int_eq(0, ((Dictionary *) dict)->count);
+		ck_assert_ptr_eq(NULL, $((Dictionary *) dict, objectForKey, keyTwo));
+
+		ck_assert_int_eq(1, retainCount(objectOne));
+		ck_assert_int_eq(1, retainCount(objectThree));
+
+		release(objectOne);
+		release(objectTwo);
+		release(objectThree);
+
+		release(keyOne);
+		release(keyTwo);
+		release(keyThree);
+
+		release(dict);
+
+	}END_TEST
+
+START_TEST(churn)
+	{
+		MutableOrderedDictionary *dict = $(alloc(MutableOrderedDictionary), init);
+
+		ck_assert_int_eq(0, ((OrderedDictionary *) dict)->capacity);
+
+		Number *numbers[1000];
+		for (int i = 0; i < 1000; i++) {
+			numbers[i] = $(alloc(Number), initWithValue, i);
+		}
+
+		for (int round = 0; round < 16; round++) {
+
+			for (int i = 0; i < 1000; i++) {
+				$(dict, setObjectForKey, numbers[i], numbers[i]);
+			}
+
+			ck_assert_int_eq(1000, ((Dictionary *) dict)->count);
+
+			for (int i = 0; i < 1000; i += 2) {
+				$(dict, removeObjectForKey, numbers[i]);
+			}
+
+			ck_assert_int_eq(500, ((Dictionary *) dict)->count);
+
+			for (int i = 0; i < 1000; i++) {
+				const id obj = $((Dictionary *) dict, objectForKey, numbers[i]);
+				ck_assert_ptr_eq(i & 1 ? numbers[i] : NULL, obj);
+			}
+		}
+
+		ck_assert(((OrderedDictionary *) dict)->capacity <= 4096);
+
+		MutableArray *order = $$(MutableArray, array);
+		$((Dictionary *) dict, enumerateObjectsAndKeys, enumerator, order);
+
+		ck_assert_int_eq(500, ((Array *) order)->count);
+		for (int i = 0; i < 500; i++) {
+			ck_assert_ptr_eq(numbers[i * 2 + 1], $((Array *) order, objectAtIndex, i));
+		}
+
+		release(order);
+
+		for (int i = 0; i < 1000; i++) {
+			ck_assert_int_eq(i & 1 ? 3 : 1, retainCount(numbers[i]));
+		}
+
+		$(dict, removeAllObjects);
+
+		for (int i = 0; i < 1000; i++) {
+			ck_assert_int_eq(1, retainCount(numbers[i]));
+			release(numbers[i]);
+		}
+
+		release(dict);
+
+	}END_TEST
+
+START_TEST(capacity)
+	{
+		MutableOrderedDictionary *dict = $(alloc(MutableOrderedDictionary), init);
+
+		$(dict, reserve, 1000);
+
+		const size_t capacity = ((OrderedDictionary *) dict)->capacity;
+		ck_assert(capacity >= 1000);
+
+		Number *numbers[1000];
+		for (int i = 0; i < 1000; i++) {
+			numbers[i] = $(alloc(Number), initWithValue, i);
+			$(dict, setObjectForKey, numbers[i], numbers[i]);
+		}
+
+		ck_assert_int_eq(1000, ((Dictionary *) dict)->count);
+		ck_assert_int_eq(capacity, ((OrderedDictionary *) dict)->capacity);
+
+		for (int i = 0; i < 990; i++) {
+			$(dict, removeObjectForKey, numbers[i]);
+		}
+
+		$(dict, shrinkToFit);
+
+		ck_assert_int_eq(10, ((Dictionary *) dict)->count);
+		ck_assert_int_eq(10, ((OrderedDictionary *) dict)->length);
+		ck_assert(((OrderedDictionary *) dict)->capacity < capacity);
+
+		for (int i = 0; i < 1000; i++) {
+			const id obj = $((Dictionary *) dict, objectForKey, numbers[i]);
+			ck_assert_ptr_eq(i < 990 ? NULL : numbers[i], obj);
+		}
+
+		$(dict, removeAllObjects);
+		$(dict, shrinkToFit);
+
+		ck_assert_int_eq(0, ((OrderedDictionary *) dict)->capacity);
+
+		for (int i = 0; i < 1000; i++) {
+			ck_assert_int_eq(1, retainCount(numbers[i]));
+			release(numbers[i]);
+		}
+
+		release(dict);
+
+	}END_TEST
+
+int main(int argc, char **argv) {
+
+	TCase *tcase = tcase_create("mutableOrderedDictionary");
+	tcase_add_test(tcase, mutableOrderedDictionary);
+	tcase_add_test(tcase, churn);
+	tcase_add_test(tcase, capacity);
+
+	Suite *suite = suite_create("mutableOrderedDictionary");
+	suite_add_tcase(suite, tcase);
+
+	SRunner *runner = srunner_create(suite);
+
+	srunner_run_all(runner, CK_VERBOSE);
+	int failed = srunner_ntests_failed(runner);
+
+	srunner_free(runner);
+
+	return failed;
+}
@@ -52,14 +52,14 @@ START_TEST(mutableSet)
 		ck_assert($((Set *) set, containsObject, two));
 		ck_assert($((Set *) set, containsObject, three));
 
-		ck_assert_int_eq(2, one->referenceCount);
-		ck_assert_int_eq(2, two->referenceCount);
-		ck_assert_int_eq(2, three->referenceCount);
+		ck_assert_int_eq(2, retainCount(one));
+		ck_assert_int_eq(2, retainCount(two));
+		ck_assert_int_eq(2, retainCount(three));
 
 		$(set, removeObject, one);
 
 		ck_assert(!$((Set *) set, containsObject, one));
-		ck_assert_int_eq(1, one->referenceCount);
+		ck_assert_int_eq(1, retainCount(one));
 		ck_assert_int_eq(2, ((Set *) set)->count);
 
 		$(set, removeAllObjects);
@@ -67,10 +67,10 @@ START_TEST(mutableSet)
 		ck_assert_int_eq(0, ((Set *) set)->count);
 
 		ck_assert(!$((Set *) set, containsObject, two));
-		ck_assert_int_eq(1, two->referenceCount);
+		ck_assert_int_eq(1, retainCount(two));
 
 		ck_assert(!$((Set *) set, containsObject, three));
-		ck_assert_int_eq(1, three->referenceCount);
+		ck_assert_int_eq(1, retainCount(three));
 
 		release(one);
 		release(two);
@@ -102,10 +102,117 @@ START_TEST(mutableSet)
 
 	}END_TEST
 
+START_TEST(capacity)
+	{
+		MutableSet *set = $(alloc(MutableSet), init);
+
+		$(set, reserve, 1000);
+
+		const size_t capacity = ((Set *) set)->capacity;
+		ck_assert(capacity >= 1000);
+
+		Number *numbers[1000];
+		for (int i = 0; i < 1000; i++) {
+			numbers[i] = $(alloc(Number), initWithValue, i);
+			$(set, addObject, numbers[i]);
+		}
+
+		ck_assert_int_eq(1000, ((Set *) set)->count);
+		ck_assert_int_eq(capacity, ((Set *) set)->capacity);
+
+		for (int i = 10; i < 1000; i++) {
+			$(set, removeObject, numbers[i]);
+		}
+
+		$(set, shrinkToFit);
+
+		ck_assert_int_eq(10, ((Set *) set)->count);
+		ck_assert_int_eq(SET_GROUP_SIZE, ((Set *) set)->capacity);
+
+		for (int i = 0; i < 1000; i++) {
+			ck_assert($((Set *) set, containsObject, numbers[i]) == (i < 10));
+		}
+
+		$(set, removeAllObjects);
+		$(set, shrinkToFit);
+
+		ck_assert_int_eq(0, ((Set *) set)->capacity);
+
+		for (int i = 0; i < 1000; i++) {
+			ck_assert_int_eq(1, retainCount(numbers[i]));
+			release(numbers[i]);
+		}
+
+		release(set);
+
+	}END_TEST
+
+START_TEST(algebra)
+	{
+		MutableSet *set = $$(MutableSet, set);
+		MutableSet *other = $$(MutableSet, set);
+
+		Object *numbers[200];
+		for (int i = 0; i < 200; i++) {
+			numbers[i] = $(alloc(Object), init);
+			if (i < 100) {
+				$(set, addObject, numbers[i]);
+			}
+			if (i >= 50) {
+				$(other, addObject, numbers[i]);
+			}
+		}
+
+		$(set, intersectSet, (Set *) other);
+
+		ck_assert_int_eq(50, ((Set *) set)->count);
+		ck_assert_int_eq(1, retainCount(numbers[0]));
+		ck_assert_int_eq(3, retainCount(numbers[50]));
+
+		$(set, unionSet, (Set *) other);
+
+		ck_assert_int_eq(150, ((Set *) set)->count);
+		ck_assert($((Object *) set, isEqual, (Object *) other));
+		ck_assert_int_eq(3, retainCount(numbers[199]));
+
+		$(other, removeAllObjects);
+		for (int i = 0; i < 10; i++) {
+			$(other, addObject, numbers[i * 20]);
+		}
+
+		$(set, minusSet, (Set *) other);
+
+		ck_assert_int_eq(143, ((Set *) set)->count);
+		ck_assert(!$((Set *) set, containsObject, numbers[60]));
+		ck_assert_int_eq(2, retainCount(numbers[60]));
+
+		$(other, addObject, numbers[101]);
+		$(other, minusSet, (Set *) set);
+
+		ck_assert_int_eq(10, ((Set *) other)->count);
+		ck_assert(!$((Set *) other, containsObject, numbers[101]));
+
+		$(set, minusSet, (Set *) set);
+
+		ck_assert_int_eq(0, ((Set *) set)->count);
+		ck_assert_int_eq(1, retainCount(numbers[199]));
+
+		release(set);
+		release(other);
+
+		for (int i = 0; i < 200; i++) {
+			ck_assert_int_eq(1, retainCount(numbers[i]));
+			release(numbers[i]);
+		}
+
+	}END_TEST
+
 int main(int argc, char **argv) {
 
 	TCase *tcase = tcase_create("mutableSet");
 	tcase_add_test(tcase, mutableSet);
+	tcase_add_test(tcase, capacity);
+	tcase_add_test(tcase, algebra);
 
 	Suite *suite = suite_create("mutableSet");
 	suite_add_tcase(suite, tcase);
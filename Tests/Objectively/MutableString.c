@@ -50,6 +50,12 @@ START_TEST(string)
 		ck_assert(classof(copy) == &_MutableString);
 		ck_assert($((Object *) string, isEqual, (Object *) copy));
 
+		const uint64_t hash = $((Object *) string, hash64);
+
+		$(string, appendString, hello);
+		ck_assert(hash != $((Object *) string, hash64));
+		ck_assert(string->string.hash == 0);
+
 		release(hello);
 		release(goodbye);
 		release(string);
@@ -35,6 +35,12 @@ START_TEST(date)
 
 		ck_assert($((Object *) null1, isEqual, (Object *) null2));
 
+		retain(null1);
+		release(null1);
+		release(null1);
+
+		ck_assert_int_eq(REFERENCE_COUNT_IMMORTAL, retainCount(null1));
+
 	}END_TEST
 
 int main(int argc, char **argv) {
@@ -22,6 +22,7 @@
  */
 
 #include <check.h>
+#include <pthread.h>
 
 #include <Objectively.h>
 
@@ -34,6 +35,20 @@ START_TEST(object)
 
 		ck_assert($(object, isEqual, object));
 		ck_assert($(object, isKindOfClass, classof(object)));
+		ck_assert(!$(object, isKindOfClass, &_String));
+
+		String *string = $$(String, stringWithCharacters, "kind");
+
+		ck_assert($((Object *) string, isKindOfClass, &_Object));
+		ck_assert($((Object *) string, isKindOfClass, &_String));
+		ck_assert(!$((Object *) string, isKindOfClass, &_MutableString));
+
+		_initialize(&_MutableString);
+
+		ck_assert(_isSubclassOfClass(&_MutableString, &_String));
+		ck_assert(!_isSubclassOfClass(&_String, &_MutableString));
+
+		release(string);
 
 		Object *copy = $(object, copy);
 
@@ -45,12 +60,125 @@ START_TEST(object)
 		release(copy);
 		release(object);
 
+		if (_mallocInstances == NO) {
+			Object *recycled = $(alloc(Object), init);
+
+			ck_assert_ptr_eq(object, recycled);
+			ck_assert_int_eq(1, retainCount(recycled));
+
+			release(recycled);
+		}
+
+	}END_TEST
+
+static void *releaseObject(void *data) {
+
+	release(data);
+
+	return NULL;
+}
+
+START_TEST(referenceCount)
+	{
+		Object *object = $(alloc(Object), init);
+
+		retain(object);
+		ck_assert_int_eq(2, retainCount(object));
+
+		pthread_t thread;
+		pthread_create(&thread, NULL, releaseObject, object);
+		pthread_join(thread, NULL);
+
+		ck_assert_int_eq(1, retainCount(object));
+
+		retain(object);
+		release(object);
+		release(object);
+
+		if (_mallocInstances == NO) {
+			Object *recycled = $(alloc(Object), init);
+
+			ck_assert_ptr_eq(object, recycled);
+			ck_assert_int_eq(1, retainCount(recycled));
+
+			release(recycled);
+		}
+
+	}END_TEST
+
+static void *releaseObjects(void *data) {
+
+	Object **objects = data;
+
+	for (int i = 0; i < 32; i++) {
+		release(objects[i]);
+	}
+
+	return NULL;
+}
+
+START_TEST(owner)
+	{
+		const size_t instances = statisticsForClass(&_Object).instances;
+
+		Object *objects[32];
+		for (int i = 0; i < 32; i++) {
+			objects[i] = $(alloc(Object), init);
+		}
+
+		ck_assert_int_eq(instances + 32, statisticsForClass(&_Object).instances);
+
+		pthread_t thread;
+		pthread_create(&thread, NULL, releaseObjects, objects);
+		pthread_join(thread, NULL);
+
+		Object *object = $(alloc(Object), init);
+
+		ck_assert_int_eq(instances + 1, statisticsForClass(&_Object).instances);
+
+		release(object);
+
+	}END_TEST
+
+static void *allocObjects(void *data) {
+
+	Object **objects = data;
+
+	for (int i = 0; i < 32; i++) {
+		objects[i] = $(alloc(Object), init);
+	}
+
+	return NULL;
+}
+
+START_TEST(finishedOwner)
+	{
+		const size_t instances = statisticsForClass(&_Object).instances;
+
+		Object *objects[32];
+
+		pthread_t thread;
+		pthread_create(&thread, NULL, allocObjects, objects);
+		pthread_join(thread, NULL);
+
+		ck_assert_int_eq(instances + 32, statisticsForClass(&_Object).instances);
+
+		for (int i = 0; i < 32; i++) {
+			ck_assert_int_eq(1, retainCount(objects[i]));
+			release(objects[i]);
+		}
+
+		ck_assert_int_eq(instances, statisticsForClass(&_Object).instances);
+
 	}END_TEST
 
 int main(int argc, char **argv) {
 
 	TCase *tcase = tcase_create("object");
 	tcase_add_test(tcase, object);
+	tcase_add_test(tcase, referenceCount);
+	tcase_add_test(tcase, owner);
+	tcase_add_test(tcase, finishedOwner);
 
 	Suite *suite = suite_create("object");
 	suite_add_tcase(suite, tcase);
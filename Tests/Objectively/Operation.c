@@ -21,6 +21,8 @@
  * 3. This notice may not be removed or altered from any source distribution.
  */
 
+#include <stdlib.h>
+
 #include <check.h>
 
 #include <Objectively.h>
@@ -92,11 +94,55 @@ START_TEST(suspendResume)
 		release(queue);
 	}END_TEST
 
+static void apply_func(size_t iteration, id data) {
+
+	((int *) data)[iteration]++;
+}
+
+START_TEST(apply)
+	{
+		int iterations[100] = { 0 };
+
+		$$(OperationQueue, apply, 100, apply_func, iterations);
+
+		for (int i = 0; i < 100; i++) {
+			ck_assert_int_eq(1, iterations[i]);
+		}
+
+		$$(OperationQueue, apply, 0, apply_func, iterations);
+
+	}END_TEST
+
+START_TEST(applyWithArena)
+	{
+		int iterations[100] = { 0 };
+
+		Arena *arena = $(alloc(Arena), init);
+		ck_assert(arena != NULL);
+
+		WithArena(arena, {
+			$$(OperationQueue, apply, 100, apply_func, iterations);
+		});
+
+		release(arena);
+
+		$$(OperationQueue, apply, 100, apply_func, iterations);
+
+		for (int i = 0; i < 100; i++) {
+			ck_assert_int_eq(2, iterations[i]);
+		}
+
+	}END_TEST
+
 int main(int argc, char **argv) {
 
+	setenv("OBJECTIVELY_CONCURRENCY", "4", 0);
+
 	TCase *tcase = tcase_create("operation");
+	tcase_add_test(tcase, applyWithArena);
 	tcase_add_test(tcase, producerConsumer);
 	tcase_add_test(tcase, suspendResume);
+	tcase_add_test(tcase, apply);
 
 	Suite *suite = suite_create("operation");
 	suite_add_tcase(suite, tcase);
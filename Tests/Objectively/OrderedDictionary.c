@@ -0,0 +1,208 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <check.h>
+
+#include <Objectively.h>
+
+static BOOL enumerator(const Dictionary *dictionary, id obj, id key, id data) {
+
+	$((MutableArray *) data, addObject, key); return NO;
+}
+
+static BOOL filter(const Dictionary *dictionary, id obj, id key, id data) {
+
+	return strcmp("two", ((String *) key)->chars) != 0;
+}
+
+START_TEST(orderedDictionary)
+	{
+		String *keys[] = { str("one"), str("two"), str("three"), str("four") };
+		Object *objects[] = { alloc(Object), alloc(Object), alloc(Object), alloc(Object) };
+
+		OrderedDictionary *dict = $$(OrderedDictionary, dictionaryWithObjectsAndKeys,
+				objects[0], keys[0], objects[1], keys[1], objects[2], keys[2], objects[3], keys[3], NULL);
+
+		ck_assert(dict != NULL);
+		ck_assert_ptr_eq(&_OrderedDictionary, classof(dict));
+
+		ck_assert_int_eq(4, ((Dictionary *) dict)->count);
+
+		for (int i = 0; i < 4; i++) {
+			ck_assert_ptr_eq(objects[i], $((Dictionary *) dict, objectForKey, keys[i]));
+			ck_assert_int_eq(2, retainCount(objects[i]));
+		}
+
+		ck_assert_ptr_eq(objects[2], $((Dictionary *) dict, objectForCharacters, "three"));
+
+		int i = 0;
+		foreachKeyAndObject(String *key, Object *obj, (Dictionary *) dict) {
+			ck_assert_ptr_eq(keys[i], key);
+			ck_assert_ptr_eq(objects[i], obj);
+			i++;
+		}
+
+		ck_assert_int_eq(4, i);
+		ck_assert_ptr_eq(NULL, $((Dictionary *) dict, objectForCharacters, "five"));
+
+		MutableArray *order = $$(MutableArray, array);
+		$((Dictionary *) dict, enumerateObjectsAndKeys, enumerator, order);
+
+		ck_assert_int_eq(4, ((Array *) order)->count);
+		for (int i = 0; i < 4; i++) {
+			ck_assert_ptr_eq(keys[i], $((Array *) order, objectAtIndex, i));
+		}
+
+		release(order);
+
+		Dictionary *filtered = $((Dictionary *) dict, filterObjectsAndKeys, filter, NULL);
+
+		ck_assert_ptr_eq(&_MutableOrderedDictionary, classof(filtered));
+		ck_assert_int_eq(3, filtered->count);
+
+		order = $$(MutableArray, array);
+		$(filtered, enumerateObjectsAndKeys, enumerator, order);
+
+		ck_assert_ptr_eq(keys[0], $((Array *) order, objectAtIndex, 0));
+		ck_assert_ptr_eq(keys[2], $((Array *) order, objectAtIndex, 1));
+		ck_assert_ptr_eq(keys[3], $((Array *) order, objectAtIndex, 2));
+
+		release(order);
+		release(filtered);
+
+		Dictionary *unordered = $$(Dictionary, dictionaryWithDictionary, (Dictionary *) dict);
+
+		ck_assert($((Object *) dict, isEqual, (Object *) unordered));
+		ck_assert($((Object *) unordered, isEqual, (Object *) dict));
+		ck_assert_int_eq($((Object *) dict, hash), $((Object *) unordered, hash));
+
+		release(unordered);
+
+		OrderedDictionary *copy = (OrderedDictionary *) $((Object *) dict, copy);
+
+		ck_assert_ptr_eq(&_OrderedDictionary, classof(copy));
+		ck_assert($((Object *) dict, isEqual, (Object *) copy));
+
+		order = $$(MutableArray, array);
+		$((Dictionary *) copy, enumerateObjectsAndKeys, enumerator, order);
+
+		for (int i = 0; i < 4; i++) {
+			ck_assert_ptr_eq(keys[i], $((Array *) order, objectAtIndex, i));
+		}
+
+		release(order);
+		release(copy);
+
+		MutableOrderedDictionary *mutableCopy = $(dict, mutableCopy);
+
+		ck_assert_ptr_eq(&_MutableOrderedDictionary, classof(mutableCopy));
+		ck_assert($((Object *) dict, isEqual, (Object *) mutableCopy));
+
+		release(mutableCopy);
+		release(dict);
+
+		for (int i = 0; i < 4; i++) {
+			ck_assert_int_eq(1, retainCount(objects[i]));
+			release(objects[i]);
+			release(keys[i]);
+		}
+
+	}END_TEST
+
+static BOOL isEven(const Dictionary *dictionary, id obj, id key, id data) {
+
+	return ((int) ((Number *) obj)->value) % 2 == 0;
+}
+
+START_TEST(concurrency)
+	{
+		MutableOrderedDictionary *dict = $$(MutableOrderedDictionary, dictionary);
+
+		for (int i = 9999; i >= 0; i--) {
+			Number *number = $$(Number, numberWithValue, i);
+			String *key = str("%d", i);
+			$(dict, setObjectForKey, number, key);
+			release(number);
+			release(key);
+		}
+
+		Dictionary *evens = $((Dictionary *) dict, filterObjectsAndKeysConcurrently, isEven, NULL);
+
+		ck_assert_ptr_eq(&_MutableOrderedDictionary, classof(evens));
+		ck_assert_int_eq(5000, evens->count);
+
+		int expected = 9998;
+		foreachKeyAndObject(String *key, Number *number, evens) {
+			ck_assert_int_eq(expected, number->value);
+			ck_assert_int_eq(expected, atoi(key->chars));
+			expected -= 2;
+		}
+
+		ck_assert_int_eq(-2, expected);
+
+		release(evens);
+		release(dict);
+
+	}END_TEST
+
+START_TEST(json)
+	{
+		const char *chars = "{\"zulu\": \"z\", \"alpha\": [\"a\"], \"mike\": null, \"bravo\": {\"yankee\": true, \"charlie\": \"c\"}}";
+
+		Data *data = $$(Data, dataWithBytes, (byte *) chars, strlen(chars));
+
+		Dictionary *dict = $$(JSONSerialization, objectFromData, data, 0);
+
+		ck_assert(dict != NULL);
+		ck_assert_ptr_eq(&_MutableOrderedDictionary, classof(dict));
+
+		Data *json = $$(JSONSerialization, dataFromObject, dict, 0);
+
+		ck_assert_int_eq(data->length, json->length);
+		ck_assert(memcmp(data->bytes, json->bytes, data->length) == 0);
+
+		release(json);
+		release(dict);
+		release(data);
+
+	}END_TEST
+
+int main(int argc, char **argv) {
+
+	TCase *tcase = tcase_create("orderedDictionary");
+	tcase_add_test(tcase, orderedDictionary);
+	tcase_add_test(tcase, json);
+	tcase_add_test(tcase, concurrency);
+
+	Suite *suite = suite_create("orderedDictionary");
+	suite_add_tcase(suite, tcase);
+
+	SRunner *runner = srunner_create(suite);
+
+	srunner_run_all(runner, CK_VERBOSE);
+	int failed = srunner_ntests_failed(runner);
+
+	srunner_free(runner);
+
+	return failed;
+}
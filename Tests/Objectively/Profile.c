@@ -0,0 +1,148 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <check.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <Objectively.h>
+
+/**
+ * @return The count of lines in the profile at `path` ending with `name`.
+ */
+static int countSamples(const char *path, const char *name) {
+
+	FILE *file = fopen(path, "r");
+	ck_assert(file != NULL);
+
+	int count = 0;
+	char line[4096];
+
+	while (fgets(line, sizeof(line), file)) {
+		const char *leaf = strrchr(line, ';');
+		leaf = leaf ? leaf + 1 : line;
+
+		if (strncmp(leaf, name, strlen(name)) == 0 && leaf[strlen(name)] == ' ') {
+			count++;
+		}
+	}
+
+	fclose(file);
+
+	return count;
+}
+
+START_TEST(profile)
+	{
+		char path[] = "/tmp/ObjectivelyProfileXXXXXX";
+		const int fd = mkstemp(path);
+		ck_assert(fd != -1);
+		close(fd);
+
+		_initialize(&_Lock);
+
+		_profileInterval = 1;
+
+		Lock *locks[3];
+		for (int i = 0; i < 3; i++) {
+			locks[i] = $(alloc(Lock), init);
+		}
+
+		_profileInterval = 0;
+
+		ck_assert(ProfileWrite(path));
+		ck_assert_int_eq(3, countSamples(path, "Lock"));
+
+		for (int i = 0; i < 3; i++) {
+			release(locks[i]);
+		}
+
+		ck_assert(ProfileWrite(path));
+		ck_assert_int_eq(0, countSamples(path, "Lock"));
+
+		unlink(path);
+
+	}END_TEST
+
+static void *allocLocks(void *data) {
+
+	Lock **locks = data;
+
+	for (int i = 0; i < 3; i++) {
+		locks[i] = $(alloc(Lock), init);
+	}
+
+	return NULL;
+}
+
+START_TEST(firstAllocation)
+	{
+		char path[] = "/tmp/ObjectivelyProfileXXXXXX";
+		const int fd = mkstemp(path);
+		ck_assert(fd != -1);
+		close(fd);
+
+		_initialize(&_Lock);
+
+		_profileInterval = 1 << 30;
+
+		Lock *locks[3];
+
+		pthread_t thread;
+		pthread_create(&thread, NULL, allocLocks, locks);
+		pthread_join(thread, NULL);
+
+		_profileInterval = 0;
+
+		ck_assert(ProfileWrite(path));
+		ck_assert_int_eq(0, countSamples(path, "Lock"));
+
+		for (int i = 0; i < 3; i++) {
+			release(locks[i]);
+		}
+
+		unlink(path);
+
+	}END_TEST
+
+int main(int argc, char **argv) {
+
+	TCase *tcase = tcase_create("profile");
+	tcase_add_test(tcase, profile);
+	tcase_add_test(tcase, firstAllocation);
+
+	Suite *suite = suite_create("profile");
+	suite_add_tcase(suite, tcase);
+
+	SRunner *runner = srunner_create(suite);
+
+	srunner_run_all(runner, CK_VERBOSE);
+	int failed = srunner_ntests_failed(runner);
+
+	srunner_free(runner);
+
+	return failed;
+}
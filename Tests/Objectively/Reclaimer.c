@@ -0,0 +1,97 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <check.h>
+#include <pthread.h>
+
+#include <Objectively.h>
+
+static void *allocArray(void *data) {
+
+	MutableArray *array = $$(MutableArray, array);
+
+	for (int i = 0; i < 1000; i++) {
+		Lock *lock = $(alloc(Lock), init);
+		$(array, addObject, lock);
+		release(lock);
+	}
+
+	*(MutableArray **) data = array;
+
+	return NULL;
+}
+
+START_TEST(reclaimer)
+	{
+		_initialize(&_Lock);
+
+		_reclaimThreshold = 100;
+
+		const size_t before = statisticsForClass(&_Lock).instances;
+
+		MutableArray *array;
+
+		pthread_t thread;
+		pthread_create(&thread, NULL, allocArray, &array);
+		pthread_join(thread, NULL);
+
+		ck_assert_int_eq(before + 1000, statisticsForClass(&_Lock).instances);
+
+		release(array);
+
+		ReclaimerWait();
+
+		const ReclaimerStatistics statistics = ReclaimerGetStatistics();
+
+		ck_assert_int_eq(1, statistics.queued);
+		ck_assert_int_eq(1, statistics.reclaimed);
+		ck_assert_int_eq(0, statistics.depth);
+
+		ck_assert_int_eq(before, statisticsForClass(&_Lock).instances);
+
+		MutableArray *small = $$(MutableArray, array);
+		release(small);
+
+		ck_assert_int_eq(1, ReclaimerGetStatistics().queued);
+
+		_reclaimThreshold = 0;
+
+	}END_TEST
+
+int main(int argc, char **argv) {
+
+	TCase *tcase = tcase_create("reclaimer");
+	tcase_add_test(tcase, reclaimer);
+
+	Suite *suite = suite_create("reclaimer");
+	suite_add_tcase(suite, tcase);
+
+	SRunner *runner = srunner_create(suite);
+
+	srunner_run_all(runner, CK_VERBOSE);
+	int failed = srunner_ntests_failed(runner);
+
+	srunner_free(runner);
+
+	return failed;
+}
@@ -52,9 +52,9 @@ START_TEST(set)
 		ck_assert($(set, containsObject, two));
 		ck_assert($(set, containsObject, three));
 
-		ck_assert_int_eq(2, one->referenceCount);
-		ck_assert_int_eq(2, two->referenceCount);
-		ck_assert_int_eq(2, three->referenceCount);
+		ck_assert_int_eq(2, retainCount(one));
+		ck_assert_int_eq(2, retainCount(two));
+		ck_assert_int_eq(2, retainCount(three));
 
 		release(one);
 		release(two);
@@ -75,10 +75,218 @@ START_TEST(set)
 
 	}END_TEST
 
+START_TEST(containsCharacters)
+	{
+		Object *obj = alloc(Object);
+		String *one = str("one");
+		MutableString *two = $$(MutableString, string);
+		$(two, appendCharacters, "two");
+
+		Set *set = $$(Set, setWithObjects, obj, one, two, NULL);
+
+		ck_assert($(set, containsCharacters, "one"));
+		ck_assert($(set, containsCharacters, "two"));
+		ck_assert($(set, containsCharacters, "three") == NO);
+
+		ck_assert($(set, containsBytes, (const byte *) "onerous", 3));
+		ck_assert($(set, containsBytes, (const byte *) "onerous", 2) == NO);
+
+		release(set);
+		release(two);
+		release(one);
+		release(obj);
+
+	}END_TEST
+
+START_TEST(fastEnumeration)
+	{
+		MutableSet *set = $$(MutableSet, set);
+
+		for (int i = 0; i < 1000; i++) {
+			Number *number = $$(Number, numberWithValue, i);
+			$(set, addObject, number);
+			release(number);
+		}
+
+		int sum = 0;
+		foreach(Number *number, (Set *) set) {
+			sum += number->value;
+		}
+
+		ck_assert_int_eq(499500, sum);
+
+		release(set);
+
+	}END_TEST
+
+START_TEST(equality)
+	{
+		MutableSet *a = $$(MutableSet, set);
+		MutableSet *b = $$(MutableSet, set);
+
+		for (int i = 0; i < 100; i++) {
+			Number *number = $$(Number, numberWithValue, i);
+			$(a, addObject, number);
+			release(number);
+
+			number = $$(Number, numberWithValue, 99 - i);
+			$(b, addObject, number);
+			release(number);
+		}
+
+		ck_assert($((Object *) a, isEqual, (Object *) b));
+
+		Number *number = $$(Number, numberWithValue, 50);
+		$(b, removeObject, number);
+		release(number);
+
+		number = $$(Number, numberWithValue, 100);
+		$(b, addObject, number);
+		release(number);
+
+		ck_assert(!$((Object *) a, isEqual, (Object *) b));
+
+		$(b, removeAllObjects);
+		$(b, addObjectsFromSet, (Set *) a);
+
+		ck_assert($((Object *) a, isEqual, (Object *) b));
+
+		release(a);
+		release(b);
+
+	}END_TEST
+
+static Set *range(int from, int to) {
+
+	MutableSet *set = $$(MutableSet, set);
+
+	for (int i = from; i < to; i++) {
+		Number *number = $$(Number, numberWithValue, i);
+		$(set, addObject, number);
+		release(number);
+	}
+
+	return (Set *) set;
+}
+
+START_TEST(algebra)
+	{
+		Set *a = range(0, 100);
+		Set *b = range(50, 250);
+		Set *c = range(100, 150);
+
+		ck_assert($(a, intersectsSet, b));
+		ck_assert($(b, intersectsSet, a));
+		ck_assert(!$(a, intersectsSet, c));
+
+		ck_assert($(c, isSubsetOfSet, b));
+		ck_assert(!$(b, isSubsetOfSet, c));
+		ck_assert(!$(a, isSubsetOfSet, b));
+		ck_assert($(a, isSubsetOfSet, a));
+
+		Set *expected = range(50, 100);
+		Set *intersection = $(a, setByIntersectingSet, b);
+
+		ck_assert($((Object *) intersection, isEqual, (Object *) expected));
+		release(intersection);
+
+		intersection = $(b, setByIntersectingSet, a);
+
+		ck_assert($((Object *) intersection, isEqual, (Object *) expected));
+		release(intersection);
+		release(expected);
+
+		expected = range(0, 50);
+		Set *difference = $(a, setBySubtractingSet, b);
+
+		ck_assert($((Object *) difference, isEqual, (Object *) expected));
+		release(difference);
+		release(expected);
+
+		difference = $(b, setBySubtractingSet, a);
+
+		expected = range(100, 250);
+		ck_assert($((Object *) difference, isEqual, (Object *) expected));
+		release(expected);
+
+		Set *remainder = $(difference, setBySubtractingSet, c);
+
+		expected = range(150, 250);
+		ck_assert($((Object *) remainder, isEqual, (Object *) expected));
+		release(expected);
+
+		release(remainder);
+		release(difference);
+
+		expected = range(0, 250);
+		Set *combined = $(a, setByUnioningSet, b);
+
+		ck_assert($((Object *) combined, isEqual, (Object *) expected));
+		release(combined);
+
+		combined = $(c, setByUnioningSet, a);
+
+		ck_assert_int_eq(150, combined->count);
+		ck_assert($(a, isSubsetOfSet, combined));
+		ck_assert($(c, isSubsetOfSet, combined));
+		release(combined);
+		release(expected);
+
+		release(a);
+		release(b);
+		release(c);
+
+	}END_TEST
+
+BOOL sumConcurrently(const Set *set, id obj, id data) {
+
+	__atomic_fetch_add((int *) data, ((Number *) obj)->value, __ATOMIC_RELAXED); return NO;
+}
+
+BOOL isEven(const Set *set, id obj, id data) {
+
+	return ((int) ((Number *) obj)->value) % 2 == 0;
+}
+
+START_TEST(concurrency)
+	{
+		MutableSet *set = $$(MutableSet, set);
+
+		for (int i = 0; i < 10000; i++) {
+			Number *number = $$(Number, numberWithValue, i);
+			$(set, addObject, number);
+			release(number);
+		}
+
+		int sum = 0;
+		$((Set *) set, enumerateObjectsConcurrently, sumConcurrently, &sum);
+
+		ck_assert_int_eq(49995000, sum);
+
+		Set *evens = $((Set *) set, filterObjectsConcurrently, isEven, NULL);
+
+		ck_assert_int_eq(5000, evens->count);
+
+		for (int i = 0; i < 10000; i++) {
+			Number *number = $$(Number, numberWithValue, i);
+			ck_assert_int_eq(i % 2 == 0, $(evens, containsObject, number));
+			release(number);
+		}
+
+		release(evens);
+		release(set);
+
+	}END_TEST
+
 int main(int argc, char **argv) {
 
 	TCase *tcase = tcase_create("set");
 	tcase_add_test(tcase, set);
+	tcase_add_test(tcase, containsCharacters);
+	tcase_add_test(tcase, fastEnumeration);
+	tcase_add_test(tcase, equality);
+	tcase_add_test(tcase, algebra);
+	tcase_add_test(tcase, concurrency);
 
 	Suite *suite = suite_create("set");
 	suite_add_tcase(suite, tcase);
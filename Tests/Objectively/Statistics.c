@@ -0,0 +1,101 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <check.h>
+#include <pthread.h>
+
+#include <Objectively.h>
+
+static void *allocObjects(void *data) {
+
+	Object **objects = data;
+
+	for (int i = 0; i < 10; i++) {
+		objects[i] = (Object *) $(alloc(Lock), init);
+	}
+
+	return NULL;
+}
+
+START_TEST(statistics)
+	{
+		_initialize(&_Lock);
+
+		const ClassStatistics before = statisticsForClass(&_Lock);
+
+		Object *objects[10];
+
+		pthread_t thread;
+		pthread_create(&thread, NULL, allocObjects, objects);
+		pthread_join(thread, NULL);
+
+		ClassStatistics statistics = statisticsForClass(&_Lock);
+
+		ck_assert_int_eq(before.instances + 10, statistics.instances);
+		ck_assert_int_eq(before.allocations + 10, statistics.allocations);
+		ck_assert_int_eq(statistics.instances * sizeof(Lock), statistics.instanceBytes);
+		ck_assert(statistics.highWaterMark >= statistics.instances);
+
+		for (int i = 0; i < 10; i++) {
+			release(objects[i]);
+		}
+
+		statistics = statisticsForClass(&_Lock);
+
+		ck_assert_int_eq(before.instances, statistics.instances);
+		ck_assert_int_eq(before.allocations + 10, statistics.allocations);
+		ck_assert(statistics.highWaterMark >= before.instances + 10);
+
+		Dictionary *snapshot = StatisticsSnapshot();
+
+		String *name = $$(String, stringWithCharacters, "Lock");
+		Dictionary *lock = $(snapshot, objectForKey, name);
+		ck_assert(lock != NULL);
+
+		String *key = $$(String, stringWithCharacters, "allocations");
+		Number *allocations = $(lock, objectForKey, key);
+		ck_assert_int_eq(before.allocations + 10, allocations->value);
+
+		release(key);
+		release(name);
+		release(snapshot);
+
+	}END_TEST
+
+int main(int argc, char **argv) {
+
+	TCase *tcase = tcase_create("statistics");
+	tcase_add_test(tcase, statistics);
+
+	Suite *suite = suite_create("statistics");
+	suite_add_tcase(suite, tcase);
+
+	SRunner *runner = srunner_create(suite);
+
+	srunner_run_all(runner, CK_VERBOSE);
+	int failed = srunner_ntests_failed(runner);
+
+	srunner_free(runner);
+
+	return failed;
+}
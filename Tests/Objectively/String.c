@@ -99,10 +99,37 @@ START_TEST(string)
 
 	}END_TEST
 
+START_TEST(hash)
+	{
+		String *string = str("https://example.com/a/long/path?with=query");
+		String *other = str("https://example.com/a/long/path?with=query");
+		String *different = str("https://example.com/a/long/path?with=other");
+
+		ck_assert(string->hash == 0);
+
+		const uint64_t hash = $((Object *) string, hash64);
+
+		ck_assert(hash != 0);
+		ck_assert(string->hash == hash);
+		ck_assert(hash == $((Object *) string, hash64));
+		ck_assert(hash == $((Object *) other, hash64));
+
+		$((Object *) different, hash64);
+
+		ck_assert($((Object *) string, isEqual, (Object *) other));
+		ck_assert($((Object *) string, isEqual, (Object *) different) == NO);
+
+		release(string);
+		release(other);
+		release(different);
+
+	}END_TEST
+
 int main(int argc, char **argv) {
 
 	TCase *tcase = tcase_create("string");
 	tcase_add_test(tcase, string);
+	tcase_add_test(tcase, hash);
 
 	Suite *suite = suite_create("string");
 	suite_add_tcase(suite, tcase);